@@ -101,21 +101,123 @@ function loadTransactions() {
     const content = fs.readFileSync(TRANSACTIONS_FILE, 'utf-8');
     const lines = content.trim().split('\n').filter(line => line.trim());
     
-    return lines.map(line => {
-        const parts = line.split(CSV_DELIMITER);
-        if (parts.length >= 6) {
-            return {
-                transactionID: parts[0].trim(),
-                type: parts[1].trim(),
-                userID: parts[2].trim(),
-                userName: parts[3].trim(),
-                isbn: parts[4].trim(),
-                bookTitle: parts[5].trim(),
-                timestamp: parts[6] ? parts[6].trim() : new Date().toISOString()
-            };
+    return lines.map(parseTransactionLine).filter(trans => trans !== null);
+}
+
+function parseTransactionLine(line) {
+    const parts = line.split(CSV_DELIMITER);
+    if (parts.length >= 6) {
+        return {
+            transactionID: parts[0].trim(),
+            type: parts[1].trim(),
+            userID: parts[2].trim(),
+            userName: parts[3].trim(),
+            isbn: parts[4].trim(),
+            bookTitle: parts[5].trim(),
+            timestamp: parts[6] ? parts[6].trim() : new Date().toISOString()
+        };
+    }
+    return null;
+}
+
+// Reads up to `limit` transactions accepted by `matches`, without loading
+// the whole file. The cursor is the byte offset of a line start: 'newest'
+// reads backwards from it (default: end of file), 'oldest' reads forwards
+// (default: start). nextCursor resumes after the last row returned and is
+// null once the file is exhausted. Appends never move earlier lines, so
+// cursors stay valid while the file grows.
+function readTransactionPage({ cursor = null, limit, order = 'newest', matches = () => true }) {
+    ensureDataDirectory();
+    if (!fs.existsSync(TRANSACTIONS_FILE)) {
+        return { transactions: [], nextCursor: null };
+    }
+    
+    const fd = fs.openSync(TRANSACTIONS_FILE, 'r');
+    try {
+        const size = fs.fstatSync(fd).size;
+        const position = cursor === null ? (order === 'newest' ? size : 0) : Math.min(cursor, size);
+        return order === 'newest'
+            ? readBackwards(fd, position, limit, matches)
+            : readForwards(fd, position, size, limit, matches);
+    } finally {
+        fs.closeSync(fd);
+    }
+}
+
+const PAGE_READ_BYTES = 64 * 1024;
+
+function readBackwards(fd, end, limit, matches) {
+    const transactions = [];
+    let carry = Buffer.alloc(0);   // Bytes from `end` up to the next line start
+    
+    while (end > 0) {
+        const start = Math.max(0, end - PAGE_READ_BYTES);
+        const block = Buffer.alloc(end - start);
+        fs.readSync(fd, block, 0, block.length, start);
+        const data = Buffer.concat([block, carry]);
+        
+        // Only lines that start inside this block are complete
+        const firstLine = start === 0 ? 0 : data.indexOf(0x0a) + 1;
+        if (firstLine === 0 && start > 0) {
+            carry = data;
+            end = start;
+            continue;
         }
-        return null;
-    }).filter(trans => trans !== null);
+        
+        let lineEnd = data.length;
+        while (lineEnd > firstLine) {
+            const lineStart = lineEnd >= 2 ? data.lastIndexOf(0x0a, lineEnd - 2) + 1 : 0;
+            const trans = parseTransactionLine(data.toString('utf-8', Math.max(lineStart, firstLine), lineEnd).trim());
+            if (trans && matches(trans)) {
+                transactions.push(trans);
+                if (transactions.length === limit) {
+                    const nextCursor = start + Math.max(lineStart, firstLine);
+                    return { transactions, nextCursor: nextCursor > 0 ? nextCursor : null };
+                }
+            }
+            lineEnd = Math.max(lineStart, firstLine);
+        }
+        carry = data.subarray(0, firstLine);
+        end = start;
+    }
+    return { transactions, nextCursor: null };
+}
+
+function readForwards(fd, start, size, limit, matches) {
+    const transactions = [];
+    let carry = Buffer.alloc(0);   // Start of a line cut off by the last read
+    let carryStart = start;
+    
+    while (carryStart + carry.length < size) {
+        const readFrom = carryStart + carry.length;
+        const block = Buffer.alloc(Math.min(PAGE_READ_BYTES, size - readFrom));
+        fs.readSync(fd, block, 0, block.length, readFrom);
+        const data = Buffer.concat([carry, block]);
+        const atEnd = readFrom + block.length === size;
+        
+        let lineStart = 0;
+        while (lineStart < data.length) {
+            let lineEnd = data.indexOf(0x0a, lineStart);
+            if (lineEnd === -1) {
+                if (!atEnd) {
+                    break;  // Finish this line on the next read
+                }
+                lineEnd = data.length;
+            }
+            const trans = parseTransactionLine(data.toString('utf-8', lineStart, lineEnd).trim());
+            lineStart = lineEnd + 1;
+            if (trans && matches(trans)) {
+                transactions.push(trans);
+                if (transactions.length === limit) {
+                    const nextCursor = carryStart + lineStart;
+                    return { transactions, nextCursor: nextCursor < size ? nextCursor : null };
+                }
+            }
+        }
+        carry = data.subarray(Math.min(lineStart, data.length));
+        carryStart += Math.min(lineStart, data.length);
+    }
+    return { transactions, nextCursor: null };
 }
 
 function saveTransactions(transactions) {
@@ -153,6 +255,7 @@ module.exports = {
     saveUsers,
     loadTransactions,
     saveTransactions,
+    readTransactionPage,
     generateUserID,
     generateTransactionID
 };
@@ -1,5 +1,5 @@
 // backend/libraryManager.js
-const { loadBooks, saveBooks, loadUsers, saveUsers, loadTransactions, saveTransactions, generateTransactionID } = require('./dataManager');
+const { loadBooks, saveBooks, loadUsers, saveUsers, loadTransactions, saveTransactions, readTransactionPage, generateTransactionID } = require('./dataManager');
 
 const MAX_BORROW_LIMIT = 5;
 
@@ -302,8 +302,17 @@ function getUserBorrowedBooks(userID) {
 
 // ============ TRANSACTION OPERATIONS ============
 
-function getAllTransactions() {
-    return loadTransactions();
+// One page of the full history; see readTransactionPage for the cursor.
+// type is 'BORROW' or 'RETURN' (anything else: both); user and book match
+// anywhere in the name or title, ignoring case
+function getTransactionPage({ cursor, limit, order, type, user, book }) {
+    const userText = (user || '').toLowerCase();
+    const bookText = (book || '').toLowerCase();
+    const matches = trans =>
+        (type !== 'BORROW' && type !== 'RETURN' || trans.type === type) &&
+        (!userText || trans.userName.toLowerCase().includes(userText)) &&
+        (!bookText || trans.bookTitle.toLowerCase().includes(bookText));
+    return readTransactionPage({ cursor, limit, order, matches });
 }
 
 function getUserTransactions(userID) {
@@ -359,7 +368,7 @@ module.exports = {
     borrowBook,
     returnBook,
     getUserBorrowedBooks,
-    getAllTransactions,
+    getTransactionPage,
     getUserTransactions,
     getBookTransactions,
     getRecentTransactions,
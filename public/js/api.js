@@ -183,8 +183,14 @@ const UsersAPI = {
 // ============ TRANSACTIONS API ============
 
 const TransactionsAPI = {
-    getAll: async () => {
-        return await apiRequest('/transactions');
+    // One page; pass the previous page's nextCursor to continue
+    getPage: async ({ cursor = null, limit = 20, order = 'newest', type = '', user = '', book = '' } = {}) => {
+        const params = new URLSearchParams({ limit, order });
+        if (cursor !== null) params.set('cursor', cursor);
+        if (type) params.set('type', type);
+        if (user) params.set('user', user);
+        if (book) params.set('book', book);
+        return await apiRequest(`/transactions?${params}`);
     },
 
     getByUser: async (userID) => {
@@ -4,10 +4,28 @@ const router = express.Router();
 const library = require('../backend/libraryManager');
 const { authenticateToken, requireAdmin } = require('../middleware/auth');
 
-// Get all transactions (admin only)
+const DEFAULT_PAGE_SIZE = 20;
+const MAX_PAGE_SIZE = 200;
+
+// Page through all transactions (admin only).
+// Query: cursor (from the previous page's nextCursor), limit, order
+// ('newest' or 'oldest'), type ('BORROW'/'RETURN'), user, book
 router.get('/', authenticateToken, requireAdmin, (req, res) => {
-    const transactions = library.getAllTransactions();
-    res.json({ success: true, transactions });
+    const { cursor, limit, order, type, user, book } = req.query;
+    
+    const position = cursor === undefined ? null : parseInt(cursor, 10);
+    if (position !== null && (isNaN(position) || position < 0)) {
+        return res.status(400).json({ success: false, message: 'Invalid cursor' });
+    }
+    const pageSize = Math.min(parseInt(limit, 10) || DEFAULT_PAGE_SIZE, MAX_PAGE_SIZE);
+    
+    const page = library.getTransactionPage({
+        cursor: position,
+        limit: Math.max(pageSize, 1),
+        order: order === 'oldest' ? 'oldest' : 'newest',
+        type, user, book
+    });
+    res.json({ success: true, transactions: page.transactions, nextCursor: page.nextCursor });
 });
 
 // Get user transactions (admin or own user)
@@ -8,17 +8,79 @@ using namespace std;
 // ============ USER LIMITS ============
 const int MAX_BORROW_LIMIT = 5;
 const int MIN_PASSWORD_LENGTH = 6;
+const int LOAN_PERIOD_DAYS = 14;      // Due date = borrow time + this
+const int MAX_HOLDS_PER_USER = 5;
+
+// ============ BOOK LIMITS ============
+const int MAX_ISBN_LENGTH = 23;  // ISBN-13 with hyphens is 17
 
 // ============ ADMIN CREDENTIALS ============
 const string ADMIN_USERNAME = "admin";
 const string ADMIN_PASSWORD = "admin123";
 const string ADMIN_ID = "ADMIN001";
 
+// ============ PASSWORD HASHING ============
+const int SCRYPT_LOG_N = 14;      // scrypt cost: 128 * r * 2^logN bytes (16 MiB) per hash
+const int SCRYPT_R = 8;
+const int SCRYPT_P = 1;
+const unsigned long long SCRYPT_MAX_MEMORY_BYTES = 256ULL * 1024 * 1024;  // Stored hashes asking for more are rejected
+const int SCRYPT_MAX_PR = 64;     // Likewise for p * r
+const int PASSWORD_SALT_BYTES = 16;
+const int PASSWORD_HASH_BYTES = 32;
+const int AUTH_WORKER_THREADS = 4;   // Login verification pool; about the core count
+const int AUTH_MAX_QUEUED = 64;      // Logins waiting beyond this are refused
+
+// ============ SESSIONS ============
+const int SESSION_TOKEN_BYTES = 16;            // 128-bit random, opaque tokens
+const int SESSION_IDLE_TIMEOUT_SECONDS = 1800;
+const int SESSION_STRIPES = 16;                // Lock stripes (power of two)
+const int SESSION_WHEEL_SLOTS = 64;            // SLOTS * TICK must exceed the idle timeout
+const int SESSION_WHEEL_TICK_SECONDS = 60;
+
+// ============ ANALYTICS ============
+const int ANALYTICS_MAX_THREADS = 8;              // Threads a report window splits across
+const int ANALYTICS_ROWS_PER_THREAD = 1 << 18;    // Fewest rows worth a thread
+
+// ============ TRENDING ============
+const int TREND_BUCKET_HOURS = 12;
+const int TREND_BUCKETS = 14;            // Window: the last 6.5-7 days
+const int TREND_SKETCH_DEPTH = 4;        // Count-min rows
+const int TREND_SKETCH_WIDTH = 4096;     // Power of two
+const int TREND_TOP_K = 32;              // Heavy hitters tracked
+const int TREND_HLL_BITS = 12;           // Distinct borrowers, about 1.6% error
+const int TREND_BOOK_HLL_BITS = 8;       // Per trending book, about 6.5% error
+
+// ============ RECOMMENDATIONS ============
+const int RECOMMEND_HISTORY = 10;        // Recent distinct borrows a new borrow pairs with
+const int RECOMMEND_TRACKED = 20;        // Strongest neighbours kept per book
+const int RECOMMEND_NEIGHBOURS = 5;      // Neighbours shown
+const int RECOMMEND_MAX_THREADS = 8;     // Bulk rebuild
+
+// ============ JOURNAL ============
+enum JournalMode {
+    JOURNAL_SYNC,     // One write and fsync per record
+    JOURNAL_GROUP,    // Records arriving during a flush share the next fsync
+    JOURNAL_ASYNC     // Flushed on a timer; a crash loses up to one window
+};
+const JournalMode JOURNAL_MODE = JOURNAL_GROUP;
+const int JOURNAL_GROUP_WINDOW_US = 0;           // A group flush waits this long for company
+const int JOURNAL_ASYNC_WINDOW_US = 10000;       // Async flush interval
+const int JOURNAL_BATCH_BYTES = 256 * 1024;      // A flush starts early once this much waits
+const int JOURNAL_MAX_RECORD_BYTES = 1 << 20;    // Larger ones are corruption on recovery
+
+// ============ SNAPSHOTS ============
+const bool SNAPSHOT_WRITE_CSV = true;   // Off: saves write only the binary snapshot
+
 // ============ FILE PATHS ============
 const string DATA_DIR = "data/";
 const string BOOKS_FILE = DATA_DIR + "books.txt";
 const string USERS_FILE = DATA_DIR + "users.txt";
 const string TRANSACTIONS_FILE = DATA_DIR + "transactions.txt";
+const string STRINGS_FILE = DATA_DIR + "strings.txt";   // Interned names/titles
+const string HOLDS_FILE = DATA_DIR + "holds.txt";
+const string JOURNAL_FILE = DATA_DIR + "journal.log";     // Changes since the snapshot
+const string CHECKPOINT_FILE = DATA_DIR + "checkpoint.txt";   // LSN and generation of the CSV files
+const string SNAPSHOT_FILE = DATA_DIR + "snapshot.bin";       // The data files and their LSN in one
 
 // ============ HASH TABLE CONFIGURATION ============
 const int INITIAL_HASH_TABLE_SIZE = 101;  // Prime number
@@ -31,5 +93,6 @@ const char LIST_DELIMITER = ';';
 // ============ DISPLAY SETTINGS ============
 const int BOOKS_PER_PAGE = 10;
 const int RECENT_TRANSACTIONS_COUNT = 20;
+const int TRANSACTIONS_PER_PAGE = 20;
 
 #endif // CONFIG_H
\ No newline at end of file
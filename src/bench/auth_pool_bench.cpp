@@ -0,0 +1,77 @@
+// bench/auth_pool_bench.cpp
+// Login throughput and latency against the authPool size
+// (AUTH_WORKER_THREADS). Every login is one scrypt verification at the
+// configured cost, all submitted at once as a burst; the queue is deep
+// enough that none is refused. Latency runs from submission to verdict,
+// so it includes time spent queued.
+//
+//     make bench && build/bench/auth_pool_bench [logins]
+//
+// Throughput should climb until threads reach the physical core count
+// and stay flat after that, while KDF memory keeps growing.
+#include "../Config.h"
+#include "../entities/User.h"
+#include "../utils/WorkerPool.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+static double millisSince(Clock::time_point start) {
+    return chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    int logins = (argc > 1) ? atoi(argv[1]) : 64;
+    if (logins <= 0) {
+        cerr << "Usage: auth_pool_bench [logins]" << endl;
+        return 1;
+    }
+    
+    const string password = "correct horse";
+    const string storedHash = User::hashPassword(password);
+    const double kdfMiB = 128.0 * SCRYPT_R * (1 << SCRYPT_LOG_N) / (1024 * 1024);
+    
+    cout << "Hardware threads: " << thread::hardware_concurrency() 
+         << ", logins per run: " << logins << endl;
+    cout << setw(8) << "threads" << setw(12) << "logins/s" << setw(10) << "p50 ms" 
+         << setw(10) << "p99 ms" << setw(14) << "KDF MiB peak" << endl;
+    
+    for (size_t threads : {1, 2, 4, 8, 16}) {
+        vector<double> latencies(logins);
+        vector<char> verified(logins, 0);
+        
+        Clock::time_point start = Clock::now();
+        {
+            WorkerPool pool(threads, logins);
+            for (int i = 0; i < logins; i++) {
+                Clock::time_point submitted = Clock::now();
+                pool.trySubmit([&, i, submitted]() {
+                    verified[i] = User::verifyPassword(storedHash, password);
+                    latencies[i] = millisSince(submitted);
+                });
+            }
+        }   // Drains the queue and joins
+        double elapsedMs = millisSince(start);
+        
+        if (count(verified.begin(), verified.end(), 0) > 0) {
+            cerr << "Error: a correct password was rejected" << endl;
+            return 1;
+        }
+        
+        sort(latencies.begin(), latencies.end());
+        size_t busy = min(threads, static_cast<size_t>(logins));
+        cout << setw(8) << threads 
+             << setw(12) << fixed << setprecision(1) << logins * 1000.0 / elapsedMs
+             << setw(10) << latencies[latencies.size() / 2]
+             << setw(10) << latencies[(latencies.size() * 99) / 100]
+             << setw(14) << setprecision(0) << busy * kdfMiB << endl;
+    }
+    return 0;
+}
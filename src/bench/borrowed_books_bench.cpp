@@ -0,0 +1,120 @@
+// bench/borrowed_books_bench.cpp
+// A patron's loan list as the inline BorrowedBooks set against the
+// set<string> it replaced: bytes per patron with a full list, and the
+// cost of a borrow/return cycle (contains, insert, erase) on a list
+// already holding MAX_BORROW_LIMIT - 1 loans.
+//
+//     make bench && build/bench/borrowed_books_bench [cycles]
+//
+// Heap bytes are what glibc's malloc reports in use (mallinfo2), so they
+// include its chunk headers and rounding.
+#include "../Config.h"
+#include "../entities/User.h"
+#include "../entities/BorrowedBooks.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <set>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+#include <malloc.h>
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+static size_t heapInUse() {
+    return mallinfo2().uordblks;
+}
+
+// Hyphenated ISBN-13s, 17 characters: too long for the inline string buffer
+static string makeISBN(int n) {
+    string digits = to_string(1000000000 + n);
+    return "978-" + digits.substr(0, 1) + "-" + digits.substr(1, 3) + "-" 
+           + digits.substr(4, 5) + "-" + digits.substr(9, 1);
+}
+
+// Runs one borrow/return cycle per ISBN in candidates; returns ns each
+template <typename Loans, typename Has, typename Add, typename Remove>
+static double nanosPerCycle(Loans& loans, const vector<string>& candidates, size_t cycles,
+                            Has has, Add add, Remove remove) {
+    size_t borrowed = 0;
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < cycles; i++) {
+        const string& isbn = candidates[i % candidates.size()];
+        if (!has(loans, isbn) && add(loans, isbn)) {
+            borrowed++;
+            remove(loans, isbn);
+        }
+    }
+    double elapsed = chrono::duration<double, nano>(Clock::now() - start).count();
+    if (borrowed != cycles) {
+        cerr << "Error: " << (cycles - borrowed) << " cycle(s) did not borrow" << endl;
+        exit(1);
+    }
+    return elapsed / cycles;
+}
+
+int main(int argc, char* argv[]) {
+    size_t cycles = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 10000000;
+    if (cycles == 0) {
+        cerr << "Usage: borrowed_books_bench [cycles]" << endl;
+        return 1;
+    }
+    
+    vector<string> held, candidates;
+    for (int i = 0; i < MAX_BORROW_LIMIT - 1; i++) {
+        held.push_back(makeISBN(i));
+    }
+    for (int i = 0; i < 64; i++) {
+        candidates.push_back(makeISBN(1000 + i));
+    }
+    const string last = makeISBN(999);
+    
+    // Memory with a full list: the set's nodes and key copies are on the
+    // heap; BorrowedBooks lives inside User
+    size_t before = heapInUse();
+    set<string> fullTree(held.begin(), held.end());
+    fullTree.insert(last);
+    size_t treeHeap = heapInUse() - before;
+    
+    before = heapInUse();
+    BorrowedBooks fullInline;
+    for (const string& isbn : held) {
+        fullInline.insert(isbn);
+    }
+    fullInline.insert(last);
+    size_t inlineHeap = heapInUse() - before;
+    if (fullTree.size() != size_t(MAX_BORROW_LIMIT) || !fullInline.full()) {
+        cerr << "Error: a list did not fill" << endl;
+        return 1;
+    }
+    
+    set<string> tree(held.begin(), held.end());
+    double treeNs = nanosPerCycle(tree, candidates, cycles,
+        [](const set<string>& s, const string& isbn) { return s.count(isbn) != 0; },
+        [](set<string>& s, const string& isbn) { return s.insert(isbn).second; },
+        [](set<string>& s, const string& isbn) { s.erase(isbn); });
+    
+    BorrowedBooks loans;
+    for (const string& isbn : held) {
+        loans.insert(isbn);
+    }
+    double inlineNs = nanosPerCycle(loans, candidates, cycles,
+        [](const BorrowedBooks& b, const string& isbn) { return b.contains(isbn); },
+        [](BorrowedBooks& b, const string& isbn) { return b.insert(isbn); },
+        [](BorrowedBooks& b, const string& isbn) { b.erase(isbn); });
+    
+    size_t userNow = sizeof(User);
+    size_t userThen = userNow - sizeof(BorrowedBooks) + sizeof(set<string>);
+    
+    cout << "Loans per full list: " << MAX_BORROW_LIMIT << ", cycles: " << cycles << endl;
+    cout << setw(14) << left << "loan list" << right << setw(12) << "sizeof(User)" 
+         << setw(12) << "heap B" << setw(12) << "total B" << setw(12) << "cycle ns" << endl;
+    cout << fixed << setprecision(1);
+    cout << setw(14) << left << "set<string>" << right << setw(12) << userThen 
+         << setw(12) << treeHeap << setw(12) << userThen + treeHeap << setw(12) << treeNs << endl;
+    cout << setw(14) << left << "BorrowedBooks" << right << setw(12) << userNow 
+         << setw(12) << inlineHeap << setw(12) << userNow + inlineHeap << setw(12) << inlineNs << endl;
+    return 0;
+}
@@ -0,0 +1,77 @@
+// bench/hold_queue_bench.cpp
+// HoldQueues with many holds outstanding at once: the cost of placing a
+// hold, looking up a holder's position, and handing each book to its
+// next holder until every queue is empty. Holders are spread five books
+// each (MAX_HOLDS_PER_USER) over 1000 books.
+//
+//     make bench && build/bench/hold_queue_bench [holds]
+//
+// tests/hold_queues_test.cpp checks the queues' behaviour.
+#include "../management/HoldQueues.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+static double nanosSince(Clock::time_point start, size_t operations) {
+    return chrono::duration<double, nano>(Clock::now() - start).count() / operations;
+}
+
+int main(int argc, char* argv[]) {
+    size_t holdCount = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 100000;
+    if (holdCount == 0) {
+        cerr << "Usage: hold_queue_bench [holds]" << endl;
+        return 1;
+    }
+    
+    const size_t bookCount = 1000;
+    vector<string> isbns(bookCount);
+    for (size_t i = 0; i < bookCount; i++) {
+        isbns[i] = "978-0-" + to_string(100000 + i);
+    }
+    // Hold i belongs to user i / 5; the offset keeps a user's five books distinct
+    auto bookOf = [&](size_t i) -> const string& { return isbns[(i * 37 + i / 5) % bookCount]; };
+    
+    HoldQueues holds;
+    Clock::time_point start = Clock::now();
+    size_t placed = 0;
+    for (size_t i = 0; i < holdCount; i++) {
+        placed += holds.place(i / 5 + 1, bookOf(i), int64_t(i));
+    }
+    double placeNs = nanosSince(start, holdCount);
+    
+    start = Clock::now();
+    size_t positions = 0;
+    for (size_t i = 0; i < holdCount; i++) {
+        positions += (holds.getPosition(i / 5 + 1, bookOf(i)) != 0);
+    }
+    double positionNs = nanosSince(start, holdCount);
+    
+    start = Clock::now();
+    size_t taken = 0;
+    for (const string& isbn : isbns) {
+        while (holds.takeNext(isbn, [](uint64_t) { return true; }) != 0) {
+            taken++;
+        }
+    }
+    double handOffNs = nanosSince(start, holdCount);
+    
+    if (placed != holdCount || positions != holdCount || taken != holdCount || holds.size() != 0) {
+        cerr << "Error: placed " << placed << ", found " << positions << ", handed off " 
+             << taken << " of " << holdCount << " holds" << endl;
+        return 1;
+    }
+    
+    cout << "Holds: " << holdCount << " (" << (holdCount + 4) / 5 << " users, " 
+         << bookCount << " books)" << endl;
+    cout << fixed << setprecision(1);
+    cout << setw(12) << left << "place" << right << setw(10) << placeNs << " ns" << endl;
+    cout << setw(12) << left << "position" << right << setw(10) << positionNs << " ns" << endl;
+    cout << setw(12) << left << "hand-off" << right << setw(10) << handOffNs << " ns" << endl;
+    return 0;
+}
@@ -0,0 +1,135 @@
+// bench/journal_bench.cpp
+// Journal throughput, append latency and records per fsync by durability
+// mode (JOURNAL_MODE in Config.h) and number of writer threads. Each
+// record is BORROW-sized (about 38 bytes). Latency is one append() call:
+// until the record is on disk, or only queued in async mode. After each
+// run the journal is reopened and every record must replay.
+//
+//     make bench && build/bench/journal_bench [records] [file]
+//
+// The file (default journal_bench.log in the current directory) is
+// deleted afterwards; put it on the disk you want to measure.
+#include "../Config.h"
+#include "../utils/Journal.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <cstdio>
+#include <cstdlib>
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+struct Setting {
+    const char* name;
+    JournalMode mode;
+    int windowMicros;
+};
+
+static double percentile(const vector<double>& sorted, double fraction) {
+    return sorted[min(sorted.size() - 1, size_t(fraction * sorted.size()))];
+}
+
+int main(int argc, char* argv[]) {
+    int records = (argc > 1) ? atoi(argv[1]) : 4000;
+    string filename = (argc > 2) ? argv[2] : "journal_bench.log";
+    if (records <= 0) {
+        cerr << "Usage: journal_bench [records] [file]" << endl;
+        return 1;
+    }
+    
+    const Setting settings[] = {
+        {"sync", JOURNAL_SYNC, 0},
+        {"group", JOURNAL_GROUP, 0},
+        {"group", JOURNAL_GROUP, 200},
+        {"async", JOURNAL_ASYNC, JOURNAL_ASYNC_WINDOW_US},
+    };
+    
+    cout << "Hardware threads: " << thread::hardware_concurrency() 
+         << ", records per run: about " << records << endl;
+    cout << setw(6) << left << "mode" << right << setw(8) << "window" << setw(9) << "writers" 
+         << setw(11) << "rec/s" << setw(10) << "p50 us" << setw(10) << "p99 us" 
+         << setw(11) << "p99.9 us" << setw(11) << "rec/fsync" << endl;
+    
+    for (const Setting& setting : settings) {
+        for (int writers : {1, 4, 16, 64}) {
+            int perWriter = max(1, records / writers);
+            remove(filename.c_str());
+            
+            Journal journal(setting.mode, setting.windowMicros, JOURNAL_BATCH_BYTES);
+            size_t applied = 0, skipped = 0, tornBytes = 0;
+            if (!journal.open(filename, 0, [](JournalRecord&) { return true; }, 
+                              applied, skipped, tornBytes)) {
+                cerr << "Error: cannot open " << filename << endl;
+                return 1;
+            }
+            
+            vector<vector<double>> latencies(writers);
+            vector<int> failed(writers, 0);
+            Clock::time_point start = Clock::now();
+            vector<thread> threads;
+            for (int w = 0; w < writers; w++) {
+                threads.emplace_back([&, w]() {
+                    for (int i = 0; i < perWriter; i++) {
+                        JournalRecord record(JournalRecord::BORROW);
+                        record.putUnsigned(1000 + i);
+                        record.putUnsigned(w);
+                        record.putString("978-0-13-468599-1");
+                        record.putSigned(3);
+                        record.putSigned(1760000000000LL + i);
+                        
+                        Clock::time_point submitted = Clock::now();
+                        failed[w] += !journal.append(record);
+                        latencies[w].push_back(
+                            chrono::duration<double, micro>(Clock::now() - submitted).count());
+                    }
+                });
+            }
+            for (thread& writer : threads) {
+                writer.join();
+            }
+            bool flushed = journal.flush();
+            double seconds = chrono::duration<double>(Clock::now() - start).count();
+            JournalStats stats = journal.getStats();
+            journal.close();
+            
+            vector<double> all;
+            for (const vector<double>& own : latencies) {
+                all.insert(all.end(), own.begin(), own.end());
+            }
+            sort(all.begin(), all.end());
+            
+            // Everything appended must come back on replay
+            Journal replay(setting.mode, setting.windowMicros, JOURNAL_BATCH_BYTES);
+            bool reopened = replay.open(filename, 0, [](JournalRecord&) { return true; }, 
+                                        applied, skipped, tornBytes);
+            replay.close();
+            size_t total = size_t(writers) * perWriter;
+            size_t failures = 0;
+            for (int count : failed) {
+                failures += count;
+            }
+            if (!flushed || !reopened || failures != 0 || applied != total || tornBytes != 0) {
+                cerr << "Error: " << setting.name << " with " << writers << " writers: " 
+                     << failures << " failed appends, " << applied << " of " << total 
+                     << " records replayed, " << tornBytes << " torn bytes" << endl;
+                remove(filename.c_str());
+                return 1;
+            }
+            
+            cout << setw(6) << left << setting.name << right << setw(8) 
+                 << (setting.mode == JOURNAL_SYNC ? string("-") : to_string(setting.windowMicros))
+                 << setw(9) << writers << fixed << setprecision(0) 
+                 << setw(11) << total / seconds << setw(10) << percentile(all, 0.5) 
+                 << setw(10) << percentile(all, 0.99) << setw(11) << percentile(all, 0.999)
+                 << setprecision(1) << setw(11) << double(stats.records) / max<uint64_t>(1, stats.syncs) 
+                 << endl;
+        }
+    }
+    remove(filename.c_str());
+    return 0;
+}
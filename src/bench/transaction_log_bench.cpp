@@ -0,0 +1,191 @@
+// bench/transaction_log_bench.cpp
+// The chunked TransactionList against the doubly linked list it replaced
+// (a heap node and a heap Transaction per record, same user and ISBN
+// indexes): append throughput, a full scan, getRecent(50), and heap in
+// use per record, indexes included.
+//
+//     make bench && build/bench/transaction_log_bench [rows]
+//
+// Heap figures are what glibc's malloc reports in use (mallinfo2) and
+// include the ISBN strings, which both forms store per record.
+#include "../entities/Transaction.h"
+#include "../management/TransactionList.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <chrono>
+#include <cstdlib>
+#include <malloc.h>
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+// The pre-chunk log
+class LinkedLog {
+private:
+    struct TransactionNode {
+        Transaction* data;
+        TransactionNode* prev;
+        TransactionNode* next;
+        
+        TransactionNode(Transaction* t) 
+            : data(t), prev(nullptr), next(nullptr) {}
+    };
+    
+    TransactionNode* head;
+    TransactionNode* tail;
+    int count;
+    
+    unordered_map<uint64_t, vector<Transaction*>> userTransIndex;
+    unordered_map<string, vector<Transaction*>> bookTransIndex;
+    
+public:
+    LinkedLog() : head(nullptr), tail(nullptr), count(0) {}
+    
+    ~LinkedLog() {
+        while (head != nullptr) {
+            TransactionNode* next = head->next;
+            delete head->data;
+            delete head;
+            head = next;
+        }
+    }
+    
+    void append(Transaction* trans) {
+        TransactionNode* node = new TransactionNode(trans);
+        if (tail == nullptr) {
+            head = tail = node;
+        } else {
+            tail->next = node;
+            node->prev = tail;
+            tail = node;
+        }
+        count++;
+        userTransIndex[trans->getUserID()].push_back(trans);
+        bookTransIndex[trans->getISBN()].push_back(trans);
+    }
+    
+    vector<Transaction*> getAll() const {
+        vector<Transaction*> result;
+        for (TransactionNode* node = head; node != nullptr; node = node->next) {
+            result.push_back(node->data);
+        }
+        return result;
+    }
+    
+    vector<Transaction*> getRecent(int n) const {
+        vector<Transaction*> result;
+        for (TransactionNode* node = tail; node != nullptr && n > 0; node = node->prev, n--) {
+            result.push_back(node->data);
+        }
+        return result;
+    }
+};
+
+static size_t heapInUse() {
+    return mallinfo2().uordblks;
+}
+
+static double millisSince(Clock::time_point start) {
+    return chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+static Transaction makeRow(size_t i) {
+    string isbn = "978-0-" + to_string(100000 + i % 20000) + "-" + to_string(i % 10);
+    return Transaction::restore(i + 1, 1 + i % 5000, isbn, (i & 1) ? "RETURN" : "BORROW", 
+                                0, 0, 1 + i % 3, 1700000000000LL + int64_t(i) * 1000);
+}
+
+// Sums the IDs so the scan cannot be skipped
+static uint64_t checksum(const vector<Transaction*>& rows) {
+    uint64_t sum = 0;
+    for (Transaction* row : rows) {
+        sum += row->getID();
+    }
+    return sum;
+}
+
+// Microseconds per getRecent(50), checking the newest record comes first
+template <typename Log>
+static double recentMicros(const Log& log, size_t rows) {
+    const int calls = 100000;
+    Clock::time_point start = Clock::now();
+    size_t misses = 0;
+    for (int i = 0; i < calls; i++) {
+        vector<Transaction*> recent = log.getRecent(50);
+        misses += (recent.size() != 50 || recent[0]->getID() != rows);
+    }
+    double elapsed = millisSince(start) * 1000 / calls;
+    if (misses != 0) {
+        cerr << "Error: getRecent returned the wrong records" << endl;
+        exit(1);
+    }
+    return elapsed;
+}
+
+static void printRow(const string& name, size_t rows, double appendMs, double scanMs, 
+                     double recentUs, size_t heap) {
+    cout << setw(10) << left << name << right 
+         << setw(14) << rows / appendMs / 1000 << setw(10) << scanMs 
+         << setw(12) << recentUs << setw(12) << double(heap) / rows << endl;
+}
+
+int main(int argc, char* argv[]) {
+    size_t rows = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 1000000;
+    if (rows < 50) {
+        cerr << "Usage: transaction_log_bench [rows >= 50]" << endl;
+        return 1;
+    }
+    uint64_t expected = uint64_t(rows) * (rows + 1) / 2;
+    
+    cout << "Rows: " << rows << endl;
+    cout << setw(10) << left << "log" << right << setw(14) << "append Mrow/s" 
+         << setw(10) << "scan ms" << setw(12) << "recent us" << setw(12) << "heap B/row" << endl;
+    cout << fixed << setprecision(2);
+    
+    {
+        size_t before = heapInUse();
+        LinkedLog linked;
+        Clock::time_point start = Clock::now();
+        for (size_t i = 0; i < rows; i++) {
+            linked.append(new Transaction(makeRow(i)));
+        }
+        double appendMs = millisSince(start);
+        size_t heap = heapInUse() - before;
+        
+        start = Clock::now();
+        uint64_t sum = checksum(linked.getAll());
+        double scanMs = millisSince(start);
+        if (sum != expected) {
+            cerr << "Error: linked scan checksum mismatch" << endl;
+            return 1;
+        }
+        printRow("linked", rows, appendMs, scanMs, recentMicros(linked, rows), heap);
+    }
+    
+    {
+        size_t before = heapInUse();
+        TransactionList chunked;
+        Clock::time_point start = Clock::now();
+        for (size_t i = 0; i < rows; i++) {
+            chunked.append(makeRow(i));
+        }
+        double appendMs = millisSince(start);
+        size_t heap = heapInUse() - before;
+        
+        start = Clock::now();
+        uint64_t sum = 0;
+        for (size_t seq = 0; seq < chunked.size(); seq++) {
+            sum += chunked.at(seq)->getID();
+        }
+        double scanMs = millisSince(start);
+        if (sum != expected || checksum(chunked.getAll()) != expected) {
+            cerr << "Error: chunked scan checksum mismatch" << endl;
+            return 1;
+        }
+        printRow("chunked", rows, appendMs, scanMs, recentMicros(chunked, rows), heap);
+    }
+    return 0;
+}
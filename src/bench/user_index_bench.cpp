@@ -0,0 +1,182 @@
+// bench/user_index_bench.cpp
+// UserHashMap's flat UserIndex tables against the separate-chaining
+// tables they replaced: index memory per user and lookup cost by ID and
+// by username. The chained table is rebuilt here as it was (a heap node
+// with a copied string key per user per table, DJB2), plus doubling at
+// MAX_LOAD_FACTOR so chains stay short.
+//
+//     make bench && build/bench/user_index_bench [users]
+//
+// Memory counts index structures only (not User records or allocator
+// overhead). The flat figure covers all four of UserHashMap's indexes
+// (ID, username, email, phone) and its packed username copies; the
+// chained one had only the first two tables.
+#include "../Config.h"
+#include "../entities/User.h"
+#include "../management/UserHashMap.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+// The pre-flat table, keyed by string
+class ChainedTable {
+private:
+    struct HashNode {
+        string key;
+        User* value;
+        HashNode* next;
+        HashNode(const string& k, User* v) : key(k), value(v), next(nullptr) {}
+    };
+    
+    vector<HashNode*> buckets;
+    size_t count;
+    
+    size_t hashFunction(const string& key) const {
+        unsigned long hash = 5381;
+        for (char c : key) {
+            hash = ((hash << 5) + hash) + c;  // hash * 33 + c
+        }
+        return hash % buckets.size();
+    }
+    
+    void grow() {
+        vector<HashNode*> old(buckets.size() * 2 + 1, nullptr);
+        old.swap(buckets);
+        for (HashNode* node : old) {
+            while (node != nullptr) {
+                HashNode* next = node->next;
+                size_t index = hashFunction(node->key);
+                node->next = buckets[index];
+                buckets[index] = node;
+                node = next;
+            }
+        }
+    }
+    
+public:
+    ChainedTable() : buckets(INITIAL_HASH_TABLE_SIZE, nullptr), count(0) {}
+    
+    ~ChainedTable() {
+        for (HashNode* node : buckets) {
+            while (node != nullptr) {
+                HashNode* next = node->next;
+                delete node;
+                node = next;
+            }
+        }
+    }
+    
+    void insert(const string& key, User* user) {
+        if (count + 1 > buckets.size() * MAX_LOAD_FACTOR) {
+            grow();
+        }
+        size_t index = hashFunction(key);
+        HashNode* node = new HashNode(key, user);
+        node->next = buckets[index];
+        buckets[index] = node;
+        count++;
+    }
+    
+    User* search(const string& key) const {
+        for (HashNode* node = buckets[hashFunction(key)]; node != nullptr; node = node->next) {
+            if (node->key == key) {
+                return node->value;
+            }
+        }
+        return nullptr;
+    }
+    
+    // Bucket array, nodes, and key text too long for the inline buffer
+    size_t getMemoryUsage() const {
+        size_t bytes = buckets.capacity() * sizeof(HashNode*);
+        for (HashNode* node : buckets) {
+            for (; node != nullptr; node = node->next) {
+                bytes += sizeof(HashNode);
+                if (node->key.capacity() > 15) {
+                    bytes += node->key.capacity() + 1;
+                }
+            }
+        }
+        return bytes;
+    }
+};
+
+template <typename Lookup>
+static double nanosPerLookup(size_t lookups, Lookup lookup) {
+    size_t found = 0;
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < lookups; i++) {
+        found += (lookup(i) != nullptr);
+    }
+    double elapsed = chrono::duration<double, nano>(Clock::now() - start).count();
+    if (found != lookups) {
+        cerr << "Error: " << (lookups - found) << " lookup(s) missed" << endl;
+        exit(1);
+    }
+    return elapsed / lookups;
+}
+
+int main(int argc, char* argv[]) {
+    size_t userCount = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 100000;
+    if (userCount == 0) {
+        cerr << "Usage: user_index_bench [users]" << endl;
+        return 1;
+    }
+    
+    UserHashMap flat;
+    vector<User> records;
+    records.reserve(userCount);
+    for (size_t i = 0; i < userCount; i++) {
+        string name = "patron" + to_string(i * 7919 % 1000003);
+        records.push_back(User::restore(i + 1, name, "hash", "Patron " + to_string(i), 
+                                        name + "@example.com", to_string(5550000000ULL + i), 
+                                        true));
+        flat.insert(records.back());
+    }
+    
+    ChainedTable byID, byUsername;
+    for (User& user : records) {
+        byID.insert(user.getUserID(), &user);
+        byUsername.insert(user.getUsername(), &user);
+    }
+    
+    // The same random key order for both
+    size_t lookups = max<size_t>(userCount * 10, 1000000);
+    mt19937_64 random(7);
+    vector<size_t> order(lookups);
+    for (size_t& index : order) {
+        index = random() % userCount;
+    }
+    vector<string> idText(userCount);
+    for (size_t i = 0; i < userCount; i++) {
+        idText[i] = records[i].getUserID();
+    }
+    
+    double chainedID = nanosPerLookup(lookups, [&](size_t i) { 
+        return byID.search(idText[order[i]]); });
+    double chainedName = nanosPerLookup(lookups, [&](size_t i) { 
+        return byUsername.search(records[order[i]].getUsername()); });
+    double flatID = nanosPerLookup(lookups, [&](size_t i) { 
+        return flat.searchByID(order[i] + 1); });
+    double flatName = nanosPerLookup(lookups, [&](size_t i) { 
+        return flat.searchByUsername(records[order[i]].getUsername()); });
+    
+    cout << "Users: " << userCount << ", lookups per column: " << lookups << endl;
+    cout << setw(10) << left << "table" << right << setw(14) << "index B/user" 
+         << setw(12) << "ID ns" << setw(14) << "username ns" << endl;
+    cout << fixed << setprecision(1);
+    cout << setw(10) << left << "chained" << right
+         << setw(14) << double(byID.getMemoryUsage() + byUsername.getMemoryUsage()) / userCount
+         << setw(12) << chainedID << setw(14) << chainedName << endl;
+    cout << setw(10) << left << "flat" << right
+         << setw(14) << double(flat.getMemoryUsage()) / userCount
+         << setw(12) << flatID << setw(14) << flatName << endl;
+    return 0;
+}
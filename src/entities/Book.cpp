@@ -4,12 +4,28 @@
 #include <iomanip>
 #include "../utils/StringUtils.h"
 
+// Index of the lowest set bit; mask must be non-zero
+static inline int lowestBit(uint64_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(mask);
+#else
+    int bit = 0;
+    while ((mask & 1u) == 0) {
+        mask >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
 // ============ CONSTRUCTORS ============
 
 Book::Book() : isbn(""), title(""), author(""), quantity(0), availableCopies(0) {}
 
 Book::Book(string isbn, string title, string author, int quantity) 
-    : isbn(isbn), title(title), author(author), quantity(quantity), availableCopies(quantity) {}
+    : isbn(isbn), title(title), author(author), quantity(0), availableCopies(0) {
+    addCopies(quantity);
+}
 
 // ============ GETTERS ============
 
@@ -19,39 +35,141 @@ string Book::getAuthor() const { return author; }
 int Book::getQuantity() const { return quantity; }
 int Book::getAvailableCopies() const { return availableCopies; }
 bool Book::isAvailable() const { return availableCopies > 0; }
+int Book::getCopyCount() const { return static_cast<int>(copies.size()); }
+
+Book::CopyStatus Book::getCopyStatus(int copyNumber) const {
+    if (copyNumber < 1 || copyNumber > getCopyCount()) {
+        return RETIRED;
+    }
+    return copies[copyNumber - 1];
+}
+
+string Book::getBarcode(int copyNumber) const {
+    return formatBarcode(isbn, copyNumber);
+}
 
 // ============ SETTERS ============
 
+void Book::setTitle(const string& newTitle) { title = newTitle; }
+void Book::setAuthor(const string& newAuthor) { author = newAuthor; }
+
 void Book::setQuantity(int qty) {
-    quantity = qty;
-    // Adjust available copies if needed
-    if (availableCopies > quantity) {
-        availableCopies = quantity;
+    if (qty > quantity) {
+        addCopies(qty - quantity);
+        return;
+    }
+    
+    // Retire the newest copies on the shelf; copies on loan stay in service
+    for (int n = getCopyCount(); n >= 1 && quantity > qty; n--) {
+        if (copies[n - 1] == ON_SHELF) {
+            retireCopy(n);
+        }
     }
 }
 
 void Book::setAvailableCopies(int copies) {
-    if (copies >= 0 && copies <= quantity) {
-        availableCopies = copies;
+    if (copies < 0 || copies > quantity) {
+        return;
+    }
+    
+    // Lowest-numbered copies in service go on loan, the rest on the shelf
+    int onLoan = quantity - copies;
+    for (int n = 1; n <= getCopyCount(); n++) {
+        if (this->copies[n - 1] == RETIRED) {
+            continue;
+        }
+        bool lent = (onLoan > 0);
+        this->copies[n - 1] = lent ? ON_LOAN : ON_SHELF;
+        setShelfBit(n, !lent);
+        onLoan -= lent ? 1 : 0;
+    }
+    availableCopies = copies;
+}
+
+// ============ COPY BOOKKEEPING ============
+
+void Book::addCopies(int count) {
+    for (int i = 0; i < count; i++) {
+        copies.push_back(ON_SHELF);
+        setShelfBit(getCopyCount(), true);
+        quantity++;
+        availableCopies++;
+    }
+}
+
+void Book::setShelfBit(int copyNumber, bool onShelf) {
+    size_t word = static_cast<size_t>(copyNumber - 1) / 64;
+    uint64_t bit = uint64_t(1) << ((copyNumber - 1) % 64);
+    if (word >= shelfBits.size()) {
+        shelfBits.resize(word + 1, 0);
+    }
+    if (onShelf) {
+        shelfBits[word] |= bit;
+    } else {
+        shelfBits[word] &= ~bit;
     }
 }
 
 // ============ BUSINESS LOGIC ============
 
-bool Book::borrowBook() {
-    if (availableCopies > 0) {
-        availableCopies--;
-        return true;
+// Find-first-set over the shelf bitmap: one word covers 64 copies, so a
+// 500-copy textbook is at most 8 word tests
+int Book::borrowCopy() {
+    if (availableCopies == 0) {
+        return 0;
     }
-    return false;
+    
+    for (size_t word = 0; word < shelfBits.size(); word++) {
+        if (shelfBits[word] != 0) {
+            int copyNumber = static_cast<int>(word * 64) + lowestBit(shelfBits[word]) + 1;
+            shelfBits[word] &= shelfBits[word] - 1;   // Clear the lowest set bit
+            copies[copyNumber - 1] = ON_LOAN;
+            availableCopies--;
+            return copyNumber;
+        }
+    }
+    return 0;
 }
 
-bool Book::returnBook() {
-    if (availableCopies < quantity) {
-        availableCopies++;
-        return true;
+bool Book::takeCopy(int copyNumber) {
+    if (getCopyStatus(copyNumber) != ON_SHELF) {
+        return false;
+    }
+    copies[copyNumber - 1] = ON_LOAN;
+    setShelfBit(copyNumber, false);
+    availableCopies--;
+    return true;
+}
+
+bool Book::returnCopy(int copyNumber) {
+    if (copyNumber == 0) {
+        // Loan from before copies were tracked: take any copy on loan
+        for (int n = 1; n <= getCopyCount(); n++) {
+            if (copies[n - 1] == ON_LOAN) {
+                return returnCopy(n);
+            }
+        }
+        return false;
+    }
+    
+    if (getCopyStatus(copyNumber) != ON_LOAN) {
+        return false;  // Not out, or not a copy of this book
+    }
+    copies[copyNumber - 1] = ON_SHELF;
+    setShelfBit(copyNumber, true);
+    availableCopies++;
+    return true;
+}
+
+bool Book::retireCopy(int copyNumber) {
+    if (getCopyStatus(copyNumber) != ON_SHELF) {
+        return false;
     }
-    return false;  // Can't return more than total quantity
+    copies[copyNumber - 1] = RETIRED;
+    setShelfBit(copyNumber, false);
+    quantity--;
+    availableCopies--;
+    return true;
 }
 
 // ============ UTILITY METHODS ============
@@ -67,14 +185,28 @@ string Book::toString() const {
     return ss.str();
 }
 
+// One char per copy number: S = shelf, L = loan, R = retired
+string Book::getCopyStates() const {
+    static const char STATE_CHARS[] = {'S', 'L', 'R'};
+    string states;
+    states.reserve(copies.size());
+    for (CopyStatus status : copies) {
+        states += STATE_CHARS[status];
+    }
+    return states;
+}
+
 string Book::toFileString() const {
-    // Format: ISBN,Title,Author,Quantity,AvailableCopies
+    // Format: ISBN,Title,Author,Quantity,AvailableCopies,CopyStates
+    string states = getCopyStates();
+    
     stringstream ss;
     ss << StringUtils::escapeCSV(isbn) << ","
        << StringUtils::escapeCSV(title) << ","
        << StringUtils::escapeCSV(author) << ","
        << quantity << ","
-       << availableCopies;
+       << availableCopies << ","
+       << states;
     return ss.str();
 }
 
@@ -92,8 +224,37 @@ Book Book::fromFileString(string line) {
     int quantity = stoi(fields[3]);
     int availableCopies = stoi(fields[4]);
     
-    Book book(isbn, title, author, quantity);
-    book.setAvailableCopies(availableCopies);
+    if (fields.size() < 6 || fields[5].empty()) {
+        // Pre-copy format: only the counts are known
+        Book book(isbn, title, author, quantity);
+        book.setAvailableCopies(availableCopies);
+        return book;
+    }
     
+    return restore(isbn, title, author, fields[5]);
+}
+
+// Counts are rebuilt from the copy states
+Book Book::restore(const string& isbn, const string& title, const string& author, 
+                   string_view copyStates) {
+    Book book(isbn, title, author, 0);
+    for (char state : copyStates) {
+        if (state != 'S' && state != 'L' && state != 'R') {
+            return Book();  // Corrupt copy states
+        }
+        book.addCopies(1);
+        int copyNumber = book.getCopyCount();
+        if (state == 'L') {
+            book.copies[copyNumber - 1] = ON_LOAN;
+            book.setShelfBit(copyNumber, false);
+            book.availableCopies--;
+        } else if (state == 'R') {
+            book.retireCopy(copyNumber);
+        }
+    }
     return book;
-}
\ No newline at end of file
+}
+
+string Book::formatBarcode(const string& isbn, int copyNumber) {
+    return isbn + "-C" + to_string(copyNumber);
+}
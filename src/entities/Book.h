@@ -3,15 +3,32 @@
 #define BOOK_H
 
 #include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
 using namespace std;
 
 class Book {
+public:
+    // State of one physical copy. Copies are numbered from 1 and numbers
+    // are never reused, so a barcode (ISBN-C<n>) always names one item.
+    enum CopyStatus : uint8_t {
+        ON_SHELF,
+        ON_LOAN,
+        RETIRED      // Damaged/lost; kept so old records still resolve
+    };
+
 private:
     string isbn;           // Unique identifier
     string title;          // Book title
     string author;         // Book author
-    int quantity;          // Total copies
-    int availableCopies;   // Available copies
+    int quantity;          // Copies in service (not retired)
+    int availableCopies;   // Copies on the shelf
+    vector<CopyStatus> copies;   // copies[n - 1] is copy n
+    vector<uint64_t> shelfBits;  // Bit n - 1 set while copy n is on the shelf
+    
+    void addCopies(int count);
+    void setShelfBit(int copyNumber, bool onShelf);
 
 public:
     // Constructors
@@ -25,19 +42,30 @@ public:
     int getQuantity() const;
     int getAvailableCopies() const;
     bool isAvailable() const;  // Computed: availableCopies > 0
+    int getCopyCount() const;  // Every copy number issued, retired included
+    CopyStatus getCopyStatus(int copyNumber) const;   // RETIRED if out of range
+    string getBarcode(int copyNumber) const;
+    string getCopyStates() const;      // S/L/R per copy number, as saved
     
     // Setters
-    void setQuantity(int qty);
-    void setAvailableCopies(int copies);
+    void setTitle(const string& newTitle);
+    void setAuthor(const string& newAuthor);
+    void setQuantity(int qty);             // Adds copies, or retires shelf copies
+    void setAvailableCopies(int copies);   // Legacy data: marks the rest on loan
     
-    // Business Logic
-    bool borrowBook();   // Decrease available copies
-    bool returnBook();   // Increase available copies
+    // Business Logic (copy-level; O(1) for a few hundred copies)
+    int borrowCopy();                  // Lowest free copy number, 0 if none
+    bool takeCopy(int copyNumber);     // That copy, if on the shelf (journal replay)
+    bool returnCopy(int copyNumber);   // 0 = any copy on loan (legacy loans)
+    bool retireCopy(int copyNumber);   // Shelf copies only
     
     // Utility
     string toString() const;           // For display
     string toFileString() const;       // For saving to CSV
     static Book fromFileString(string line);  // For loading from CSV
+    static Book restore(const string& isbn, const string& title, const string& author, 
+                        string_view copyStates);   // Empty Book if states are corrupt
+    static string formatBarcode(const string& isbn, int copyNumber);
 };
 
-#endif // BOOK_H
\ No newline at end of file
+#endif // BOOK_H
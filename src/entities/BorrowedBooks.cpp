@@ -0,0 +1,103 @@
+// entities/BorrowedBooks.cpp
+#include "BorrowedBooks.h"
+#include "../utils/HashUtils.h"
+#include <cstring>
+
+// ============ CONSTRUCTOR ============
+
+BorrowedBooks::BorrowedBooks() {
+    clear();
+}
+
+void BorrowedBooks::clear() {
+    for (int i = 0; i < MAX_BORROW_LIMIT; i++) {
+        keys[i] = 0;
+        lengths[i] = 0;
+        isbns[i][0] = '\0';
+    }
+    count = 0;
+}
+
+// ============ HELPERS ============
+
+uint64_t BorrowedBooks::makeKey(const string& isbn) {
+    return HashUtils::hashString(isbn) | 1;  // Never collides with "unused"
+}
+
+int BorrowedBooks::find(const string& isbn) const {
+    uint64_t key = makeKey(isbn);
+    
+    // Gather all key hits in one pass (no data-dependent branches)
+    uint32_t hits = 0;
+    for (int i = 0; i < MAX_BORROW_LIMIT; i++) {
+        hits |= static_cast<uint32_t>(keys[i] == key) << i;
+    }
+    
+    while (hits != 0) {
+        int i = 0;
+        while (((hits >> i) & 1u) == 0) i++;
+        if (lengths[i] == isbn.size() && memcmp(isbns[i], isbn.data(), isbn.size()) == 0) {
+            return i;
+        }
+        hits &= hits - 1;
+    }
+    return -1;
+}
+
+// ============ OPERATIONS ============
+
+bool BorrowedBooks::insert(const string& isbn) {
+    if (count >= MAX_BORROW_LIMIT || isbn.empty() || 
+        isbn.size() > static_cast<size_t>(MAX_ISBN_LENGTH) || find(isbn) >= 0) {
+        return false;
+    }
+    
+    keys[count] = makeKey(isbn);
+    lengths[count] = static_cast<uint8_t>(isbn.size());
+    memcpy(isbns[count], isbn.data(), isbn.size());
+    isbns[count][isbn.size()] = '\0';
+    count++;
+    return true;
+}
+
+bool BorrowedBooks::erase(const string& isbn) {
+    int index = find(isbn);
+    if (index < 0) {
+        return false;
+    }
+    
+    // Move the last entry into the hole
+    int last = count - 1;
+    if (index != last) {
+        keys[index] = keys[last];
+        lengths[index] = lengths[last];
+        memcpy(isbns[index], isbns[last], MAX_ISBN_LENGTH + 1);
+    }
+    keys[last] = 0;
+    lengths[last] = 0;
+    isbns[last][0] = '\0';
+    count--;
+    return true;
+}
+
+bool BorrowedBooks::contains(const string& isbn) const {
+    return find(isbn) >= 0;
+}
+
+// ============ ACCESSORS ============
+
+int BorrowedBooks::size() const {
+    return count;
+}
+
+bool BorrowedBooks::empty() const {
+    return count == 0;
+}
+
+bool BorrowedBooks::full() const {
+    return count >= MAX_BORROW_LIMIT;
+}
+
+const char* BorrowedBooks::isbnAt(int index) const {
+    return isbns[index];
+}
@@ -0,0 +1,39 @@
+// entities/BorrowedBooks.h
+#ifndef BORROWEDBOOKS_H
+#define BORROWEDBOOKS_H
+
+#include "../Config.h"
+#include <string>
+#include <cstdint>
+using namespace std;
+
+// Fixed-capacity set of borrowed ISBNs stored inline in the User object.
+// Loans are capped at MAX_BORROW_LIMIT, so there is no heap allocation:
+// each entry is a 64-bit key (ISBN hash, never 0) plus the ISBN text.
+// Membership scans all key slots without early exit and only compares
+// text on a key hit. Order is insertion order; erase swaps in the last.
+class BorrowedBooks {
+private:
+    uint64_t keys[MAX_BORROW_LIMIT];                 // 0 = unused
+    char isbns[MAX_BORROW_LIMIT][MAX_ISBN_LENGTH + 1];
+    uint8_t lengths[MAX_BORROW_LIMIT];
+    uint8_t count;
+    
+    static uint64_t makeKey(const string& isbn);
+    int find(const string& isbn) const;
+
+public:
+    BorrowedBooks();
+    
+    bool insert(const string& isbn);   // false if full, present or too long
+    bool erase(const string& isbn);
+    bool contains(const string& isbn) const;
+    void clear();
+    
+    int size() const;
+    bool empty() const;
+    bool full() const;
+    const char* isbnAt(int index) const;  // 0 <= index < size()
+};
+
+#endif // BORROWEDBOOKS_H
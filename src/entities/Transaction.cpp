@@ -1,58 +1,77 @@
 // entities/Transaction.cpp
 #include "Transaction.h"
+#include "User.h"
 #include "../utils/StringUtils.h"
+#include "../utils/TimeUtils.h"
+#include "../utils/StringDictionary.h"
 #include <sstream>
 #include <iomanip>
-#include <ctime>
 
-// Initialize static counter
-int Transaction::transactionCounter = 1;
+// Initialize static ID generator
+IdGenerator Transaction::idGenerator;
 
 // ============ CONSTRUCTORS ============
 
 Transaction::Transaction() 
-    : transactionID(""), userID(""), isbn(""), type(""), 
-      timestamp(""), userName(""), bookTitle("") {}
-
-Transaction::Transaction(string userID, string isbn, string type, 
-                        string userName, string bookTitle)
-    : userID(userID), isbn(isbn), type(type), userName(userName), bookTitle(bookTitle) {
-    this->transactionID = generateID();
-    this->timestamp = generateTimestamp();
+    : transactionID(0), userID(0), isbn(""), type(""), 
+      timestamp(0), userNameCode(StringDictionary::NO_CODE), 
+      bookTitleCode(StringDictionary::NO_CODE), copyNumber(0) {}
+
+Transaction::Transaction(uint64_t userID, string isbn, string type, 
+                        string userName, string bookTitle, int copyNumber)
+    : userID(userID), isbn(isbn), type(type), copyNumber(copyNumber) {
+    StringDictionary* dictionary = StringDictionary::getInstance();
+    this->userNameCode = dictionary->intern(userName);
+    this->bookTitleCode = dictionary->intern(bookTitle);
+    this->transactionID = idGenerator.allocate();
+    this->timestamp = TimeUtils::nowMillis();
 }
 
 // ============ GETTERS ============
 
-string Transaction::getTransactionID() const { return transactionID; }
-string Transaction::getUserID() const { return userID; }
-string Transaction::getISBN() const { return isbn; }
-string Transaction::getType() const { return type; }
-string Transaction::getTimestamp() const { return timestamp; }
-string Transaction::getUserName() const { return userName; }
-string Transaction::getBookTitle() const { return bookTitle; }
+uint64_t Transaction::getID() const { return transactionID; }
+uint64_t Transaction::getUserID() const { return userID; }
+string Transaction::getTransactionID() const { return formatID(transactionID); }
+const string& Transaction::getISBN() const { return isbn; }
+const string& Transaction::getType() const { return type; }
+int64_t Transaction::getTimestamp() const { return timestamp; }
+string Transaction::getFormattedTimestamp() const { return TimeUtils::format(timestamp); }
+uint32_t Transaction::getUserNameCode() const { return userNameCode; }
+uint32_t Transaction::getBookTitleCode() const { return bookTitleCode; }
+int Transaction::getCopyNumber() const { return copyNumber; }
+
+const string& Transaction::getUserName() const {
+    return StringDictionary::getInstance()->lookup(userNameCode);
+}
+
+const string& Transaction::getBookTitle() const {
+    return StringDictionary::getInstance()->lookup(bookTitleCode);
+}
 
 // ============ UTILITY METHODS ============
 
 string Transaction::toString() const {
     stringstream ss;
-    ss << "Transaction ID: " << transactionID << "\n"
+    ss << "Transaction ID: " << getTransactionID() << "\n"
        << "Type: " << type << "\n"
-       << "User: " << userName << " (" << userID << ")\n"
-       << "Book: " << bookTitle << " (" << isbn << ")\n"
-       << "Date: " << timestamp;
+       << "User: " << getUserName() << " (" << User::formatID(userID) << ")\n"
+       << "Book: " << getBookTitle() << " (" << isbn << ")\n"
+       << "Date: " << getFormattedTimestamp();
     return ss.str();
 }
 
 string Transaction::toFileString() const {
-    // Format: TransactionID,UserID,ISBN,Type,Timestamp,UserName,BookTitle
+    // Format: TransactionID,UserID,ISBN,Type,Timestamp,@UserNameCode,@BookTitleCode,Copy
+    // (codes refer to STRINGS_FILE)
     stringstream ss;
-    ss << StringUtils::escapeCSV(transactionID) << ","
-       << StringUtils::escapeCSV(userID) << ","
+    ss << getTransactionID() << ","
+       << User::formatID(userID) << ","
        << StringUtils::escapeCSV(isbn) << ","
        << StringUtils::escapeCSV(type) << ","
-       << StringUtils::escapeCSV(timestamp) << ","
-       << StringUtils::escapeCSV(userName) << ","
-       << StringUtils::escapeCSV(bookTitle);
+       << TimeUtils::formatUTC(timestamp) << ","
+       << "@" << userNameCode << ","
+       << "@" << bookTitleCode << ","
+       << copyNumber;
     return ss.str();
 }
 
@@ -64,37 +83,81 @@ Transaction Transaction::fromFileString(const string& line) {
     }
     
     Transaction trans;
-    trans.transactionID = StringUtils::unescapeCSV(fields[0]);
-    trans.userID = StringUtils::unescapeCSV(fields[1]);
+    if (!parseID(StringUtils::unescapeCSV(fields[0]), trans.transactionID) ||
+        !User::parseID(StringUtils::unescapeCSV(fields[1]), trans.userID)) {
+        return Transaction();  // Invalid IDs
+    }
+    if (!TimeUtils::parse(StringUtils::unescapeCSV(fields[4]), trans.timestamp)) {
+        return Transaction();  // Invalid timestamp
+    }
+    
     trans.isbn = StringUtils::unescapeCSV(fields[2]);
     trans.type = StringUtils::unescapeCSV(fields[3]);
-    trans.timestamp = StringUtils::unescapeCSV(fields[4]);
-    trans.userName = StringUtils::unescapeCSV(fields[5]);
-    trans.bookTitle = StringUtils::unescapeCSV(fields[6]);
+    trans.userNameCode = decodeStringField(StringUtils::unescapeCSV(fields[5]));
+    trans.bookTitleCode = decodeStringField(StringUtils::unescapeCSV(fields[6]));
+    if (fields.size() > 7) {
+        trans.copyNumber = stoi(fields[7]);   // Absent before copies were tracked
+    }
     
     return trans;
 }
 
-// ============ STATIC METHODS ============
-
-string Transaction::generateTimestamp() {
-    time_t now = time(0);
-    tm* ltm = localtime(&now);
+Transaction Transaction::restore(uint64_t id, uint64_t userID, const string& isbn, 
+                                 const string& type, const string& userName, 
+                                 const string& bookTitle, int copyNumber, int64_t timestamp) {
+    StringDictionary* dictionary = StringDictionary::getInstance();
     
-    stringstream ss;
-    ss << setfill('0')
-       << setw(4) << (1900 + ltm->tm_year) << "-"
-       << setw(2) << (1 + ltm->tm_mon) << "-"
-       << setw(2) << ltm->tm_mday << " "
-       << setw(2) << ltm->tm_hour << ":"
-       << setw(2) << ltm->tm_min << ":"
-       << setw(2) << ltm->tm_sec;
+    Transaction trans;
+    trans.transactionID = id;
+    trans.userID = userID;
+    trans.isbn = isbn;
+    trans.type = type;
+    trans.timestamp = timestamp;
+    trans.userNameCode = dictionary->intern(userName);
+    trans.bookTitleCode = dictionary->intern(bookTitle);
+    trans.copyNumber = copyNumber;
+    idGenerator.observe(id);
+    return trans;
+}
+
+Transaction Transaction::restore(uint64_t id, uint64_t userID, string isbn, string type, 
+                                 uint32_t userNameCode, uint32_t bookTitleCode, 
+                                 int copyNumber, int64_t timestamp) {
+    Transaction trans;
+    trans.transactionID = id;
+    trans.userID = userID;
+    trans.isbn = move(isbn);
+    trans.type = move(type);
+    trans.timestamp = timestamp;
+    trans.userNameCode = userNameCode;
+    trans.bookTitleCode = bookTitleCode;
+    trans.copyNumber = copyNumber;
+    idGenerator.observe(id);
+    return trans;
+}
+
+// "@<code>" refers to a loaded dictionary entry; anything else is plain
+// text from the pre-dictionary format and is interned as-is
+uint32_t Transaction::decodeStringField(const string& field) {
+    StringDictionary* dictionary = StringDictionary::getInstance();
     
-    return ss.str();
+    if (field.length() > 1 && field[0] == '@' && 
+        field.find_first_not_of("0123456789", 1) == string::npos && field.length() <= 11) {
+        unsigned long code = stoul(field.substr(1));
+        if (code < StringDictionary::NO_CODE && 
+            dictionary->contains(static_cast<uint32_t>(code))) {
+            return static_cast<uint32_t>(code);
+        }
+    }
+    return dictionary->intern(field);
 }
 
-string Transaction::generateID() {
-    stringstream ss;
-    ss << "T" << setfill('0') << setw(4) << transactionCounter++;
-    return ss.str();
+// ============ STATIC METHODS ============
+
+string Transaction::formatID(uint64_t id) {
+    return IdGenerator::format('T', id, 4);
+}
+
+bool Transaction::parseID(const string& text, uint64_t& id) {
+    return IdGenerator::parse(text, 'T', id);
 }
\ No newline at end of file
@@ -3,43 +3,60 @@
 #define TRANSACTION_H
 
 #include <string>
-#include <ctime>
+#include <cstdint>
+#include "../utils/IdGenerator.h"
 using namespace std;
 
 class Transaction {
 private:
-    string transactionID;   // Auto-generated (T001, T002...)
-    string userID;          
+    uint64_t transactionID; // Auto-generated; shown as T0001, T0002...
+    uint64_t userID;        
     string isbn;            
     string type;            // "BORROW" or "RETURN"
-    string timestamp;       
-    string userName;        // Cached for display
-    string bookTitle;       // Cached for display
+    int64_t timestamp;      // Epoch milliseconds (UTC)
+    uint32_t userNameCode;  // StringDictionary code, cached for display
+    uint32_t bookTitleCode; // StringDictionary code, cached for display
+    int copyNumber;         // Physical copy (see Book::getBarcode); 0 if unknown
 
 public:
     // Constructors
     Transaction();
-    Transaction(string userID, string isbn, string type, 
-                string userName, string bookTitle);
+    Transaction(uint64_t userID, string isbn, string type, 
+                string userName, string bookTitle, int copyNumber = 0);
     
     // Getters
-    string getTransactionID() const;
-    string getUserID() const;
-    string getISBN() const;
-    string getType() const;
-    string getTimestamp() const;
-    string getUserName() const;
-    string getBookTitle() const;
+    uint64_t getID() const;
+    uint64_t getUserID() const;
+    string getTransactionID() const;        // Display/file form ("T0001")
+    const string& getISBN() const;
+    const string& getType() const;
+    int64_t getTimestamp() const;
+    string getFormattedTimestamp() const;   // "YYYY-MM-DD HH:MM:SS" local time
+    const string& getUserName() const;
+    const string& getBookTitle() const;
+    uint32_t getUserNameCode() const;
+    uint32_t getBookTitleCode() const;
+    int getCopyNumber() const;
     
     // Utility
     string toString() const;
     string toFileString() const;
     static Transaction fromFileString(const string& line);
-    static string generateTimestamp();
-    static string generateID();
+    static Transaction restore(uint64_t id, uint64_t userID, const string& isbn, 
+                               const string& type, const string& userName, 
+                               const string& bookTitle, int copyNumber, 
+                               int64_t timestamp);   // Journal replay; keeps id
+    static Transaction restore(uint64_t id, uint64_t userID, string isbn, string type, 
+                               uint32_t userNameCode, uint32_t bookTitleCode, 
+                               int copyNumber, int64_t timestamp);   // Codes already loaded
     
-    // Static counter for ID generation
-    static int transactionCounter;
+    // ID generation and the legacy text form
+    static IdGenerator idGenerator;
+    static string formatID(uint64_t id);
+    static bool parseID(const string& text, uint64_t& id);
+    
+private:
+    static uint32_t decodeStringField(const string& field);
 };
 
 #endif // TRANSACTION_H
\ No newline at end of file
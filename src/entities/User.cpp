@@ -5,50 +5,125 @@
 #include <sstream>
 #include <iomanip>
 #include <functional>
+#include "../utils/Crypto.h"
 
-// Initialize static counter
-int User::userCounter = 1;
+// Initialize static ID generator
+IdGenerator User::idGenerator;
 
 // ============ CONSTRUCTORS ============
 
-User::User() : userID(""), username(""), passwordHash(""), fullName(""), 
+User::User() : userID(0), username(""), passwordHash(""), fullName(""), 
                email(""), phoneNumber(""), active(true) {}
 
 User::User(string username, string password, string fullName, string email, string phone)
     : username(username), fullName(fullName), email(email), phoneNumber(phone), active(true) {
-    this->userID = generateUserID();
+    this->userID = idGenerator.allocate();
     this->passwordHash = hashPassword(password);
 }
 
 // ============ AUTHENTICATION ============
 
+// Stored format: scrypt$<logN>$<r>$<p>$<salt hex>$<hash hex>
+// (no commas, so it stays a plain CSV field)
 string User::hashPassword(const string& password) {
-    // Simple hash for demonstration (NOT cryptographically secure)
-    // In production, use bcrypt, scrypt, or Argon2
+    vector<uint8_t> salt = Crypto::randomBytes(PASSWORD_SALT_BYTES);
+    vector<uint8_t> key = Crypto::scrypt(password, salt, 1ULL << SCRYPT_LOG_N,
+                                         SCRYPT_R, SCRYPT_P, PASSWORD_HASH_BYTES);
+    
+    stringstream ss;
+    ss << "scrypt$" << SCRYPT_LOG_N << "$" << SCRYPT_R << "$" << SCRYPT_P << "$"
+       << Crypto::toHex(salt) << "$" << Crypto::toHex(key);
+    return ss.str();
+}
+
+// Unsalted std::hash used before scrypt; only kept to verify and upgrade
+// old users.txt entries
+string User::legacyHashPassword(const string& password) {
     hash<string> hasher;
     size_t hashValue = hasher(password + "LIBRARY_SALT_2024");
     return to_string(hashValue);
 }
 
+// Splits "scrypt$logN$r$p$salt$hash"; false for legacy or malformed input
+static bool parseScryptHash(const string& stored, int& logN, int& r, int& p,
+                            vector<uint8_t>& salt, vector<uint8_t>& key) {
+    vector<string> parts;
+    stringstream ss(stored);
+    string part;
+    while (getline(ss, part, '$')) {
+        parts.push_back(part);
+    }
+    if (parts.size() != 6 || parts[0] != "scrypt") {
+        return false;
+    }
+    
+    try {
+        logN = stoi(parts[1]);
+        r = stoi(parts[2]);
+        p = stoi(parts[3]);
+    } catch (...) {
+        return false;
+    }
+    
+    // Bound the cost so a tampered users.txt can't demand gigabytes:
+    // scrypt holds 128 * r * 2^logN bytes and runs p * r block mixes per item
+    if (logN < 1 || logN > 22 || r < 1 || r > 32 || p < 1 || p > 16) {
+        return false;
+    }
+    if ((128ULL * r << logN) > SCRYPT_MAX_MEMORY_BYTES || p * r > SCRYPT_MAX_PR) {
+        return false;
+    }
+    
+    salt = Crypto::fromHex(parts[4]);
+    key = Crypto::fromHex(parts[5]);
+    return !salt.empty() && !key.empty();
+}
+
+bool User::verifyPassword(const string& storedHash, const string& password) {
+    int logN, r, p;
+    vector<uint8_t> salt, key;
+    
+    if (parseScryptHash(storedHash, logN, r, p, salt, key)) {
+        vector<uint8_t> candidate = Crypto::scrypt(password, salt, 1ULL << logN, 
+                                                   r, p, key.size());
+        return Crypto::constantTimeEquals(candidate, key);
+    }
+    
+    return storedHash == legacyHashPassword(password);
+}
+
+bool User::needsRehash(const string& storedHash) {
+    int logN, r, p;
+    vector<uint8_t> salt, key;
+    
+    if (!parseScryptHash(storedHash, logN, r, p, salt, key)) {
+        return true;  // Legacy hash
+    }
+    return logN < SCRYPT_LOG_N || r < SCRYPT_R || p < SCRYPT_P;
+}
+
 bool User::authenticate(const string& password) const {
-    return passwordHash == hashPassword(password);
+    return verifyPassword(passwordHash, password);
 }
 
 // ============ GETTERS ============
 
-string User::getUserID() const { return userID; }
-string User::getUsername() const { return username; }
-string User::getFullName() const { return fullName; }
-string User::getEmail() const { return email; }
-string User::getPhoneNumber() const { return phoneNumber; }
-int User::getBorrowedCount() const { return borrowedISBNs.size(); }
-set<string> User::getBorrowedISBNs() const { return borrowedISBNs; }
+uint64_t User::getID() const { return userID; }
+string User::getUserID() const { return formatID(userID); }
+const string& User::getUsername() const { return username; }
+const string& User::getFullName() const { return fullName; }
+const string& User::getEmail() const { return email; }
+const string& User::getPhoneNumber() const { return phoneNumber; }
+const string& User::getPasswordHash() const { return passwordHash; }
+int User::getBorrowedCount() const { return borrowedBooks.size(); }
+const BorrowedBooks& User::getBorrowedBooks() const { return borrowedBooks; }
 bool User::isActive() const { return active; }
 
 // ============ SETTERS ============
 
-void User::setUserID(const string& id) { userID = id; }
+void User::setUserID(uint64_t id) { userID = id; }
 void User::setActive(bool status) { active = status; }
+void User::setPasswordHash(const string& hash) { passwordHash = hash; }
 
 void User::updateContact(const string& newEmail, const string& newPhone) {
     email = newEmail;
@@ -61,23 +136,23 @@ bool User::canBorrow() const {
     return active && (getBorrowedCount() < MAX_BORROW_LIMIT);
 }
 
-void User::addBorrowedBook(const string& isbn) {
-    borrowedISBNs.insert(isbn);  // Set automatically handles duplicates
+bool User::addBorrowedBook(const string& isbn) {
+    return borrowedBooks.insert(isbn);  // Rejects duplicates and overflow
 }
 
-void User::removeBorrowedBook(const string& isbn) {
-    borrowedISBNs.erase(isbn);
+bool User::removeBorrowedBook(const string& isbn) {
+    return borrowedBooks.erase(isbn);
 }
 
 bool User::hasBorrowedBook(const string& isbn) const {
-    return borrowedISBNs.find(isbn) != borrowedISBNs.end();
+    return borrowedBooks.contains(isbn);
 }
 
 // ============ UTILITY METHODS ============
 
 string User::toString() const {
     stringstream ss;
-    ss << "User ID: " << userID << "\n"
+    ss << "User ID: " << getUserID() << "\n"
        << "Username: " << username << "\n"
        << "Full Name: " << fullName << "\n"
        << "Email: " << email << "\n"
@@ -90,7 +165,7 @@ string User::toString() const {
 string User::toFileString() const {
     // Format: UserID,Username,PasswordHash,FullName,Email,Phone,Active,ISBN1;ISBN2;ISBN3
     stringstream ss;
-    ss << StringUtils::escapeCSV(userID) << ","
+    ss << getUserID() << ","
        << StringUtils::escapeCSV(username) << ","
        << StringUtils::escapeCSV(passwordHash) << ","
        << StringUtils::escapeCSV(fullName) << ","
@@ -99,11 +174,9 @@ string User::toFileString() const {
        << (active ? "1" : "0") << ",";
     
     // Add borrowed ISBNs separated by semicolons
-    bool first = true;
-    for (const auto& isbn : borrowedISBNs) {
-        if (!first) ss << ";";
-        ss << isbn;
-        first = false;
+    for (int i = 0; i < borrowedBooks.size(); i++) {
+        if (i > 0) ss << ";";
+        ss << borrowedBooks.isbnAt(i);
     }
     
     return ss.str();
@@ -117,7 +190,9 @@ User User::fromFileString(const string& line) {
     }
     
     User user;
-    user.userID = StringUtils::unescapeCSV(fields[0]);
+    if (!parseID(StringUtils::unescapeCSV(fields[0]), user.userID)) {
+        return User();  // Invalid ID
+    }
     user.username = StringUtils::unescapeCSV(fields[1]);
     user.passwordHash = StringUtils::unescapeCSV(fields[2]);
     user.fullName = StringUtils::unescapeCSV(fields[3]);
@@ -130,17 +205,32 @@ User User::fromFileString(const string& line) {
         stringstream ss(fields[7]);
         string isbn;
         while (getline(ss, isbn, ';')) {
-            user.borrowedISBNs.insert(StringUtils::trim(isbn));
+            user.borrowedBooks.insert(StringUtils::trim(isbn));
         }
     }
     
     return user;
 }
 
+User User::restore(uint64_t id, string username, string passwordHash, string fullName, 
+                   string email, string phone, bool active) {
+    User user;
+    user.userID = id;
+    user.username = move(username);
+    user.passwordHash = move(passwordHash);
+    user.fullName = move(fullName);
+    user.email = move(email);
+    user.phoneNumber = move(phone);
+    user.active = active;
+    return user;
+}
+
 // ============ STATIC METHODS ============
 
-string User::generateUserID() {
-    stringstream ss;
-    ss << "U" << setfill('0') << setw(3) << userCounter++;
-    return ss.str();
+string User::formatID(uint64_t id) {
+    return IdGenerator::format('U', id, 3);
+}
+
+bool User::parseID(const string& text, uint64_t& id) {
+    return IdGenerator::parse(text, 'U', id);
 }
\ No newline at end of file
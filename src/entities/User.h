@@ -3,18 +3,20 @@
 #define USER_H
 
 #include <string>
-#include <set>
+#include <cstdint>
+#include "BorrowedBooks.h"
+#include "../utils/IdGenerator.h"
 using namespace std;
 
 class User {
 private:
-    string userID;          // Auto-generated (U001, U002...)
+    uint64_t userID;        // Auto-generated; shown as U001, U002...
     string username;        // For login (unique)
     string passwordHash;    // Hashed password
     string fullName;        
     string email;           
     string phoneNumber;     
-    set<string> borrowedISBNs;  // Set prevents duplicates, O(log n) lookup
+    BorrowedBooks borrowedBooks;  // Inline, capped at MAX_BORROW_LIMIT
     bool active;            // Account status
 
 public:
@@ -24,37 +26,46 @@ public:
     
     // Authentication
     bool authenticate(const string& password) const;
-    static string hashPassword(const string& password);
+    static string hashPassword(const string& password);        // Salted scrypt
+    static string legacyHashPassword(const string& password);  // Pre-scrypt format
+    static bool verifyPassword(const string& storedHash, const string& password);
+    static bool needsRehash(const string& storedHash);
     
     // Getters
-    string getUserID() const;
-    string getUsername() const;
-    string getFullName() const;
-    string getEmail() const;
-    string getPhoneNumber() const;
-    int getBorrowedCount() const;  // Computed from set size
-    set<string> getBorrowedISBNs() const;
+    uint64_t getID() const;
+    string getUserID() const;               // Display/file form ("U001")
+    const string& getUsername() const;
+    const string& getFullName() const;
+    const string& getEmail() const;
+    const string& getPhoneNumber() const;
+    const string& getPasswordHash() const;
+    int getBorrowedCount() const;
+    const BorrowedBooks& getBorrowedBooks() const;
     bool isActive() const;
     
     // Setters
-    void setUserID(const string& id);
+    void setUserID(uint64_t id);
     void setActive(bool status);
+    void setPasswordHash(const string& hash);
     void updateContact(const string& email, const string& phone);
     
     // Business Logic
     bool canBorrow() const;  // Check if under limit
-    void addBorrowedBook(const string& isbn);
-    void removeBorrowedBook(const string& isbn);
+    bool addBorrowedBook(const string& isbn);
+    bool removeBorrowedBook(const string& isbn);
     bool hasBorrowedBook(const string& isbn) const;
     
     // Utility
     string toString() const;
     string toFileString() const;
     static User fromFileString(const string& line);
+    static User restore(uint64_t id, string username, string passwordHash, string fullName, 
+                        string email, string phone, bool active);   // No loans yet
     
-    // Static counter for ID generation
-    static int userCounter;
-    static string generateUserID();
+    // ID generation and the legacy text form
+    static IdGenerator idGenerator;
+    static string formatID(uint64_t id);
+    static bool parseID(const string& text, uint64_t& id);
 };
 
 #endif // USER_H
\ No newline at end of file
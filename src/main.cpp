@@ -5,10 +5,14 @@
 #include "management/LibraryManager.h"
 #include "management/AuthManager.h"
 #include "Config.h"
+#include "utils/StringUtils.h"
+#include "utils/TimeUtils.h"
+#include "utils/FileHandler.h"
 #include <iostream>
 #include <iomanip>
 #include <limits>
 #include <cstdlib>
+#include <cctype>
 
 
 #ifdef _WIN32
@@ -87,6 +91,18 @@ int getIntInput(const string& prompt) {
     }
 }
 
+// Reads a "U001"-style ID; 0 (matches no user) if it doesn't parse
+uint64_t getUserIDInput(const string& prompt) {
+    string input = StringUtils::trim(getInput(prompt));
+    if (!input.empty()) {
+        input[0] = static_cast<char>(toupper(static_cast<unsigned char>(input[0])));
+    }
+    
+    uint64_t userID = 0;
+    User::parseID(input, userID);
+    return userID;
+}
+
 string getPasswordInput(const string& prompt) {
     string password;
     cout << prompt;
@@ -181,12 +197,36 @@ void displayBookTable(const vector<Book*>& books) {
     cout << endl << "Total: " << books.size() << " book(s)" << endl;
 }
 
-void displayUserTable(const vector<User*>& users) {
-    if (users.empty()) {
-        printInfo("No users found.");
-        return;
+void displayCopyTable(Book* book, const vector<const Loan*>& loans) {
+    static const char* STATUS_NAMES[] = {"On shelf", "On loan", "Retired"};
+    
+    cout << endl;
+    cout << setw(8) << left << "Copy"
+         << setw(26) << left << "Barcode"
+         << setw(12) << left << "Status"
+         << setw(10) << left << "Borrower" << endl;
+    printSingleLine();
+    
+    for (int n = 1; n <= book->getCopyCount(); n++) {
+        Book::CopyStatus status = book->getCopyStatus(n);
+        string borrower = "-";
+        for (const Loan* loan : loans) {
+            if (loan->copyNumber == n) {
+                borrower = User::formatID(loan->userID);
+            }
+        }
+        
+        cout << setw(8) << left << ("#" + to_string(n))
+             << setw(26) << left << book->getBarcode(n)
+             << setw(12) << left << STATUS_NAMES[status]
+             << setw(10) << left << borrower << endl;
     }
     
+    cout << endl << "In service: " << book->getQuantity() << " copy(ies), " 
+         << book->getAvailableCopies() << " on the shelf" << endl;
+}
+
+void printUserTableHeader() {
     cout << endl;
     cout << setw(8) << left << "User ID"
          << setw(18) << left << "Username"
@@ -194,27 +234,48 @@ void displayUserTable(const vector<User*>& users) {
          << setw(12) << left << "Borrowed"
          << setw(10) << left << "Status" << endl;
     printSingleLine();
+}
+
+void printUserRow(const User& user) {
+    cout << setw(8) << left << user.getUserID()
+         << setw(18) << left << (user.getUsername().length() > 15 ? 
+                                 user.getUsername().substr(0, 15) + "..." : user.getUsername())
+         << setw(25) << left << (user.getFullName().length() > 22 ? 
+                                 user.getFullName().substr(0, 22) + "..." : user.getFullName())
+         << setw(12) << left << (to_string(user.getBorrowedCount()) + "/" + 
+                                 to_string(MAX_BORROW_LIMIT))
+         << setw(10) << left << (user.isActive() ? "Active" : "Inactive") << endl;
+}
+
+void displayUserTable(Span<const User> users) {
+    if (users.empty()) {
+        printInfo("No users found.");
+        return;
+    }
     
-    for (User* user : users) {
-        cout << setw(8) << left << user->getUserID()
-             << setw(18) << left << (user->getUsername().length() > 15 ? 
-                                     user->getUsername().substr(0, 15) + "..." : user->getUsername())
-             << setw(25) << left << (user->getFullName().length() > 22 ? 
-                                     user->getFullName().substr(0, 22) + "..." : user->getFullName())
-             << setw(12) << left << (to_string(user->getBorrowedCount()) + "/" + 
-                                     to_string(MAX_BORROW_LIMIT))
-             << setw(10) << left << (user->isActive() ? "Active" : "Inactive") << endl;
+    printUserTableHeader();
+    for (const User& user : users) {
+        printUserRow(user);
     }
     
     cout << endl << "Total: " << users.size() << " user(s)" << endl;
 }
 
-void displayTransactionTable(const vector<Transaction*>& transactions) {
-    if (transactions.empty()) {
-        printInfo("No transactions found.");
+void displayUserTable(const vector<User*>& users) {
+    if (users.empty()) {
+        printInfo("No users found.");
         return;
     }
     
+    printUserTableHeader();
+    for (User* user : users) {
+        printUserRow(*user);
+    }
+    
+    cout << endl << "Total: " << users.size() << " user(s)" << endl;
+}
+
+void printTransactionTableHeader() {
     cout << endl;
     cout << setw(10) << left << "Trans ID"
          << setw(10) << left << "Type"
@@ -222,20 +283,194 @@ void displayTransactionTable(const vector<Transaction*>& transactions) {
          << setw(25) << left << "Book"
          << setw(20) << left << "Date/Time" << endl;
     printSingleLine();
+}
+
+void printTransactionRow(const Transaction& trans) {
+    cout << setw(10) << left << trans.getTransactionID()
+         << setw(10) << left << trans.getType()
+         << setw(20) << left << (trans.getUserName().length() > 17 ? 
+                                 trans.getUserName().substr(0, 17) + "..." : trans.getUserName())
+         << setw(25) << left << (trans.getBookTitle().length() > 22 ? 
+                                 trans.getBookTitle().substr(0, 22) + "..." : trans.getBookTitle())
+         << setw(20) << left << trans.getFormattedTimestamp() << endl;
+}
+
+void displayTransactionTable(Span<Transaction* const> transactions) {
+    if (transactions.empty()) {
+        printInfo("No transactions found.");
+        return;
+    }
     
+    printTransactionTableHeader();
     for (Transaction* trans : transactions) {
-        cout << setw(10) << left << trans->getTransactionID()
-             << setw(10) << left << trans->getType()
-             << setw(20) << left << (trans->getUserName().length() > 17 ? 
-                                     trans->getUserName().substr(0, 17) + "..." : trans->getUserName())
-             << setw(25) << left << (trans->getBookTitle().length() > 22 ? 
-                                     trans->getBookTitle().substr(0, 22) + "..." : trans->getBookTitle())
-             << setw(20) << left << trans->getTimestamp() << endl;
+        printTransactionRow(*trans);
     }
     
     cout << endl << "Total: " << transactions.size() << " transaction(s)" << endl;
 }
 
+void displayTransactionTable(const TransactionList::Range& transactions) {
+    if (transactions.empty()) {
+        printInfo("No transactions found.");
+        return;
+    }
+    
+    printTransactionTableHeader();
+    for (Transaction* trans : transactions) {
+        printTransactionRow(*trans);
+    }
+    
+    cout << endl << "Total: " << transactions.size() << " transaction(s)" << endl;
+}
+
+// One page at a time; only the rows shown are touched
+void displayTransactionPages(TransactionCursor cursor) {
+    size_t shown = 0;
+    while (cursor.hasMore()) {
+        vector<Transaction*> page = cursor.nextPage();
+        if (page.empty()) {
+            break;  // Everything left was filtered out
+        }
+        
+        printTransactionTableHeader();
+        for (Transaction* trans : page) {
+            printTransactionRow(*trans);
+        }
+        shown += page.size();
+        
+        cout << endl << "Showing " << shown << " transaction(s), " 
+             << cursor.getTotal() - cursor.getRemaining() << " of " 
+             << cursor.getTotal() << " record(s) read" << endl;
+        if (!cursor.hasMore() || !confirmAction("Show the next page?")) {
+            break;
+        }
+    }
+    
+    if (shown == 0) {
+        printInfo("No transactions found.");
+    }
+}
+
+// Asks for the optional type filter and order before paging
+void browseTransactions(TransactionCursor cursor) {
+    string type = StringUtils::trim(getInput("  Type (BORROW/RETURN, Enter for all): "));
+    for (char& c : type) {
+        c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+    }
+    if (!type.empty() && type != "BORROW" && type != "RETURN") {
+        printError("Unknown type; showing all transactions.");
+        type.clear();
+    }
+    
+    string order = getInput("  Oldest first? (y/n, default newest first): ");
+    if (order == "y" || order == "Y") {
+        cursor.setDirection(TransactionCursor::OLDEST_FIRST);
+    }
+    cursor.setTypeFilter(type);
+    displayTransactionPages(cursor);
+}
+
+void displayLoanTable(LibraryManager* library, const vector<const Loan*>& loans) {
+    if (loans.empty()) {
+        printInfo("No loans found.");
+        return;
+    }
+    
+    cout << endl;
+    cout << setw(8) << left << "User ID"
+         << setw(24) << left << "Copy"
+         << setw(18) << left << "Title"
+         << setw(12) << left << "Borrowed"
+         << setw(12) << left << "Due"
+         << setw(10) << left << "Status" << endl;
+    printSingleLine();
+    
+    int64_t now = TimeUtils::nowMillis();
+    for (const Loan* loan : loans) {
+        Book* book = library->searchBookByISBN(loan->isbn);
+        string title = (book != nullptr) ? book->getTitle() : "(removed)";
+        int64_t daysLeft = TimeUtils::dayOf(loan->dueAt) - TimeUtils::dayOf(now);
+        
+        cout << setw(8) << left << User::formatID(loan->userID)
+             << setw(24) << left << (loan->copyNumber != 0 
+                                     ? Book::formatBarcode(loan->isbn, loan->copyNumber) 
+                                     : loan->isbn).substr(0, 23)
+             << setw(18) << left << (title.length() > 15 ? title.substr(0, 15) + "..." : title)
+             << setw(12) << left << TimeUtils::format(loan->borrowedAt).substr(0, 10)
+             << setw(12) << left << TimeUtils::format(loan->dueAt).substr(0, 10)
+             << setw(10) << left << (loan->isOverdue(now) ? "OVERDUE" 
+                                                          : to_string(daysLeft) + "d left") << endl;
+    }
+    
+    cout << endl << "Total: " << loans.size() << " loan(s)" << endl;
+}
+
+void displayHoldTable(LibraryManager* library, const vector<HoldInfo>& holds) {
+    if (holds.empty()) {
+        printInfo("You have no holds.");
+        return;
+    }
+    
+    cout << endl;
+    cout << setw(10) << left << "Position"
+         << setw(20) << left << "ISBN"
+         << setw(30) << left << "Title"
+         << setw(12) << left << "Placed" << endl;
+    printSingleLine();
+    
+    for (const HoldInfo& hold : holds) {
+        Book* book = library->searchBookByISBN(hold.isbn);
+        string title = (book != nullptr) ? book->getTitle() : "(removed)";
+        cout << setw(10) << left << ("#" + to_string(hold.position))
+             << setw(20) << left << hold.isbn.substr(0, 19)
+             << setw(30) << left << (title.length() > 27 ? title.substr(0, 27) + "..." : title)
+             << setw(12) << left << TimeUtils::format(hold.placedAt).substr(0, 10) << endl;
+    }
+    
+    cout << endl << "Total: " << holds.size() << " hold(s)" << endl;
+}
+
+void displayRelatedBooks(LibraryManager* library, const vector<RelatedBook>& books, 
+                         const string& heading) {
+    if (books.empty()) {
+        return;
+    }
+    
+    cout << endl << "  " << heading << endl;
+    for (const RelatedBook& entry : books) {
+        Book* book = library->searchBookByISBN(entry.isbn);
+        if (book == nullptr) continue;
+        cout << "    - " << book->getTitle() << " by " << book->getAuthor() 
+             << " (" << entry.isbn << ")" << endl;
+    }
+}
+
+// Counts are estimates over the last TREND_BUCKETS * TREND_BUCKET_HOURS
+void displayTrendingTable(LibraryManager* library, const vector<TrendingBook>& books) {
+    if (books.empty()) {
+        printInfo("Nothing has been borrowed recently.");
+        return;
+    }
+    
+    cout << endl;
+    cout << setw(6) << left << "Rank"
+         << setw(20) << left << "ISBN"
+         << setw(30) << left << "Title"
+         << setw(10) << left << "Borrows"
+         << setw(10) << left << "Readers" << endl;
+    printSingleLine();
+    
+    for (size_t i = 0; i < books.size(); i++) {
+        Book* book = library->searchBookByISBN(books[i].isbn);
+        string title = (book != nullptr) ? book->getTitle() : "(removed)";
+        cout << setw(6) << left << (i + 1)
+             << setw(20) << left << books[i].isbn.substr(0, 19)
+             << setw(30) << left << (title.length() > 27 ? title.substr(0, 27) + "..." : title)
+             << setw(10) << left << ("~" + to_string(books[i].borrows))
+             << setw(10) << left << ("~" + to_string(books[i].uniqueBorrowers)) << endl;
+    }
+}
+
 // ============ LOGIN & REGISTRATION ============
 
 void displayLoginScreen() {
@@ -250,13 +485,13 @@ void displayLoginScreen() {
     printSingleLine();
 }
 
-bool handleAdminLogin(AuthManager* auth) {
+bool handleAdminLogin(AuthManager* auth, SessionContext& session) {
     printHeader("🔐 ADMIN LOGIN");
     
     string username = getInput("  Username: ");
     string password = getPasswordInput("  Password: ");
     
-    if (auth->loginAsAdmin(username, password)) {
+    if (auth->loginAsAdmin(username, password, session)) {
         printSuccess("Admin login successful!");
         printInfo("Welcome, Administrator!");
         pressEnterToContinue();
@@ -268,14 +503,14 @@ bool handleAdminLogin(AuthManager* auth) {
     }
 }
 
-bool handleUserLogin(AuthManager* auth) {
+bool handleUserLogin(AuthManager* auth, SessionContext& session) {
     printHeader("🔐 USER LOGIN");
     
     string username = getInput("  Username: ");
     string password = getPasswordInput("  Password: ");
     
-    if (auth->loginAsUser(username, password)) {
-        User* user = auth->getCurrentUser();
+    if (auth->loginAsUser(username, password, session)) {
+        User* user = auth->getSessionUser(session);
         printSuccess("Login successful!");
         printInfo("Welcome back, " + user->getFullName() + "!");
         pressEnterToContinue();
@@ -323,6 +558,12 @@ void handleUserRegistration(AuthManager* auth) {
         return;
     }
     
+    if (!auth->isEmailAvailable(email)) {
+        printError("Email already registered!");
+        pressEnterToContinue();
+        return;
+    }
+    
     string phone = getInput("  Phone Number: ");
     
     if (auth->registerUser(username, password, fullName, email, phone)) {
@@ -342,14 +583,16 @@ void displayAdminMenu() {
     cout << "  1. 📚 Book Management" << endl;
     cout << "  2. 👥 User Management" << endl;
     cout << "  3. 📋 Transaction Management" << endl;
-    cout << "  4. 📊 Reports & Statistics" << endl;
-    cout << "  5. 🔍 Search Operations" << endl;
-    cout << "  6. 💾 Save Data" << endl;
-    cout << "  7. 🚪 Logout" << endl;
+    cout << "  4. ⏳ Loans & Due Dates" << endl;
+    cout << "  5. 📊 Reports & Statistics" << endl;
+    cout << "  6. 📈 Analytics Reports" << endl;
+    cout << "  7. 🔍 Search Operations" << endl;
+    cout << "  8. 💾 Save Data" << endl;
+    cout << "  9. 🚪 Logout" << endl;
     printSingleLine();
 }
 
-void adminBookManagement(LibraryManager* library) {
+void adminBookManagement(LibraryManager* library, const SessionContext& session) {
     while (true) {
         printHeader("📚 BOOK MANAGEMENT");
         cout << "  1. Add New Book" << endl;
@@ -358,7 +601,10 @@ void adminBookManagement(LibraryManager* library) {
         cout << "  4. Update Book Quantity" << endl;
         cout << "  5. View All Books" << endl;
         cout << "  6. View Available Books" << endl;
-        cout << "  7. Back to Main Menu" << endl;
+        cout << "  7. View Copies of a Book" << endl;
+        cout << "  8. Retire a Copy" << endl;
+        cout << "  9. View Copy History" << endl;
+        cout << "  10. Back to Main Menu" << endl;
         printSingleLine();
         
         int choice = getIntInput("  Enter choice: ");
@@ -371,7 +617,7 @@ void adminBookManagement(LibraryManager* library) {
                 string author = getInput("  Author: ");
                 int quantity = getIntInput("  Quantity: ");
                 
-                library->addBook(isbn, title, author, quantity);
+                library->addBook(session, isbn, title, author, quantity);
                 pressEnterToContinue();
                 break;
             }
@@ -381,7 +627,7 @@ void adminBookManagement(LibraryManager* library) {
                 string isbn = getInput("  Enter ISBN: ");
                 
                 if (confirmAction("Are you sure you want to remove this book?")) {
-                    library->removeBook(isbn);
+                    library->removeBook(session, isbn);
                 }
                 pressEnterToContinue();
                 break;
@@ -403,7 +649,7 @@ void adminBookManagement(LibraryManager* library) {
                     if (newTitle.empty()) newTitle = book->getTitle();
                     if (newAuthor.empty()) newAuthor = book->getAuthor();
                     
-                    library->updateBookDetails(isbn, newTitle, newAuthor);
+                    library->updateBookDetails(session, isbn, newTitle, newAuthor);
                 } else {
                     printError("Book not found!");
                 }
@@ -419,7 +665,7 @@ void adminBookManagement(LibraryManager* library) {
                 if (book != nullptr) {
                     cout << endl << "Current Quantity: " << book->getQuantity() << endl;
                     int newQuantity = getIntInput("  New Quantity: ");
-                    library->updateBookQuantity(isbn, newQuantity);
+                    library->updateBookQuantity(session, isbn, newQuantity);
                 } else {
                     printError("Book not found!");
                 }
@@ -429,7 +675,7 @@ void adminBookManagement(LibraryManager* library) {
             
             case 5: {
                 printHeader("📚 ALL BOOKS");
-                vector<Book*> books = library->getAllBooks();
+                vector<Book*> books = library->getAllBooks(session);
                 displayBookTable(books);
                 pressEnterToContinue();
                 break;
@@ -443,7 +689,43 @@ void adminBookManagement(LibraryManager* library) {
                 break;
             }
             
-            case 7:
+            case 7: {
+                printHeader("🏷️  COPIES");
+                string isbn = getInput("  Enter ISBN: ");
+                Book* book = library->searchBookByISBN(isbn);
+                
+                if (book != nullptr) {
+                    displayCopyTable(book, library->getBookBorrowers(session, isbn));
+                } else {
+                    printError("Book not found!");
+                }
+                pressEnterToContinue();
+                break;
+            }
+            
+            case 8: {
+                printHeader("🗑️  RETIRE A COPY");
+                string isbn = getInput("  Enter ISBN: ");
+                int copyNumber = getIntInput("  Copy number: ");
+                
+                if (confirmAction("Retire this copy permanently?")) {
+                    library->retireCopy(session, isbn, copyNumber);
+                }
+                pressEnterToContinue();
+                break;
+            }
+            
+            case 9: {
+                printHeader("📜 COPY HISTORY");
+                string isbn = getInput("  Enter ISBN: ");
+                int copyNumber = getIntInput("  Copy number: ");
+                vector<Transaction*> history = library->getCopyHistory(session, isbn, copyNumber);
+                displayTransactionTable(history);
+                pressEnterToContinue();
+                break;
+            }
+            
+            case 10:
                 return;
             
             default:
@@ -453,7 +735,7 @@ void adminBookManagement(LibraryManager* library) {
     }
 }
 
-void adminUserManagement(LibraryManager* library) {
+void adminUserManagement(LibraryManager* library, const SessionContext& session) {
     while (true) {
         printHeader("👥 USER MANAGEMENT");
         cout << "  1. View All Users" << endl;
@@ -461,7 +743,9 @@ void adminUserManagement(LibraryManager* library) {
         cout << "  3. Deactivate User" << endl;
         cout << "  4. Activate User" << endl;
         cout << "  5. Remove User" << endl;
-        cout << "  6. Back to Main Menu" << endl;
+        cout << "  6. Find User by Email" << endl;
+        cout << "  7. Find Users by Phone" << endl;
+        cout << "  8. Back to Main Menu" << endl;
         printSingleLine();
         
         int choice = getIntInput("  Enter choice: ");
@@ -469,7 +753,7 @@ void adminUserManagement(LibraryManager* library) {
         switch (choice) {
             case 1: {
                 printHeader("👥 ALL USERS");
-                vector<User*> users = library->getAllUsers();
+                Span<const User> users = library->getAllUsers(session);
                 displayUserTable(users);
                 pressEnterToContinue();
                 break;
@@ -477,18 +761,19 @@ void adminUserManagement(LibraryManager* library) {
             
             case 2: {
                 printHeader("👤 USER DETAILS");
-                string userID = getInput("  Enter User ID: ");
-                User* user = library->getUserDetails(userID);
+                uint64_t userID = getUserIDInput("  Enter User ID: ");
+                User* user = library->getUserDetails(session, userID);
                 
                 if (user != nullptr) {
                     cout << endl << user->toString() << endl;
                     
                     cout << endl << "Borrowed Books:" << endl;
-                    set<string> borrowedISBNs = user->getBorrowedISBNs();
-                    if (borrowedISBNs.empty()) {
+                    const BorrowedBooks& loans = user->getBorrowedBooks();
+                    if (loans.empty()) {
                         cout << "  None" << endl;
                     } else {
-                        for (const string& isbn : borrowedISBNs) {
+                        for (int i = 0; i < loans.size(); i++) {
+                            string isbn = loans.isbnAt(i);
                             Book* book = library->searchBookByISBN(isbn);
                             if (book != nullptr) {
                                 cout << "  - " << book->getTitle() << " (" << isbn << ")" << endl;
@@ -504,32 +789,55 @@ void adminUserManagement(LibraryManager* library) {
             
             case 3: {
                 printHeader("🚫 DEACTIVATE USER");
-                string userID = getInput("  Enter User ID: ");
-                library->deactivateUser(userID);
+                uint64_t userID = getUserIDInput("  Enter User ID: ");
+                library->deactivateUser(session, userID);
                 pressEnterToContinue();
                 break;
             }
             
             case 4: {
                 printHeader("✅ ACTIVATE USER");
-                string userID = getInput("  Enter User ID: ");
-                library->activateUser(userID);
+                uint64_t userID = getUserIDInput("  Enter User ID: ");
+                library->activateUser(session, userID);
                 pressEnterToContinue();
                 break;
             }
             
             case 5: {
                 printHeader("❌ REMOVE USER");
-                string userID = getInput("  Enter User ID: ");
+                uint64_t userID = getUserIDInput("  Enter User ID: ");
                 
                 if (confirmAction("Are you sure you want to remove this user?")) {
-                    library->removeUser(userID);
+                    library->removeUser(session, userID);
                 }
                 pressEnterToContinue();
                 break;
             }
             
-            case 6:
+            case 6: {
+                printHeader("📧 FIND USER BY EMAIL");
+                string email = getInput("  Enter Email: ");
+                User* user = library->findUserByEmail(session, email);
+                
+                if (user != nullptr) {
+                    cout << endl << user->toString() << endl;
+                } else {
+                    printError("No user with that email!");
+                }
+                pressEnterToContinue();
+                break;
+            }
+            
+            case 7: {
+                printHeader("📞 FIND USERS BY PHONE");
+                string phone = getInput("  Enter Phone Number: ");
+                vector<User*> users = library->findUsersByPhone(session, phone);
+                displayUserTable(users);
+                pressEnterToContinue();
+                break;
+            }
+            
+            case 8:
                 return;
             
             default:
@@ -539,14 +847,16 @@ void adminUserManagement(LibraryManager* library) {
     }
 }
 
-void adminTransactionManagement(LibraryManager* library) {
+void adminTransactionManagement(LibraryManager* library, const SessionContext& session) {
     while (true) {
         printHeader("📋 TRANSACTION MANAGEMENT");
         cout << "  1. View All Transactions" << endl;
         cout << "  2. View User Transactions" << endl;
         cout << "  3. View Book Transactions" << endl;
         cout << "  4. View Recent Transactions" << endl;
-        cout << "  5. Back to Main Menu" << endl;
+        cout << "  5. View Transactions on a Date" << endl;
+        cout << "  6. View Transactions in a Month" << endl;
+        cout << "  7. Back to Main Menu" << endl;
         printSingleLine();
         
         int choice = getIntInput("  Enter choice: ");
@@ -554,17 +864,17 @@ void adminTransactionManagement(LibraryManager* library) {
         switch (choice) {
             case 1: {
                 printHeader("📋 ALL TRANSACTIONS");
-                vector<Transaction*> transactions = library->getAllTransactions();
-                displayTransactionTable(transactions);
+                browseTransactions(library->getTransactionHistory(session, 
+                                                                  TRANSACTIONS_PER_PAGE));
                 pressEnterToContinue();
                 break;
             }
             
             case 2: {
                 printHeader("👤 USER TRANSACTIONS");
-                string userID = getInput("  Enter User ID: ");
-                vector<Transaction*> transactions = library->getUserTransactions(userID);
-                displayTransactionTable(transactions);
+                uint64_t userID = getUserIDInput("  Enter User ID: ");
+                browseTransactions(library->getUserHistory(session, userID, 
+                                                           TRANSACTIONS_PER_PAGE));
                 pressEnterToContinue();
                 break;
             }
@@ -572,8 +882,8 @@ void adminTransactionManagement(LibraryManager* library) {
             case 3: {
                 printHeader("📚 BOOK TRANSACTIONS");
                 string isbn = getInput("  Enter ISBN: ");
-                vector<Transaction*> transactions = library->getBookTransactions(isbn);
-                displayTransactionTable(transactions);
+                browseTransactions(library->getBookHistory(session, isbn, 
+                                                           TRANSACTIONS_PER_PAGE));
                 pressEnterToContinue();
                 break;
             }
@@ -581,12 +891,100 @@ void adminTransactionManagement(LibraryManager* library) {
             case 4: {
                 printHeader("⏰ RECENT TRANSACTIONS");
                 int count = getIntInput("  Number of transactions to show: ");
-                vector<Transaction*> transactions = library->getRecentTransactions(count);
+                vector<Transaction*> transactions = library->getRecentTransactions(session, count);
                 displayTransactionTable(transactions);
                 pressEnterToContinue();
                 break;
             }
             
+            case 5: {
+                printHeader("📅 DAILY TRANSACTIONS");
+                int year = getIntInput("  Year: ");
+                int month = getIntInput("  Month (1-12): ");
+                int day = getIntInput("  Day: ");
+                displayTransactionTable(library->getDailyTransactions(session, year, month, day));
+                pressEnterToContinue();
+                break;
+            }
+            
+            case 6: {
+                printHeader("🗓️  MONTHLY TRANSACTIONS");
+                int year = getIntInput("  Year: ");
+                int month = getIntInput("  Month (1-12): ");
+                displayTransactionTable(library->getMonthlyTransactions(session, year, month));
+                pressEnterToContinue();
+                break;
+            }
+            
+            case 7:
+                return;
+            
+            default:
+                printError("Invalid choice!");
+                pressEnterToContinue();
+        }
+    }
+}
+
+void adminLoanManagement(LibraryManager* library, const SessionContext& session) {
+    while (true) {
+        printHeader("⏳ LOANS & DUE DATES");
+        cout << "  1. View Overdue Loans" << endl;
+        cout << "  2. View Loans Due Tomorrow" << endl;
+        cout << "  3. Who Has a Book" << endl;
+        cout << "  4. View Hold Queue for a Book" << endl;
+        cout << "  5. Back to Main Menu" << endl;
+        printSingleLine();
+        
+        int choice = getIntInput("  Enter choice: ");
+        
+        switch (choice) {
+            case 1: {
+                printHeader("⚠️  OVERDUE LOANS");
+                displayLoanTable(library, library->getOverdueLoans(session));
+                pressEnterToContinue();
+                break;
+            }
+            
+            case 2: {
+                printHeader("🔔 LOANS DUE TOMORROW");
+                displayLoanTable(library, library->getLoansDueTomorrow(session));
+                pressEnterToContinue();
+                break;
+            }
+            
+            case 3: {
+                printHeader("📖 CURRENT BORROWERS");
+                string isbn = getInput("  Enter ISBN: ");
+                displayLoanTable(library, library->getBookBorrowers(session, isbn));
+                pressEnterToContinue();
+                break;
+            }
+            
+            case 4: {
+                printHeader("⏳ HOLD QUEUE");
+                string isbn = getInput("  Enter ISBN: ");
+                vector<Hold> queue = library->getHoldQueue(session, isbn);
+                
+                if (queue.empty()) {
+                    printInfo("Nobody is waiting for this book.");
+                } else {
+                    cout << endl;
+                    cout << setw(10) << left << "Position"
+                         << setw(10) << left << "User ID"
+                         << setw(20) << left << "Placed" << endl;
+                    printSingleLine();
+                    for (size_t i = 0; i < queue.size(); i++) {
+                        cout << setw(10) << left << ("#" + to_string(i + 1))
+                             << setw(10) << left << User::formatID(queue[i].userID)
+                             << setw(20) << left << TimeUtils::format(queue[i].placedAt) << endl;
+                    }
+                    cout << endl << "Total: " << queue.size() << " hold(s)" << endl;
+                }
+                pressEnterToContinue();
+                break;
+            }
+            
             case 5:
                 return;
             
@@ -597,22 +995,165 @@ void adminTransactionManagement(LibraryManager* library) {
     }
 }
 
-void adminReportsStatistics(LibraryManager* library) {
+void adminReportsStatistics(LibraryManager* library, const SessionContext& session) {
     printHeader("📊 SYSTEM STATISTICS");
     
     cout << "  📚 Total Books: " << library->getTotalBooks() << endl;
+    cout << "  📦 Total Copies: " << library->getTotalCopies() << endl;
     cout << "  ✅ Available Copies: " << library->getTotalAvailableBooks() << endl;
+    cout << "  📤 Copies On Loan: " << library->getBorrowedCopies() << endl;
     cout << "  👥 Total Users: " << library->getTotalUsers() << endl;
     cout << "  ✓ Active Users: " << library->getActiveUsersCount() << endl;
+    cout << "  ✗ Inactive Users: " << library->getInactiveUsersCount() << endl;
     cout << "  📋 Total Transactions: " << library->getTotalTransactions() << endl;
+    cout << "  📥 Borrows Today: " << library->getBorrowsToday() << endl;
+    cout << "  🔁 Returns Today: " << library->getReturnsToday() << endl;
+    cout << "  ⚠️  Overdue Loans: " << library->getOverdueCount() << endl;
+    cout << "  ⏳ Active Holds: " << library->getTotalHolds() << endl;
     
     printSubHeader("Recent Activity");
-    vector<Transaction*> recent = library->getRecentTransactions(5);
+    vector<Transaction*> recent = library->getRecentTransactions(session, 5);
     displayTransactionTable(recent);
     
     pressEnterToContinue();
 }
 
+// Reports cover whole local days: the last `days` days up to and including today
+void adminAnalyticsReports(LibraryManager* library, const SessionContext& session) {
+    while (true) {
+        printHeader("📈 ANALYTICS REPORTS");
+        cout << "  1. Most Borrowed Books" << endl;
+        cout << "  2. Busiest Patrons" << endl;
+        cout << "  3. Borrows & Returns per Day" << endl;
+        cout << "  4. Trending Now (estimated)" << endl;
+        cout << "  5. Back to Main Menu" << endl;
+        printSingleLine();
+        
+        int choice = getIntInput("  Enter choice: ");
+        if (choice == 5) {
+            return;
+        }
+        if (choice < 1 || choice > 5) {
+            printError("Invalid choice!");
+            pressEnterToContinue();
+            continue;
+        }
+        
+        // Fixed window, kept as sketches rather than read from the columns
+        if (choice == 4) {
+            printHeader("🔥 TRENDING NOW (LAST " + 
+                        to_string(TREND_BUCKETS * TREND_BUCKET_HOURS / 24) + " DAYS)");
+            displayTrendingTable(library, library->getTrendingBooks(TREND_TOP_K));
+            cout << endl << "Borrows in window: " << library->getRecentBorrows(session) << endl;
+            cout << "Distinct borrowers: ~" << library->getRecentUniqueBorrowers(session) << endl;
+            
+            string isbn = getInput("\n  Estimate borrows for ISBN (Enter to skip): ");
+            if (!isbn.empty()) {
+                cout << "  ~" << library->getRecentBorrowEstimate(session, isbn) 
+                     << " borrow(s) (never an undercount)" << endl;
+            }
+            pressEnterToContinue();
+            continue;
+        }
+        
+        int days = getIntInput("  Period (last N days): ");
+        if (days < 1) {
+            printError("Period must be at least one day.");
+            pressEnterToContinue();
+            continue;
+        }
+        int64_t tomorrow = TimeUtils::dayOf(TimeUtils::nowMillis()) + 1;
+        int64_t fromMs = TimeUtils::startOfDay(tomorrow - days);
+        int64_t toMs = TimeUtils::startOfDay(tomorrow);
+        
+        switch (choice) {
+            case 1: {
+                int count = getIntInput("  How many books: ");
+                vector<BookCount> books = library->getTopBooks(session, fromMs, toMs, 
+                                                               count > 0 ? count : 0);
+                printHeader("📚 MOST BORROWED BOOKS");
+                if (books.empty()) {
+                    printInfo("No borrows in this period.");
+                    break;
+                }
+                
+                cout << endl;
+                cout << setw(6) << left << "Rank"
+                     << setw(20) << left << "ISBN"
+                     << setw(35) << left << "Title"
+                     << setw(10) << left << "Borrows" << endl;
+                printSingleLine();
+                for (size_t i = 0; i < books.size(); i++) {
+                    Book* book = library->searchBookByISBN(books[i].isbn);
+                    string title = (book != nullptr) ? book->getTitle() : "(removed)";
+                    cout << setw(6) << left << (i + 1)
+                         << setw(20) << left << books[i].isbn.substr(0, 19)
+                         << setw(35) << left << (title.length() > 32 ? title.substr(0, 32) + "..." 
+                                                                     : title)
+                         << setw(10) << left << books[i].count << endl;
+                }
+                break;
+            }
+            
+            case 2: {
+                int count = getIntInput("  How many patrons: ");
+                vector<UserCount> users = library->getBusiestUsers(session, fromMs, toMs, 
+                                                                   count > 0 ? count : 0);
+                printHeader("👥 BUSIEST PATRONS");
+                if (users.empty()) {
+                    printInfo("No borrows in this period.");
+                    break;
+                }
+                
+                cout << endl;
+                cout << setw(6) << left << "Rank"
+                     << setw(10) << left << "User ID"
+                     << setw(30) << left << "Name"
+                     << setw(10) << left << "Borrows" << endl;
+                printSingleLine();
+                for (size_t i = 0; i < users.size(); i++) {
+                    User* user = library->getUserDetails(session, users[i].userID);
+                    cout << setw(6) << left << (i + 1)
+                         << setw(10) << left << User::formatID(users[i].userID)
+                         << setw(30) << left << (user != nullptr ? user->getFullName() 
+                                                                 : "(removed)")
+                         << setw(10) << left << users[i].count << endl;
+                }
+                break;
+            }
+            
+            case 3: {
+                vector<DayCount> activity = library->getDailyActivity(session, fromMs, toMs);
+                printHeader("📅 BORROWS & RETURNS PER DAY");
+                if (activity.empty()) {
+                    printInfo("No activity in this period.");
+                    break;
+                }
+                
+                uint64_t busiest = 1;
+                for (const DayCount& day : activity) {
+                    busiest = max(busiest, day.borrows);
+                }
+                
+                cout << endl;
+                cout << setw(14) << left << "Date"
+                     << setw(10) << left << "Borrows"
+                     << setw(10) << left << "Returns" << "Borrows" << endl;
+                printSingleLine();
+                for (const DayCount& day : activity) {
+                    size_t bar = static_cast<size_t>(day.borrows * 30 / busiest);
+                    cout << setw(14) << left 
+                         << TimeUtils::format(TimeUtils::startOfDay(day.day)).substr(0, 10)
+                         << setw(10) << left << day.borrows
+                         << setw(10) << left << day.returns << string(bar, '#') << endl;
+                }
+                break;
+            }
+        }
+        pressEnterToContinue();
+    }
+}
+
 void adminSearchOperations(LibraryManager* library) {
     while (true) {
         printHeader("🔍 SEARCH OPERATIONS");
@@ -678,41 +1219,49 @@ void adminSearchOperations(LibraryManager* library) {
     }
 }
 
-void adminInterface(LibraryManager* library, AuthManager* auth) {
+void adminInterface(LibraryManager* library, AuthManager* auth, SessionContext& session) {
     while (true) {
         displayAdminMenu();
         int choice = getIntInput("  Enter choice: ");
         
         switch (choice) {
             case 1:
-                adminBookManagement(library);
+                adminBookManagement(library, session);
                 break;
             
             case 2:
-                adminUserManagement(library);
+                adminUserManagement(library, session);
                 break;
             
             case 3:
-                adminTransactionManagement(library);
+                adminTransactionManagement(library, session);
                 break;
             
             case 4:
-                adminReportsStatistics(library);
+                adminLoanManagement(library, session);
                 break;
             
             case 5:
-                adminSearchOperations(library);
+                adminReportsStatistics(library, session);
                 break;
             
             case 6:
+                adminAnalyticsReports(library, session);
+                break;
+            
+            case 7:
+                adminSearchOperations(library);
+                break;
+            
+            case 8:
                 printHeader("💾 SAVING DATA");
                 library->saveAllData();
                 pressEnterToContinue();
                 break;
             
-            case 7:
+            case 9:
                 printInfo("Logging out...");
-                auth->logout();
+                auth->logout(session);
                 return;
             
             default:
@@ -743,7 +1292,8 @@ void userBrowseBooks(LibraryManager* library) {
     printHeader("📚 BROWSE BOOKS");
     cout << "  1. View All Available Books" << endl;
     cout << "  2. View Book Details" << endl;
-    cout << "  3. Back to Main Menu" << endl;
+    cout << "  3. Trending Now" << endl;
+    cout << "  4. Back to Main Menu" << endl;
     printSingleLine();
     
     int choice = getIntInput("  Enter choice: ");
@@ -765,6 +1315,9 @@ void userBrowseBooks(LibraryManager* library) {
             if (book != nullptr) {
                 cout << endl;
                 displayBookDetails(book);
+                displayRelatedBooks(library, 
+                                    library->getRelatedBooks(isbn, RECOMMEND_NEIGHBOURS),
+                                    "Patrons who borrowed this also borrowed:");
             } else {
                 printError("Book not found!");
             }
@@ -772,7 +1325,14 @@ void userBrowseBooks(LibraryManager* library) {
             break;
         }
         
-        case 3:
+        case 3: {
+            printHeader("🔥 TRENDING NOW");
+            displayTrendingTable(library, library->getTrendingBooks(10));
+            pressEnterToContinue();
+            break;
+        }
+        
+        case 4:
             return;
         
         default:
@@ -844,14 +1404,18 @@ void userSearchBooks(LibraryManager* library) {
     }
 }
 
-void userMyBooks(LibraryManager* library) {
+void userMyBooks(LibraryManager* library, const SessionContext& session) {
     while (true) {
         printHeader("📖 MY BOOKS");
         cout << "  1. Borrow a Book" << endl;
         cout << "  2. Return a Book" << endl;
         cout << "  3. View My Borrowed Books" << endl;
         cout << "  4. View My Transaction History" << endl;
-        cout << "  5. Back to Main Menu" << endl;
+        cout << "  5. View My Activity for a Month" << endl;
+        cout << "  6. Place a Hold" << endl;
+        cout << "  7. View My Holds" << endl;
+        cout << "  8. Cancel a Hold" << endl;
+        cout << "  9. Back to Main Menu" << endl;
         printSingleLine();
         
         int choice = getIntInput("  Enter choice: ");
@@ -860,7 +1424,13 @@ void userMyBooks(LibraryManager* library) {
             case 1: {
                 printHeader("📥 BORROW BOOK");
                 string isbn = getInput("  Enter ISBN: ");
-                library->borrowBook(isbn);
+                if (!library->borrowBook(session, isbn)) {
+                    Book* book = library->searchBookByISBN(isbn);
+                    if (book != nullptr && !book->isAvailable() && 
+                        confirmAction("Join the hold queue for this book?")) {
+                        library->placeHold(session, isbn);
+                    }
+                }
                 pressEnterToContinue();
                 break;
             }
@@ -868,19 +1438,23 @@ void userMyBooks(LibraryManager* library) {
             case 2: {
                 printHeader("📤 RETURN BOOK");
                 string isbn = getInput("  Enter ISBN: ");
-                library->returnBook(isbn);
+                library->returnBook(session, isbn);
                 pressEnterToContinue();
                 break;
             }
             
             case 3: {
                 printHeader("📚 MY BORROWED BOOKS");
-                vector<Book*> books = library->getMyBorrowedBooks();
+                vector<const Loan*> loans = library->getMyLoans(session);
                 
-                if (books.empty()) {
+                if (loans.empty()) {
                     printInfo("You have no borrowed books.");
                 } else {
-                    displayBookTable(books);
+                    displayLoanTable(library, loans);
+                    displayRelatedBooks(library, 
+                                        library->getMyRecommendations(session, 
+                                                                      RECOMMEND_NEIGHBOURS),
+                                        "You might also like:");
                 }
                 pressEnterToContinue();
                 break;
@@ -888,13 +1462,44 @@ void userMyBooks(LibraryManager* library) {
             
             case 4: {
                 printHeader("📋 MY TRANSACTION HISTORY");
-                vector<Transaction*> transactions = library->getMyTransactions();
-                displayTransactionTable(transactions);
+                displayTransactionPages(library->getMyHistory(session, TRANSACTIONS_PER_PAGE));
                 pressEnterToContinue();
                 break;
             }
             
-            case 5:
+            case 5: {
+                printHeader("🗓️  MY MONTHLY ACTIVITY");
+                int year = getIntInput("  Year: ");
+                int month = getIntInput("  Month (1-12): ");
+                displayTransactionTable(library->getMyMonthlyTransactions(session, year, month));
+                pressEnterToContinue();
+                break;
+            }
+            
+            case 6: {
+                printHeader("⏳ PLACE A HOLD");
+                string isbn = getInput("  Enter ISBN: ");
+                library->placeHold(session, isbn);
+                pressEnterToContinue();
+                break;
+            }
+            
+            case 7: {
+                printHeader("⏳ MY HOLDS");
+                displayHoldTable(library, library->getMyHolds(session));
+                pressEnterToContinue();
+                break;
+            }
+            
+            case 8: {
+                printHeader("✖ CANCEL A HOLD");
+                string isbn = getInput("  Enter ISBN: ");
+                library->cancelHold(session, isbn);
+                pressEnterToContinue();
+                break;
+            }
+            
+            case 9:
                 return;
             
             default:
@@ -904,8 +1509,8 @@ void userMyBooks(LibraryManager* library) {
     }
 }
 
-void userMyProfile(LibraryManager* library, AuthManager* auth) {
-    User* currentUser = auth->getCurrentUser();
+void userMyProfile(AuthManager* auth, const SessionContext& session) {
+    User* currentUser = auth->getSessionUser(session);
     if (currentUser == nullptr) return;
     
     printHeader("👤 MY PROFILE");
@@ -922,20 +1527,29 @@ void userMyProfile(LibraryManager* library, AuthManager* auth) {
         string email = getInput("  New Email: ");
         string phone = getInput("  New Phone: ");
         
-        if (auth->validateEmail(email)) {currentUser->updateContact(email, phone);
+        if (!auth->validateEmail(email)) {
+            printError("Invalid email format!");
+        } else if (auth->updateContact(session, email, phone)) {
             printSuccess("Contact information updated successfully!");
         } else {
-            printError("Invalid email format!");
+            printError("Email already registered to another account!");
         }
     }
     
     pressEnterToContinue();
 }
 
-void userInterface(LibraryManager* library, AuthManager* auth) {
-    User* currentUser = auth->getCurrentUser();
-    
+void userInterface(LibraryManager* library, AuthManager* auth, SessionContext& session) {
     while (true) {
+        // Re-resolved each time: records can move, sessions can expire
+        User* currentUser = auth->getSessionUser(session);
+        if (currentUser == nullptr) {
+            printError("Session expired or account deactivated.");
+            auth->logout(session);
+            pressEnterToContinue();
+            return;
+        }
+        
         displayUserMenu(currentUser);
         int choice = getIntInput("  Enter choice: ");
         
@@ -949,11 +1563,11 @@ void userInterface(LibraryManager* library, AuthManager* auth) {
                 break;
             
             case 3:
-                userMyBooks(library);
+                userMyBooks(library, session);
                 break;
             
             case 4:
-                userMyProfile(library, auth);
+                userMyProfile(auth, session);
                 break;
             
             case 5:
@@ -964,7 +1578,7 @@ void userInterface(LibraryManager* library, AuthManager* auth) {
             
             case 6:
                 printInfo("Logging out...");
-                auth->logout();
+                auth->logout(session);
                 return;
             
             default:
@@ -975,7 +1589,21 @@ void userInterface(LibraryManager* library, AuthManager* auth) {
 }
 // ============ MAIN FUNCTION ============
 
-int main() {
+// --export-csv / --import-csv convert between the binary snapshot and
+// the CSV files the Node backend reads, then exit
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        string option = argv[1];
+        if (option == "--export-csv") {
+            return FileHandler::exportCSV() ? 0 : 1;
+        }
+        if (option == "--import-csv") {
+            return FileHandler::importCSV() ? 0 : 1;
+        }
+        cerr << "Usage: " << argv[0] << " [--export-csv | --import-csv]" << endl;
+        return 1;
+    }
+    
     // Initialize managers
     LibraryManager* library = LibraryManager::getInstance();
     AuthManager* auth = AuthManager::getInstance();
@@ -1008,27 +1636,28 @@ int main() {
     
     pressEnterToContinue();
     
-    // Main login loop
+    // Main login loop (one session at a time on the console)
+    SessionContext session;
     while (true) {
         displayLoginScreen();
         int choice = getIntInput("  Enter choice: ");
         
         switch (choice) {
             case 1: // Admin Login
-                if (handleAdminLogin(auth)) {
-                    adminInterface(library, auth);
+                if (handleAdminLogin(auth, session)) {
+                    adminInterface(library, auth, session);
                     // Auto-save after admin session
                     cout << endl << "  Auto-saving data..." << endl;
-                    library->saveAllData();
+                    library->saveAllDataInBackground();
                 }
                 break;
             
             case 2: // User Login
-                if (handleUserLogin(auth)) {
-                    userInterface(library, auth);
+                if (handleUserLogin(auth, session)) {
+                    userInterface(library, auth, session);
                     // Auto-save after user session
                     cout << endl << "  Auto-saving data..." << endl;
-                    library->saveAllData();
+                    library->saveAllDataInBackground();
                 }
                 break;
             
@@ -1036,7 +1665,7 @@ int main() {
                 handleUserRegistration(auth);
                 // Save immediately after registration
                 cout << endl << "  Saving registration data..." << endl;
-                library->saveAllData();
+                library->saveAllDataInBackground();
                 break;
             
             case 4: // Exit
@@ -1,13 +1,17 @@
 // management/AuthManager.cpp
 #include "AuthManager.h"
 #include <algorithm>
+#include <iostream>
 
 // Initialize static instance
 AuthManager* AuthManager::instance = nullptr;
 
 // ============ SINGLETON ============
 
-AuthManager::AuthManager() : userMap(nullptr), currentUser(nullptr), currentRole(NONE) {}
+AuthManager::AuthManager() : userMap(nullptr), journal(nullptr) {
+    sessions = new SessionManager();
+    authPool = new WorkerPool(AUTH_WORKER_THREADS, AUTH_MAX_QUEUED);
+}
 
 AuthManager* AuthManager::getInstance() {
     if (instance == nullptr) {
@@ -18,43 +22,109 @@ AuthManager* AuthManager::getInstance() {
 
 AuthManager::~AuthManager() {
     // Don't delete userMap (owned by LibraryManager)
-    // Don't delete currentUser (owned by userMap)
+    delete authPool;  // Drains in-flight logins first
+    delete sessions;
 }
 
 void AuthManager::setUserMap(UserHashMap* map) {
     userMap = map;
 }
 
+void AuthManager::setJournal(Journal* log) {
+    journal = log;
+}
+
+// Same contract as LibraryManager's: after the change, before success
+void AuthManager::logMutation(JournalRecord& record) {
+    if (journal != nullptr && journal->isOpen() && !journal->append(record)) {
+        cout << "Warning: Change could not be journaled; save to keep it." << endl;
+    }
+}
+
 // ============ AUTHENTICATION ============
 
-bool AuthManager::loginAsAdmin(const string& username, const string& password) {
+bool AuthManager::loginAsAdmin(const string& username, const string& password, 
+                               SessionContext& session) {
     if (username == ADMIN_USERNAME && password == ADMIN_PASSWORD) {
-        currentRole = ADMIN;
-        currentUser = nullptr;  // Admin doesn't have a User object
+        // Admin doesn't have a User object
+        session.token = sessions->create(SessionContext::ADMIN, 0);
+        session.role = SessionContext::ADMIN;
+        session.userID = 0;
         return true;
     }
     return false;
 }
 
-bool AuthManager::loginAsUser(const string& username, const string& password) {
-    if (userMap == nullptr) return false;
+bool AuthManager::loginAsUser(const string& username, const string& password, 
+                              SessionContext& session) {
+    return finishLogin(verifyLoginAsync(username, password).get(), session);
+}
+
+// Looks the user up on the calling thread, then runs the KDF on authPool.
+// The worker touches no shared state: the future yields a verdict that
+// the caller passes to finishLogin. If the pool's queue is full the
+// login is refused immediately.
+future<LoginVerdict> AuthManager::verifyLoginAsync(const string& username, 
+                                                   const string& password) {
+    shared_ptr<promise<LoginVerdict>> outcome = make_shared<promise<LoginVerdict>>();
+    future<LoginVerdict> result = outcome->get_future();
     
-    User* user = userMap->searchByUsername(username);
-    if (user == nullptr) {
-        return false;  // User not found
+    User* user = (userMap != nullptr) ? userMap->searchByUsername(username) : nullptr;
+    if (user == nullptr || !user->isActive()) {
+        outcome->set_value(LoginVerdict());  // User not found or account inactive
+        return result;
     }
     
-    if (!user->isActive()) {
-        return false;  // Account inactive
+    // Copy what the worker needs; the User record may move meanwhile
+    uint64_t userID = user->getID();
+    string storedHash = user->getPasswordHash();
+    
+    bool queued = authPool->trySubmit([outcome, userID, storedHash, password]() {
+        LoginVerdict verdict;
+        if (User::verifyPassword(storedHash, password)) {
+            verdict.userID = userID;
+            verdict.verifiedHash = storedHash;
+            
+            // Transparent upgrade of legacy or under-cost hashes
+            if (User::needsRehash(storedHash)) {
+                verdict.upgradedHash = User::hashPassword(password);
+            }
+        }
+        outcome->set_value(verdict);
+    });
+    
+    if (!queued) {
+        outcome->set_value(LoginVerdict());  // Overloaded
+    }
+    return result;
+}
+
+// Runs on the thread that owns the user map, like every other mutation
+bool AuthManager::finishLogin(const LoginVerdict& verdict, SessionContext& session) {
+    session = SessionContext();
+    if (verdict.userID == 0 || userMap == nullptr) {
+        return false;
+    }
+    
+    User* user = userMap->searchByID(verdict.userID);
+    if (user == nullptr || !user->isActive()) {
+        return false;  // Removed or deactivated while verifying
     }
     
-    if (!user->authenticate(password)) {
-        return false;  // Wrong password
+    // Only replace the hash we verified (not a password changed meanwhile)
+    if (!verdict.upgradedHash.empty() && user->getPasswordHash() == verdict.verifiedHash) {
+        user->setPasswordHash(verdict.upgradedHash);
+        
+        JournalRecord record(JournalRecord::USER_PASSWORD);
+        record.putUnsigned(verdict.userID);
+        record.putString(verdict.upgradedHash);
+        logMutation(record);
     }
     
     // Login successful
-    currentUser = user;
-    currentRole = USER;
+    session.token = sessions->create(SessionContext::USER, verdict.userID);
+    session.role = SessionContext::USER;
+    session.userID = verdict.userID;
     return true;
 }
 
@@ -76,47 +146,87 @@ bool AuthManager::registerUser(const string& username, const string& password,
         return false;  // Invalid email
     }
     
-    // Create new user
-    User* newUser = new User(username, password, fullName, email, phone);
-    userMap->insert(newUser);
+    if (!isEmailAvailable(email)) {
+        return false;  // Email already registered
+    }
+    
+    // Create new user (the map stores its own copy)
+    User* user = userMap->insert(User(username, password, fullName, email, phone));
+    if (user == nullptr) {
+        return false;
+    }
     
+    JournalRecord record(JournalRecord::USER_ADD);
+    record.putString(user->toFileString());
+    logMutation(record);
     return true;
 }
 
-void AuthManager::logout() {
-    currentUser = nullptr;
-    currentRole = NONE;
+void AuthManager::logout(SessionContext& session) {
+    sessions->revoke(session.token);
+    session = SessionContext();
 }
 
-// ============ AUTHORIZATION CHECKS ============
+// ============ PROFILE ============
 
-bool AuthManager::isAdmin() const {
-    return currentRole == ADMIN;
+bool AuthManager::updateContact(const SessionContext& session, const string& email, 
+                                const string& phone) {
+    User* currentUser = getSessionUser(session);
+    if (currentUser == nullptr) {
+        return false;
+    }
+    
+    if (!validateEmail(email)) {
+        return false;
+    }
+    
+    // Keeping one's own address is fine; taking someone else's is not
+    User* owner = userMap->searchByEmail(email);
+    if (owner != nullptr && owner != currentUser) {
+        return false;
+    }
+    
+    // Goes through the map so the email/phone indexes stay in sync
+    if (!userMap->updateContact(currentUser->getID(), email, phone)) {
+        return false;
+    }
+    
+    JournalRecord record(JournalRecord::USER_CONTACT);
+    record.putUnsigned(currentUser->getID());
+    record.putString(email);
+    record.putString(phone);
+    logMutation(record);
+    return true;
 }
 
-bool AuthManager::isUser() const {
-    return currentRole == USER;
-}
+// ============ AUTHORIZATION CHECKS ============
 
-bool AuthManager::isLoggedIn() const {
-    return currentRole != NONE;
+bool AuthManager::validateSession(const string& token, SessionContext& session) {
+    return sessions->validate(token, session);
 }
 
-User* AuthManager::getCurrentUser() const {
-    return currentUser;
+bool AuthManager::isAdmin(const SessionContext& session) {
+    SessionContext verified;
+    return sessions->validate(session.token, verified) && verified.isAdmin();
 }
 
-string AuthManager::getCurrentUserID() const {
-    if (currentRole == ADMIN) {
-        return ADMIN_ID;
-    } else if (currentRole == USER && currentUser != nullptr) {
-        return currentUser->getUserID();
+// Resolved on every call so deactivation or removal takes effect at once
+User* AuthManager::getSessionUser(const SessionContext& session) {
+    SessionContext verified;
+    if (userMap == nullptr || !sessions->validate(session.token, verified) || 
+        !verified.isUser()) {
+        return nullptr;
     }
-    return "";
+    
+    User* user = userMap->searchByID(verified.userID);
+    if (user == nullptr || !user->isActive()) {
+        return nullptr;
+    }
+    return user;
 }
 
-AuthManager::Role AuthManager::getCurrentRole() const {
-    return currentRole;
+size_t AuthManager::getActiveSessionCount() const {
+    return sessions->getActiveCount();
 }
 
 // ============ VALIDATION ============
@@ -132,6 +242,11 @@ bool AuthManager::isUsernameAvailable(const string& username) const {
     return !userMap->existsUsername(username);
 }
 
+bool AuthManager::isEmailAvailable(const string& email) const {
+    if (userMap == nullptr) return false;
+    return !userMap->existsEmail(email);
+}
+
 bool AuthManager::validatePassword(const string& password) const {
     return password.length() >= MIN_PASSWORD_LENGTH;
 }
@@ -5,49 +5,72 @@
 #include "../entities/User.h"
 #include "../Config.h"
 #include "UserHashMap.h"
+#include "SessionManager.h"
+#include "../utils/WorkerPool.h"
+#include "../utils/Journal.h"
 #include <string>
+#include <future>
 using namespace std;
 
-class AuthManager {
-public:
-    enum Role {
-        NONE,
-        ADMIN,
-        USER
-    };
+// What a password check on authPool found. The worker only reads copies
+// made before it started; finishLogin applies the verdict to the user
+// map, the journal and the sessions on the caller's thread.
+struct LoginVerdict {
+    uint64_t userID;          // 0 = refused (unknown, wrong password, overloaded)
+    string verifiedHash;      // The stored hash the password matched
+    string upgradedHash;      // Replacement for a legacy or under-cost hash
+    
+    LoginVerdict() : userID(0) {}
+};
 
+// Logins hand back a SessionContext; callers keep it and pass it to
+// LibraryManager, so any number of users can be logged in at once.
+class AuthManager {
 private:
     static AuthManager* instance;
     UserHashMap* userMap;
-    User* currentUser;
-    Role currentRole;
+    SessionManager* sessions;
+    Journal* journal;    // Owned by LibraryManager; nullptr = not journaled
+    
+    // Password verification runs here, off the caller's thread
+    WorkerPool* authPool;
     
     // Private constructor (Singleton)
     AuthManager();
+    
+    void logMutation(JournalRecord& record);
 
 public:
     static AuthManager* getInstance();
     ~AuthManager();
     
     void setUserMap(UserHashMap* map);
+    void setJournal(Journal* log);
     
     // Authentication
-    bool loginAsAdmin(const string& username, const string& password);
-    bool loginAsUser(const string& username, const string& password);
+    bool loginAsAdmin(const string& username, const string& password, 
+                      SessionContext& session);
+    bool loginAsUser(const string& username, const string& password, 
+                     SessionContext& session);
+    future<LoginVerdict> verifyLoginAsync(const string& username, const string& password);
+    bool finishLogin(const LoginVerdict& verdict, SessionContext& session);
     bool registerUser(const string& username, const string& password, 
                      const string& fullName, const string& email, const string& phone);
-    void logout();
+    void logout(SessionContext& session);
+    
+    // Profile
+    bool updateContact(const SessionContext& session, const string& email, 
+                       const string& phone);
     
-    // Authorization checks
-    bool isAdmin() const;
-    bool isUser() const;
-    bool isLoggedIn() const;
-    User* getCurrentUser() const;
-    string getCurrentUserID() const;
-    Role getCurrentRole() const;
+    // Authorization checks (token looked up, no password work)
+    bool validateSession(const string& token, SessionContext& session);
+    bool isAdmin(const SessionContext& session);
+    User* getSessionUser(const SessionContext& session);   // Active users only
+    size_t getActiveSessionCount() const;
     
     // Validation
     bool isUsernameAvailable(const string& username) const;
+    bool isEmailAvailable(const string& email) const;
     bool validatePassword(const string& password) const;
     bool validateEmail(const string& email) const;
 };
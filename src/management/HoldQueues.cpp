@@ -0,0 +1,216 @@
+// management/HoldQueues.cpp
+#include "HoldQueues.h"
+#include "../entities/User.h"
+#include "../utils/TimeUtils.h"
+
+// ============ HELPERS ============
+
+int HoldQueues::findTicket(uint64_t userID, const string& isbn) const {
+    auto it = userTickets.find(userID);
+    if (it == userTickets.end()) {
+        return -1;
+    }
+    for (size_t i = 0; i < it->second.size(); i++) {
+        if (it->second[i].isbn == isbn) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void HoldQueues::forgetTicket(uint64_t userID, const string& isbn) {
+    auto it = userTickets.find(userID);
+    if (it == userTickets.end()) {
+        return;
+    }
+    
+    vector<Ticket>& tickets = it->second;
+    for (size_t i = 0; i < tickets.size(); i++) {
+        if (tickets[i].isbn == isbn) {
+            tickets.erase(tickets.begin() + i);   // Keeps placement order
+            break;
+        }
+    }
+    if (tickets.empty()) {
+        userTickets.erase(it);
+    }
+}
+
+void HoldQueues::cancelEntry(Queue& queue, uint64_t ticket) {
+    queue.entries[ticket - queue.firstTicket].userID = 0;
+    queue.cancelled.insert(lower_bound(queue.cancelled.begin(), queue.cancelled.end(), ticket), 
+                           ticket);
+}
+
+// Drops cancelled entries from the front; an emptied queue is erased
+void HoldQueues::trimFront(const string& isbn, Queue& queue) {
+    while (!queue.entries.empty() && queue.entries.front().userID == 0) {
+        queue.entries.pop_front();
+        queue.cancelled.erase(queue.cancelled.begin());   // Always the smallest
+        queue.firstTicket++;
+    }
+    if (queue.entries.empty()) {
+        queues.erase(isbn);
+    }
+}
+
+size_t HoldQueues::position(const Queue& queue, uint64_t ticket) {
+    size_t ahead = static_cast<size_t>(ticket - queue.firstTicket);
+    if (!queue.cancelled.empty()) {
+        ahead -= lower_bound(queue.cancelled.begin(), queue.cancelled.end(), ticket) 
+                 - queue.cancelled.begin();
+    }
+    return ahead + 1;
+}
+
+// ============ MAIN OPERATIONS ============
+
+bool HoldQueues::place(uint64_t userID, const string& isbn, int64_t placedAt) {
+    if (userID == 0 || findTicket(userID, isbn) >= 0) {
+        return false;  // Already waiting for this book
+    }
+    
+    Queue& queue = queues[isbn];
+    uint64_t ticket = queue.firstTicket + queue.entries.size();
+    queue.entries.push_back(Hold(userID, placedAt));
+    userTickets[userID].push_back(Ticket{isbn, ticket});
+    activeCount++;
+    return true;
+}
+
+bool HoldQueues::cancel(uint64_t userID, const string& isbn) {
+    int index = findTicket(userID, isbn);
+    if (index < 0) {
+        return false;
+    }
+    
+    uint64_t ticket = userTickets[userID][index].ticket;
+    Queue& queue = queues[isbn];
+    forgetTicket(userID, isbn);
+    cancelEntry(queue, ticket);
+    trimFront(isbn, queue);
+    activeCount--;
+    return true;
+}
+
+void HoldQueues::removeUser(uint64_t userID) {
+    auto it = userTickets.find(userID);
+    if (it == userTickets.end()) {
+        return;
+    }
+    
+    vector<Ticket> tickets = it->second;
+    for (const Ticket& ticket : tickets) {
+        cancel(userID, ticket.isbn);
+    }
+}
+
+void HoldQueues::removeBook(const string& isbn) {
+    auto it = queues.find(isbn);
+    if (it == queues.end()) {
+        return;
+    }
+    
+    for (const Hold& hold : it->second.entries) {
+        if (hold.userID != 0) {
+            forgetTicket(hold.userID, isbn);
+            activeCount--;
+        }
+    }
+    queues.erase(it);
+}
+
+// ============ QUERIES ============
+
+size_t HoldQueues::getPosition(uint64_t userID, const string& isbn) const {
+    int index = findTicket(userID, isbn);
+    if (index < 0) {
+        return 0;
+    }
+    return position(queues.at(isbn), userTickets.at(userID)[index].ticket);
+}
+
+size_t HoldQueues::getQueueLength(const string& isbn) const {
+    auto it = queues.find(isbn);
+    if (it == queues.end()) {
+        return 0;
+    }
+    return it->second.entries.size() - it->second.cancelled.size();
+}
+
+int HoldQueues::getHoldCount(uint64_t userID) const {
+    auto it = userTickets.find(userID);
+    return (it != userTickets.end()) ? static_cast<int>(it->second.size()) : 0;
+}
+
+vector<HoldInfo> HoldQueues::getHoldsOf(uint64_t userID) const {
+    vector<HoldInfo> result;
+    auto it = userTickets.find(userID);
+    if (it == userTickets.end()) {
+        return result;
+    }
+    
+    for (const Ticket& ticket : it->second) {
+        const Queue& queue = queues.at(ticket.isbn);
+        HoldInfo info;
+        info.isbn = ticket.isbn;
+        info.position = position(queue, ticket.ticket);
+        info.placedAt = queue.entries[ticket.ticket - queue.firstTicket].placedAt;
+        result.push_back(info);
+    }
+    return result;
+}
+
+vector<Hold> HoldQueues::getQueue(const string& isbn) const {
+    vector<Hold> result;
+    auto it = queues.find(isbn);
+    if (it == queues.end()) {
+        return result;
+    }
+    
+    result.reserve(getQueueLength(isbn));
+    for (const Hold& hold : it->second.entries) {
+        if (hold.userID != 0) {
+            result.push_back(hold);
+        }
+    }
+    return result;
+}
+
+// ============ UTILITY ============
+
+size_t HoldQueues::size() const {
+    return activeCount;
+}
+
+vector<pair<string, Hold>> HoldQueues::getAll() const {
+    vector<pair<string, Hold>> holds;
+    holds.reserve(activeCount);
+    for (const auto& entry : queues) {
+        for (const Hold& hold : entry.second.entries) {
+            if (hold.userID != 0) {
+                holds.emplace_back(entry.first, hold);
+            }
+        }
+    }
+    return holds;
+}
+
+vector<string> HoldQueues::toFileLines() const {
+    vector<string> lines;
+    lines.reserve(activeCount);
+    for (const auto& entry : getAll()) {
+        lines.push_back(toFileLine(entry.first, entry.second));
+    }
+    return lines;
+}
+
+string HoldQueues::toFileLine(const string& isbn, const Hold& hold) {
+    return isbn + "," + User::formatID(hold.userID) + "," + TimeUtils::formatUTC(hold.placedAt);
+}
+
+void HoldQueues::clear() {
+    queues.clear();
+    userTickets.clear();
+    activeCount = 0;
+}
@@ -0,0 +1,120 @@
+// management/HoldQueues.h
+#ifndef HOLDQUEUES_H
+#define HOLDQUEUES_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+using namespace std;
+
+// One patron waiting for a book
+struct Hold {
+    uint64_t userID;      // 0 = cancelled (left in place until it reaches the front)
+    int64_t placedAt;     // Epoch ms (UTC)
+    
+    Hold() : userID(0), placedAt(0) {}
+    Hold(uint64_t userID, int64_t placedAt) : userID(userID), placedAt(placedAt) {}
+};
+
+// A hold as seen by its owner
+struct HoldInfo {
+    string isbn;
+    size_t position;      // 1 = next in line
+    int64_t placedAt;
+};
+
+// Per-book FIFO hold queues. Every hold gets a ticket number from its
+// book's counter; the queue is a deque of 16-byte entries starting at
+// firstTicket, so a patron's position is their ticket minus the head
+// ticket, less any cancelled tickets still in between (kept sorted; none
+// in the common case). Placing, position lookups and handing the head a
+// returned copy are O(1).
+//
+// A patron holds at most MAX_HOLDS_PER_USER books, so the per-user list
+// that maps (user, book) to a ticket is a short scan.
+class HoldQueues {
+private:
+    struct Queue {
+        deque<Hold> entries;         // entries[i] has ticket firstTicket + i
+        uint64_t firstTicket;
+        vector<uint64_t> cancelled;  // Sorted tickets of cancelled entries
+        
+        Queue() : firstTicket(0) {}
+    };
+    
+    struct Ticket {
+        string isbn;
+        uint64_t ticket;
+    };
+    
+    unordered_map<string, Queue> queues;
+    unordered_map<uint64_t, vector<Ticket>> userTickets;
+    size_t activeCount;
+    
+    int findTicket(uint64_t userID, const string& isbn) const;   // Index or -1
+    void forgetTicket(uint64_t userID, const string& isbn);
+    void cancelEntry(Queue& queue, uint64_t ticket);
+    void trimFront(const string& isbn, Queue& queue);
+    static size_t position(const Queue& queue, uint64_t ticket);
+    
+public:
+    HoldQueues() : activeCount(0) {}
+    
+    HoldQueues(const HoldQueues&) = delete;
+    HoldQueues& operator=(const HoldQueues&) = delete;
+    
+    // Main operations
+    bool place(uint64_t userID, const string& isbn, int64_t placedAt);   // Joins the back
+    bool cancel(uint64_t userID, const string& isbn);
+    void removeUser(uint64_t userID);
+    void removeBook(const string& isbn);
+    
+    // Removes and returns the first holder accepted by eligible(userID),
+    // or 0. Holders passed over keep their place.
+    template <typename Eligible>
+    uint64_t takeNext(const string& isbn, Eligible eligible);
+    
+    // Queries
+    size_t getPosition(uint64_t userID, const string& isbn) const;   // 0 if none
+    size_t getQueueLength(const string& isbn) const;
+    int getHoldCount(uint64_t userID) const;
+    vector<HoldInfo> getHoldsOf(uint64_t userID) const;
+    vector<Hold> getQueue(const string& isbn) const;                  // Front first
+    
+    // Utility
+    size_t size() const;
+    void clear();
+    vector<pair<string, Hold>> getAll() const;   // (ISBN, hold), queue order
+    vector<string> toFileLines() const;          // "ISBN,UserID,PlacedAt", queue order
+    static string toFileLine(const string& isbn, const Hold& hold);
+};
+
+// ============ TEMPLATE IMPLEMENTATION ============
+
+template <typename Eligible>
+uint64_t HoldQueues::takeNext(const string& isbn, Eligible eligible) {
+    auto it = queues.find(isbn);
+    if (it == queues.end()) {
+        return 0;
+    }
+    
+    Queue& queue = it->second;
+    for (size_t i = 0; i < queue.entries.size(); i++) {
+        uint64_t userID = queue.entries[i].userID;
+        if (userID == 0 || !eligible(userID)) {
+            continue;  // Cancelled, or cannot take a copy right now
+        }
+        
+        forgetTicket(userID, isbn);
+        cancelEntry(queue, queue.firstTicket + i);
+        trimFront(isbn, queue);   // May erase the queue
+        activeCount--;
+        return userID;
+    }
+    return 0;
+}
+
+#endif // HOLDQUEUES_H
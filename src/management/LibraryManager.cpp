@@ -1,8 +1,17 @@
 // management/LibraryManager.cpp
 #include "LibraryManager.h"
 #include "../utils/FileHandler.h"
+#include "../utils/TimeUtils.h"
 #include <iostream>
 #include <algorithm>
+#include <unordered_set>
+#include <unordered_map>
+
+#ifdef __linux__
+    #include <sys/resource.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
 
 // Initialize static instance
 LibraryManager* LibraryManager::instance = nullptr;
@@ -13,7 +22,17 @@ LibraryManager::LibraryManager() {
     bookTree = new BookBST();
     userMap = new UserHashMap();
     transactionList = new TransactionList();
+    loanTable = new LoanTable();
+    holdQueues = new HoldQueues();
+    analytics = new TransactionAnalytics();
+    trends = new TrendingSketch();
+    recommender = new Recommender();
     searchEngine = new SearchEngine();
+    saving = false;
+    journal = new Journal(JOURNAL_MODE, 
+                          JOURNAL_MODE == JOURNAL_ASYNC ? JOURNAL_ASYNC_WINDOW_US 
+                                                        : JOURNAL_GROUP_WINDOW_US, 
+                          JOURNAL_BATCH_BYTES);
     authManager = nullptr;
     
     // Link search engine to book tree
@@ -28,23 +47,33 @@ LibraryManager* LibraryManager::getInstance() {
 }
 
 LibraryManager::~LibraryManager() {
+    waitForBackgroundSave();   // It reads the transaction log
     delete bookTree;
     delete userMap;
     delete transactionList;
+    delete loanTable;
+    delete holdQueues;
+    delete analytics;
+    delete trends;
+    delete recommender;
     delete searchEngine;
+    delete journal;
     // Don't delete authManager (owned externally)
 }
 
 void LibraryManager::setAuthManager(AuthManager* auth) {
     authManager = auth;
+    if (authManager != nullptr) {
+        authManager->setJournal(journal);   // Registrations and profile edits
+    }
 }
 
 // ============ ADMIN OPERATIONS - BOOK MANAGEMENT ============
 
-bool LibraryManager::addBook(const string& isbn, const string& title, 
-                             const string& author, int quantity) {
+bool LibraryManager::addBook(const SessionContext& session, const string& isbn, 
+                             const string& title, const string& author, int quantity) {
     // Check admin privileges
-    if (authManager == nullptr || !authManager->isAdmin()) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
         cout << "Access Denied: Admin privileges required." << endl;
         return false;
     }
@@ -75,12 +104,22 @@ bool LibraryManager::addBookInternal(const string& isbn, const string& title,
     // Update search indices
     searchEngine->addBookToIndex(newBook);
     
+    stats.totalCopies += quantity;
+    stats.availableCopies += quantity;
+    
+    JournalRecord record(JournalRecord::BOOK_ADD);
+    record.putString(isbn);
+    record.putString(title);
+    record.putString(author);
+    record.putSigned(quantity);
+    logMutation(record);
+    
     cout << "Success: Book added successfully." << endl;
     return true;
 }
 
-bool LibraryManager::removeBook(const string& isbn) {
-    if (authManager == nullptr || !authManager->isAdmin()) {
+bool LibraryManager::removeBook(const SessionContext& session, const string& isbn) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
         cout << "Access Denied: Admin privileges required." << endl;
         return false;
     }
@@ -102,8 +141,18 @@ bool LibraryManager::removeBook(const string& isbn) {
     // Remove from indices first
     searchEngine->removeBookFromIndex(isbn);
     
+    // No copies are out, so quantity == available copies
+    int copies = book->getQuantity();
+    
     // Remove from tree
     if (bookTree->remove(isbn)) {
+        holdQueues->removeBook(isbn);
+        stats.totalCopies -= copies;
+        stats.availableCopies -= copies;
+        
+        JournalRecord record(JournalRecord::BOOK_REMOVE);
+        record.putString(isbn);
+        logMutation(record);
         cout << "Success: Book removed successfully." << endl;
         return true;
     }
@@ -111,9 +160,9 @@ bool LibraryManager::removeBook(const string& isbn) {
     return false;
 }
 
-bool LibraryManager::updateBookDetails(const string& isbn, const string& newTitle, 
-                                       const string& newAuthor) {
-    if (authManager == nullptr || !authManager->isAdmin()) {
+bool LibraryManager::updateBookDetails(const SessionContext& session, const string& isbn, 
+                                       const string& newTitle, const string& newAuthor) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
         cout << "Access Denied: Admin privileges required." << endl;
         return false;
     }
@@ -124,9 +173,10 @@ bool LibraryManager::updateBookDetails(const string& isbn, const string& newTitl
         return false;
     }
     
-    // Update book details
-    Book updatedBook(isbn, newTitle, newAuthor, book->getQuantity());
-    updatedBook.setAvailableCopies(book->getAvailableCopies());
+    // Update book details (copies and their states carry over)
+    Book updatedBook = *book;
+    updatedBook.setTitle(newTitle);
+    updatedBook.setAuthor(newAuthor);
     
     // Remove old indices
     searchEngine->removeBookFromIndex(isbn);
@@ -137,12 +187,18 @@ bool LibraryManager::updateBookDetails(const string& isbn, const string& newTitl
     // Add new indices
     searchEngine->addBookToIndex(updatedBook);
     
+    JournalRecord record(JournalRecord::BOOK_DETAILS);
+    record.putString(isbn);
+    record.putString(newTitle);
+    record.putString(newAuthor);
+    logMutation(record);
+    
     cout << "Success: Book details updated." << endl;
     return true;
 }
 
-bool LibraryManager::updateBookQuantity(const string& isbn, int newQuantity) {
-    if (authManager == nullptr || !authManager->isAdmin()) {
+bool LibraryManager::updateBookQuantity(const SessionContext& session, const string& isbn, int newQuantity) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
         cout << "Access Denied: Admin privileges required." << endl;
         return false;
     }
@@ -162,15 +218,76 @@ bool LibraryManager::updateBookQuantity(const string& isbn, int newQuantity) {
     }
     
     int difference = newQuantity - book->getQuantity();
-    book->setQuantity(newQuantity);
-    book->setAvailableCopies(book->getAvailableCopies() + difference);
+    book->setQuantity(newQuantity);   // New copy numbers, or retires shelf copies
+    
+    stats.totalCopies += difference;
+    stats.availableCopies += difference;
+    
+    JournalRecord record(JournalRecord::BOOK_QUANTITY);
+    record.putString(isbn);
+    record.putSigned(newQuantity);
+    logMutation(record);   // Hold hand-offs below log their own BORROWs
     
     cout << "Success: Book quantity updated." << endl;
+    if (difference > 0) {
+        serveHolds(book);
+    }
     return true;
 }
 
-vector<Book*> LibraryManager::getAllBooks() {
-    if (authManager == nullptr || !authManager->isAdmin()) {
+bool LibraryManager::retireCopy(const SessionContext& session, const string& isbn, 
+                                int copyNumber) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
+        cout << "Access Denied: Admin privileges required." << endl;
+        return false;
+    }
+    
+    Book* book = bookTree->search(isbn);
+    if (book == nullptr) {
+        cout << "Error: Book not found." << endl;
+        return false;
+    }
+    
+    if (book->getCopyStatus(copyNumber) == Book::ON_LOAN) {
+        cout << "Error: Copy " << book->getBarcode(copyNumber) 
+             << " is on loan; retire it after it is returned." << endl;
+        return false;
+    }
+    
+    if (!book->retireCopy(copyNumber)) {
+        cout << "Error: No such copy in service." << endl;
+        return false;
+    }
+    
+    stats.totalCopies--;
+    stats.availableCopies--;
+    
+    JournalRecord record(JournalRecord::COPY_RETIRE);
+    record.putString(isbn);
+    record.putSigned(copyNumber);
+    logMutation(record);
+    cout << "Success: Copy " << book->getBarcode(copyNumber) << " retired." << endl;
+    return true;
+}
+
+// Filters the book's history, so O(that book's transactions)
+vector<Transaction*> LibraryManager::getCopyHistory(const SessionContext& session, 
+                                                    const string& isbn, int copyNumber) {
+    vector<Transaction*> result;
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
+        return result;
+    }
+    
+    for (Transaction* trans : transactionList->getByISBN(isbn)) {
+        if (trans->getCopyNumber() == copyNumber) {
+            result.push_back(trans);
+        }
+    }
+    return result;
+}
+
+vector<Book*> LibraryManager::getAllBooks(const SessionContext& session) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
         return vector<Book*>();
     }
     return bookTree->getAllBooksSorted();
@@ -182,15 +299,15 @@ vector<Book*> LibraryManager::getAvailableBooks() {
 
 // ============ ADMIN OPERATIONS - USER MANAGEMENT ============
 
-vector<User*> LibraryManager::getAllUsers() {
-    if (authManager == nullptr || !authManager->isAdmin()) {
-        return vector<User*>();
+Span<const User> LibraryManager::getAllUsers(const SessionContext& session) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
+        return Span<const User>();
     }
     return userMap->getAllUsers();
 }
 
-bool LibraryManager::removeUser(const string& userID) {
-    if (authManager == nullptr || !authManager->isAdmin()) {
+bool LibraryManager::removeUser(const SessionContext& session, uint64_t userID) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
         cout << "Access Denied: Admin privileges required." << endl;
         return false;
     }
@@ -209,6 +326,11 @@ bool LibraryManager::removeUser(const string& userID) {
     }
     
     if (userMap->remove(userID)) {
+        holdQueues->removeUser(userID);
+        
+        JournalRecord record(JournalRecord::USER_REMOVE);
+        record.putUnsigned(userID);
+        logMutation(record);
         cout << "Success: User removed successfully." << endl;
         return true;
     }
@@ -216,8 +338,8 @@ bool LibraryManager::removeUser(const string& userID) {
     return false;
 }
 
-bool LibraryManager::deactivateUser(const string& userID) {
-    if (authManager == nullptr || !authManager->isAdmin()) {
+bool LibraryManager::deactivateUser(const SessionContext& session, uint64_t userID) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
         cout << "Access Denied: Admin privileges required." << endl;
         return false;
     }
@@ -228,13 +350,18 @@ bool LibraryManager::deactivateUser(const string& userID) {
         return false;
     }
     
-    user->setActive(false);
+    userMap->setActive(userID, false);
+    
+    JournalRecord record(JournalRecord::USER_ACTIVE);
+    record.putUnsigned(userID);
+    record.putUnsigned(0);
+    logMutation(record);
     cout << "Success: User account deactivated." << endl;
     return true;
 }
 
-bool LibraryManager::activateUser(const string& userID) {
-    if (authManager == nullptr || !authManager->isAdmin()) {
+bool LibraryManager::activateUser(const SessionContext& session, uint64_t userID) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
         cout << "Access Denied: Admin privileges required." << endl;
         return false;
     }
@@ -245,48 +372,171 @@ bool LibraryManager::activateUser(const string& userID) {
         return false;
     }
     
-    user->setActive(true);
+    userMap->setActive(userID, true);
+    
+    JournalRecord record(JournalRecord::USER_ACTIVE);
+    record.putUnsigned(userID);
+    record.putUnsigned(1);
+    logMutation(record);
     cout << "Success: User account activated." << endl;
     return true;
 }
 
-User* LibraryManager::getUserDetails(const string& userID) {
-    if (authManager == nullptr || !authManager->isAdmin()) {
+User* LibraryManager::getUserDetails(const SessionContext& session, uint64_t userID) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
         return nullptr;
     }
     return userMap->searchByID(userID);
 }
 
+User* LibraryManager::findUserByEmail(const SessionContext& session, const string& email) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
+        return nullptr;
+    }
+    return userMap->searchByEmail(email);
+}
+
+vector<User*> LibraryManager::findUsersByPhone(const SessionContext& session, const string& phone) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
+        return vector<User*>();
+    }
+    return userMap->searchByPhone(phone);
+}
+
 // ============ ADMIN OPERATIONS - TRANSACTIONS ============
 
-vector<Transaction*> LibraryManager::getAllTransactions() {
-    if (authManager == nullptr || !authManager->isAdmin()) {
+vector<Transaction*> LibraryManager::getAllTransactions(const SessionContext& session) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
         return vector<Transaction*>();
     }
     return transactionList->getAll();
 }
 
-vector<Transaction*> LibraryManager::getUserTransactions(const string& userID) {
-    if (authManager == nullptr || !authManager->isAdmin()) {
-        return vector<Transaction*>();
+TransactionCursor LibraryManager::getTransactionHistory(const SessionContext& session, 
+                                                        size_t pageSize) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
+        return TransactionCursor();
+    }
+    return TransactionCursor::forAll(transactionList, pageSize);
+}
+
+Span<Transaction* const> LibraryManager::getUserTransactions(const SessionContext& session, 
+                                                             uint64_t userID) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
+        return Span<Transaction* const>();
     }
     return transactionList->getByUserID(userID);
 }
 
-vector<Transaction*> LibraryManager::getBookTransactions(const string& isbn) {
-    if (authManager == nullptr || !authManager->isAdmin()) {
-        return vector<Transaction*>();
+Span<Transaction* const> LibraryManager::getBookTransactions(const SessionContext& session, 
+                                                             const string& isbn) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
+        return Span<Transaction* const>();
     }
     return transactionList->getByISBN(isbn);
 }
 
-vector<Transaction*> LibraryManager::getRecentTransactions(int count) {
-    if (authManager == nullptr || !authManager->isAdmin()) {
+TransactionCursor LibraryManager::getUserHistory(const SessionContext& session, uint64_t userID, 
+                                                 size_t pageSize) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
+        return TransactionCursor();
+    }
+    return TransactionCursor::forUser(transactionList, userID, pageSize);
+}
+
+TransactionCursor LibraryManager::getBookHistory(const SessionContext& session, const string& isbn, 
+                                                 size_t pageSize) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
+        return TransactionCursor();
+    }
+    return TransactionCursor::forBook(transactionList, isbn, pageSize);
+}
+
+vector<Transaction*> LibraryManager::getRecentTransactions(const SessionContext& session, int count) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
         return vector<Transaction*>();
     }
     return transactionList->getRecent(count);
 }
 
+TransactionList::Range LibraryManager::getTransactionsBetween(const SessionContext& session, 
+                                                              int64_t fromMs, int64_t toMs) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
+        return TransactionList::Range();
+    }
+    return transactionList->getBetween(fromMs, toMs);
+}
+
+TransactionList::Range LibraryManager::getDailyTransactions(const SessionContext& session, 
+                                                            int year, int month, int day) {
+    int64_t fromMs;
+    if (!TimeUtils::fromDate(year, month, day, fromMs)) {
+        return TransactionList::Range();
+    }
+    return getTransactionsBetween(session, fromMs, 
+                                  TimeUtils::startOfDay(TimeUtils::dayOf(fromMs) + 1));
+}
+
+TransactionList::Range LibraryManager::getMonthlyTransactions(const SessionContext& session, 
+                                                              int year, int month) {
+    int64_t fromMs, toMs;
+    if (!TimeUtils::monthWindow(year, month, fromMs, toMs)) {
+        return TransactionList::Range();
+    }
+    return getTransactionsBetween(session, fromMs, toMs);
+}
+
+TransactionList::Range LibraryManager::getUserTransactionsBetween(const SessionContext& session, 
+                                                                  uint64_t userID, 
+                                                                  int64_t fromMs, int64_t toMs) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
+        return TransactionList::Range();
+    }
+    return transactionList->getByUserIDBetween(userID, fromMs, toMs);
+}
+
+TransactionList::Range LibraryManager::getBookTransactionsBetween(const SessionContext& session, 
+                                                                  const string& isbn, 
+                                                                  int64_t fromMs, int64_t toMs) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
+        return TransactionList::Range();
+    }
+    return transactionList->getByISBNBetween(isbn, fromMs, toMs);
+}
+
+// ============ ADMIN OPERATIONS - LOANS ============
+
+vector<const Loan*> LibraryManager::getOverdueLoans(const SessionContext& session) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
+        return vector<const Loan*>();
+    }
+    return loanTable->getOverdue(TimeUtils::nowMillis());
+}
+
+vector<const Loan*> LibraryManager::getLoansDueTomorrow(const SessionContext& session) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
+        return vector<const Loan*>();
+    }
+    int64_t tomorrow = TimeUtils::dayOf(TimeUtils::nowMillis()) + 1;
+    return loanTable->getDueBetween(TimeUtils::startOfDay(tomorrow), 
+                                    TimeUtils::startOfDay(tomorrow + 1));
+}
+
+vector<const Loan*> LibraryManager::getBookBorrowers(const SessionContext& session, 
+                                                     const string& isbn) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
+        return vector<const Loan*>();
+    }
+    return loanTable->getByBook(isbn);
+}
+
+vector<Hold> LibraryManager::getHoldQueue(const SessionContext& session, const string& isbn) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
+        return vector<Hold>();
+    }
+    return holdQueues->getQueue(isbn);
+}
+
 // ============ ADMIN OPERATIONS - STATISTICS ============
 
 int LibraryManager::getTotalBooks() {
@@ -294,12 +544,84 @@ int LibraryManager::getTotalBooks() {
 }
 
 int LibraryManager::getTotalAvailableBooks() {
-    vector<Book*> books = bookTree->getAllBooksSorted();
-    int availableCount = 0;
-    for (Book* book : books) {
-        availableCount += book->getAvailableCopies();
+    return stats.availableCopies;
+}
+
+int LibraryManager::getTotalCopies() {
+    return stats.totalCopies;
+}
+
+int LibraryManager::getBorrowedCopies() {
+    return stats.totalCopies - stats.availableCopies;
+}
+
+int LibraryManager::getBorrowsToday() {
+    rollStatsDay();
+    return stats.borrowsToday;
+}
+
+int LibraryManager::getReturnsToday() {
+    rollStatsDay();
+    return stats.returnsToday;
+}
+
+int LibraryManager::getOverdueCount() {
+    return static_cast<int>(loanTable->countOverdue(TimeUtils::nowMillis()));
+}
+
+int LibraryManager::getTotalHolds() {
+    return static_cast<int>(holdQueues->size());
+}
+
+// ============ ADMIN OPERATIONS - ANALYTICS ============
+
+vector<BookCount> LibraryManager::getTopBooks(const SessionContext& session, int64_t fromMs, 
+                                              int64_t toMs, size_t count) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
+        return vector<BookCount>();
     }
-    return availableCount;
+    return analytics->topBooks(fromMs, toMs, count);
+}
+
+vector<UserCount> LibraryManager::getBusiestUsers(const SessionContext& session, int64_t fromMs, 
+                                                  int64_t toMs, size_t count) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
+        return vector<UserCount>();
+    }
+    return analytics->topUsers(fromMs, toMs, count);
+}
+
+vector<DayCount> LibraryManager::getDailyActivity(const SessionContext& session, int64_t fromMs, 
+                                                  int64_t toMs) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
+        return vector<DayCount>();
+    }
+    return analytics->dailyActivity(fromMs, toMs);
+}
+
+uint64_t LibraryManager::getRecentBorrowEstimate(const SessionContext& session, 
+                                                 const string& isbn) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
+        return 0;
+    }
+    trends->advance(TimeUtils::nowMillis());
+    return trends->estimateBorrows(isbn);
+}
+
+uint64_t LibraryManager::getRecentUniqueBorrowers(const SessionContext& session) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
+        return 0;
+    }
+    trends->advance(TimeUtils::nowMillis());
+    return trends->estimateUniqueBorrowers();
+}
+
+uint64_t LibraryManager::getRecentBorrows(const SessionContext& session) {
+    if (authManager == nullptr || !authManager->isAdmin(session)) {
+        return 0;
+    }
+    trends->advance(TimeUtils::nowMillis());
+    return trends->getWindowBorrows();
 }
 
 int LibraryManager::getTotalUsers() {
@@ -311,14 +633,98 @@ int LibraryManager::getTotalTransactions() {
 }
 
 int LibraryManager::getActiveUsersCount() {
-    vector<User*> users = userMap->getAllUsers();
-    int activeCount = 0;
-    for (User* user : users) {
-        if (user->isActive()) {
-            activeCount++;
+    return userMap->getActiveCount();
+}
+
+int LibraryManager::getInactiveUsersCount() {
+    return userMap->getCount() - userMap->getActiveCount();
+}
+
+// Reset the daily counters when the calendar day (local) changes
+void LibraryManager::rollStatsDay() {
+    int64_t today = TimeUtils::dayOf(TimeUtils::nowMillis());
+    if (today != stats.statsDay) {
+        stats.statsDay = today;
+        stats.borrowsToday = 0;
+        stats.returnsToday = 0;
+    }
+}
+
+void LibraryManager::rebuildStatistics() {
+    stats = LibraryStats();
+    
+    for (Book* book : bookTree->getAllBooksSorted()) {
+        stats.totalCopies += book->getQuantity();
+        stats.availableCopies += book->getAvailableCopies();
+    }
+    
+    rollStatsDay();
+    int64_t dayStart = TimeUtils::startOfDay(stats.statsDay);
+    int64_t dayEnd = TimeUtils::startOfDay(stats.statsDay + 1);
+    for (size_t seq = 0; seq < transactionList->size(); seq++) {
+        const Transaction* trans = transactionList->at(seq);
+        if (trans->getTimestamp() < dayStart || trans->getTimestamp() >= dayEnd) {
+            continue;
+        }
+        if (trans->getType() == "BORROW") {
+            stats.borrowsToday++;
+        } else if (trans->getType() == "RETURN") {
+            stats.returnsToday++;
+        }
+    }
+}
+
+// Users' borrowed lists say who holds what; the log supplies when. Each
+// loan starts at that user's latest BORROW of the book, found by walking
+// their history backwards (loans are recent, so this stops early), and
+// keeps that BORROW's copy if the book still shows it on loan. Loans
+// without one are matched to the lowest unclaimed copy on loan.
+void LibraryManager::rebuildLoans() {
+    loanTable->clear();
+    int64_t now = TimeUtils::nowMillis();
+    unordered_set<string> claimed;   // Barcodes already matched to a loan
+    
+    for (const User& user : userMap->getAllUsers()) {
+        const BorrowedBooks& loans = user.getBorrowedBooks();
+        if (loans.size() == 0) {
+            continue;
+        }
+        
+        Span<Transaction* const> history = transactionList->getByUserID(user.getID());
+        for (int i = 0; i < loans.size(); i++) {
+            string isbn = loans.isbnAt(i);
+            int64_t borrowedAt = now;   // No BORROW on record (legacy data)
+            int copyNumber = 0;
+            
+            for (size_t j = history.size(); j > 0; j--) {
+                const Transaction* trans = history[j - 1];
+                if (trans->getType() == "BORROW" && trans->getISBN() == isbn) {
+                    borrowedAt = trans->getTimestamp();
+                    copyNumber = trans->getCopyNumber();
+                    break;
+                }
+            }
+            
+            Book* book = bookTree->search(isbn);
+            if (book != nullptr && (book->getCopyStatus(copyNumber) != Book::ON_LOAN || 
+                                    claimed.count(book->getBarcode(copyNumber)) != 0)) {
+                copyNumber = 0;
+                for (int n = 1; n <= book->getCopyCount(); n++) {
+                    if (book->getCopyStatus(n) == Book::ON_LOAN && 
+                        claimed.count(book->getBarcode(n)) == 0) {
+                        copyNumber = n;
+                        break;
+                    }
+                }
+            }
+            if (book != nullptr && copyNumber != 0) {
+                claimed.insert(book->getBarcode(copyNumber));
+            }
+            
+            loanTable->add(user.getID(), isbn, copyNumber, borrowedAt, 
+                           borrowedAt + LOAN_PERIOD_DAYS * TimeUtils::MS_PER_DAY);
         }
     }
-    return activeCount;
 }
 
 // ============ USER OPERATIONS - SEARCH ============
@@ -339,18 +745,33 @@ Book* LibraryManager::searchBookByISBN(const string& isbn) {
     return searchEngine->searchByISBN(isbn);
 }
 
+// Books removed from the catalogue since are left off the shelf
+vector<TrendingBook> LibraryManager::getTrendingBooks(size_t count) {
+    trends->advance(TimeUtils::nowMillis());
+    vector<TrendingBook> shelf;
+    for (const TrendingBook& entry : trends->trending(TREND_TOP_K)) {
+        if (shelf.size() == count) {
+            break;
+        }
+        if (bookTree->search(entry.isbn) != nullptr) {
+            shelf.push_back(entry);
+        }
+    }
+    return shelf;
+}
+
+vector<RelatedBook> LibraryManager::getRelatedBooks(const string& isbn, size_t count) {
+    return recommender->related(isbn, count);
+}
+
 // ============ USER OPERATIONS - BORROW & RETURN ============
 
-bool LibraryManager::borrowBook(const string& isbn) {
+bool LibraryManager::borrowBook(const SessionContext& session, const string& isbn) {
     // Check if user is logged in
-    if (authManager == nullptr || !authManager->isUser()) {
-        cout << "Access Denied: Please login as user." << endl;
-        return false;
-    }
-    
-    User* currentUser = authManager->getCurrentUser();
+    User* currentUser = (authManager != nullptr) ? authManager->getSessionUser(session) 
+                                                 : nullptr;
     if (currentUser == nullptr) {
-        cout << "Error: User session invalid." << endl;
+        cout << "Access Denied: Please login as user." << endl;
         return false;
     }
     
@@ -370,7 +791,7 @@ bool LibraryManager::borrowBook(const string& isbn) {
     
     // Check if book is available
     if (!book->isAvailable()) {
-        cout << "Error: Book is not available." << endl;
+        cout << "Error: Book is not available. You can place a hold on it." << endl;
         return false;
     }
     
@@ -381,38 +802,92 @@ bool LibraryManager::borrowBook(const string& isbn) {
     }
     
     // Perform borrowing
-    if (book->borrowBook()) {
-        currentUser->addBorrowedBook(isbn);
-        
-        // Create transaction record
-        Transaction* trans = new Transaction(
-            currentUser->getUserID(),
-            isbn,
-            "BORROW",
-            currentUser->getFullName(),
-            book->getTitle()
-        );
-        transactionList->append(trans);
-        
-        cout << "Success: Book borrowed successfully." << endl;
-        cout << "Books borrowed: " << currentUser->getBorrowedCount() 
-             << "/" << MAX_BORROW_LIMIT << endl;
-        return true;
+    if (!lendCopy(currentUser, book)) {
+        cout << "Error: Could not record loan for this ISBN." << endl;
+        return false;
     }
     
-    return false;
+    cout << "Success: Book borrowed successfully." << endl;
+    cout << "Books borrowed: " << currentUser->getBorrowedCount() 
+         << "/" << MAX_BORROW_LIMIT << endl;
+    return true;
 }
 
-bool LibraryManager::returnBook(const string& isbn) {
-    // Check if user is logged in
-    if (authManager == nullptr || !authManager->isUser()) {
-        cout << "Access Denied: Please login as user." << endl;
+// Checks one copy out to user: loan list, BORROW record, due date and
+// counters. The caller has already checked availability and limits.
+bool LibraryManager::lendCopy(User* user, Book* book) {
+    string isbn = book->getISBN();
+    int copyNumber = book->borrowCopy();
+    if (copyNumber == 0) {
         return false;
     }
+    if (!user->addBorrowedBook(isbn)) {
+        book->returnCopy(copyNumber);  // Roll back the copy
+        return false;
+    }
+    
+    // Create transaction record
+    Transaction* record = transactionList->append(Transaction(
+        user->getID(),
+        isbn,
+        "BORROW",
+        user->getFullName(),
+        book->getTitle(),
+        copyNumber
+    ));
+    
+    JournalRecord entry(JournalRecord::BORROW);
+    entry.putUnsigned(record->getID());
+    entry.putUnsigned(user->getID());
+    entry.putString(isbn);
+    entry.putSigned(copyNumber);
+    entry.putSigned(record->getTimestamp());
+    logMutation(entry);
+    
+    analytics->append(*record);
+    trends->add(*record);
+    recommender->recordBorrow(record, transactionList->getByUserID(user->getID()));
     
-    User* currentUser = authManager->getCurrentUser();
+    int64_t borrowedAt = record->getTimestamp();
+    loanTable->add(user->getID(), isbn, copyNumber, borrowedAt, 
+                   borrowedAt + LOAN_PERIOD_DAYS * TimeUtils::MS_PER_DAY);
+    holdQueues->cancel(user->getID(), isbn);  // Borrowing ends any hold on it
+    
+    stats.availableCopies--;
+    rollStatsDay();
+    stats.borrowsToday++;
+    return true;
+}
+
+// Hands free copies of book to holders, front of the queue first. Holders
+// who are inactive or at MAX_BORROW_LIMIT are passed over but keep their
+// place; with nobody eligible the copy goes back on the shelf.
+void LibraryManager::serveHolds(Book* book) {
+    string isbn = book->getISBN();
+    while (book->isAvailable()) {
+        uint64_t holderID = holdQueues->takeNext(isbn, [this, &isbn](uint64_t userID) {
+            User* user = userMap->searchByID(userID);
+            return user != nullptr && user->isActive() && user->canBorrow() && 
+                   !user->hasBorrowedBook(isbn);
+        });
+        if (holderID == 0) {
+            return;
+        }
+        
+        User* holder = userMap->searchByID(holderID);
+        if (lendCopy(holder, book)) {
+            cout << "Info: Copy passed to " << holder->getUserID() 
+                 << " from the hold queue." << endl;
+        }
+    }
+}
+
+bool LibraryManager::returnBook(const SessionContext& session, const string& isbn) {
+    // Check if user is logged in
+    User* currentUser = (authManager != nullptr) ? authManager->getSessionUser(session) 
+                                                 : nullptr;
     if (currentUser == nullptr) {
-        cout << "Error: User session invalid." << endl;
+        cout << "Access Denied: Please login as user." << endl;
         return false;
     }
     
@@ -429,44 +904,183 @@ bool LibraryManager::returnBook(const string& isbn) {
         return false;
     }
     
-    // Perform return
-    if (book->returnBook()) {
+    // Perform return of the copy this user took out
+    const Loan* loan = loanTable->find(currentUser->getID(), isbn);
+    int copyNumber = (loan != nullptr) ? loan->copyNumber : 0;
+    if (book->returnCopy(copyNumber)) {
         currentUser->removeBorrowedBook(isbn);
+        loanTable->remove(currentUser->getID(), isbn);
         
         // Create transaction record
-        Transaction* trans = new Transaction(
-            currentUser->getUserID(),
+        Transaction* record = transactionList->append(Transaction(
+            currentUser->getID(),
             isbn,
             "RETURN",
             currentUser->getFullName(),
-            book->getTitle()
-        );
-        transactionList->append(trans);
+            book->getTitle(),
+            copyNumber
+        ));
+        analytics->append(*record);
+        
+        JournalRecord entry(JournalRecord::RETURN);
+        entry.putUnsigned(record->getID());
+        entry.putUnsigned(currentUser->getID());
+        entry.putString(isbn);
+        entry.putSigned(copyNumber);
+        entry.putSigned(record->getTimestamp());
+        logMutation(entry);
+        
+        stats.availableCopies++;
+        rollStatsDay();
+        stats.returnsToday++;
         
         cout << "Success: Book returned successfully." << endl;
         cout << "Books borrowed: " << currentUser->getBorrowedCount() 
              << "/" << MAX_BORROW_LIMIT << endl;
+        serveHolds(book);
         return true;
     }
     
     return false;
 }
 
-vector<Book*> LibraryManager::getMyBorrowedBooks() {
-    if (authManager == nullptr || !authManager->isUser()) {
-        return vector<Book*>();
+// ============ USER OPERATIONS - HOLDS ============
+
+bool LibraryManager::placeHold(const SessionContext& session, const string& isbn) {
+    User* currentUser = (authManager != nullptr) ? authManager->getSessionUser(session) 
+                                                 : nullptr;
+    if (currentUser == nullptr) {
+        cout << "Access Denied: Please login as user." << endl;
+        return false;
+    }
+    
+    Book* book = bookTree->search(isbn);
+    if (book == nullptr) {
+        cout << "Error: Book not found." << endl;
+        return false;
+    }
+    
+    if (book->isAvailable()) {
+        cout << "Error: Book is available; borrow it instead." << endl;
+        return false;
+    }
+    
+    if (currentUser->hasBorrowedBook(isbn)) {
+        cout << "Error: You have already borrowed this book." << endl;
+        return false;
+    }
+    
+    if (holdQueues->getHoldCount(currentUser->getID()) >= MAX_HOLDS_PER_USER) {
+        cout << "Error: Hold limit reached (" << MAX_HOLDS_PER_USER << " holds)." << endl;
+        return false;
     }
     
-    User* currentUser = authManager->getCurrentUser();
+    int64_t placedAt = TimeUtils::nowMillis();
+    if (!holdQueues->place(currentUser->getID(), isbn, placedAt)) {
+        cout << "Error: You already have a hold on this book." << endl;
+        return false;
+    }
+    
+    JournalRecord record(JournalRecord::HOLD_PLACE);
+    record.putUnsigned(currentUser->getID());
+    record.putString(isbn);
+    record.putSigned(placedAt);
+    logMutation(record);
+    
+    cout << "Success: Hold placed. Position in queue: " 
+         << holdQueues->getPosition(currentUser->getID(), isbn) << endl;
+    return true;
+}
+
+bool LibraryManager::cancelHold(const SessionContext& session, const string& isbn) {
+    User* currentUser = (authManager != nullptr) ? authManager->getSessionUser(session) 
+                                                 : nullptr;
+    if (currentUser == nullptr) {
+        cout << "Access Denied: Please login as user." << endl;
+        return false;
+    }
+    
+    if (!holdQueues->cancel(currentUser->getID(), isbn)) {
+        cout << "Error: You have no hold on this book." << endl;
+        return false;
+    }
+    
+    JournalRecord record(JournalRecord::HOLD_CANCEL);
+    record.putUnsigned(currentUser->getID());
+    record.putString(isbn);
+    logMutation(record);
+    
+    cout << "Success: Hold cancelled." << endl;
+    return true;
+}
+
+vector<HoldInfo> LibraryManager::getMyHolds(const SessionContext& session) {
+    User* currentUser = (authManager != nullptr) ? authManager->getSessionUser(session) 
+                                                 : nullptr;
+    if (currentUser == nullptr) {
+        return vector<HoldInfo>();
+    }
+    return holdQueues->getHoldsOf(currentUser->getID());
+}
+
+vector<const Loan*> LibraryManager::getMyLoans(const SessionContext& session) {
+    User* currentUser = (authManager != nullptr) ? authManager->getSessionUser(session) 
+                                                 : nullptr;
+    if (currentUser == nullptr) {
+        return vector<const Loan*>();
+    }
+    return loanTable->getByUser(currentUser->getID());
+}
+
+// Neighbours of everything the user has out, strongest links first;
+// books they already have or that were removed are left out
+vector<RelatedBook> LibraryManager::getMyRecommendations(const SessionContext& session, 
+                                                         size_t count) {
+    User* currentUser = (authManager != nullptr) ? authManager->getSessionUser(session) 
+                                                 : nullptr;
+    if (currentUser == nullptr) {
+        return vector<RelatedBook>();
+    }
+    
+    vector<RelatedBook> merged;
+    unordered_map<string, size_t> position;
+    for (const Loan* loan : loanTable->getByUser(currentUser->getID())) {
+        for (const RelatedBook& entry : recommender->related(loan->isbn, RECOMMEND_NEIGHBOURS)) {
+            if (currentUser->hasBorrowedBook(entry.isbn) || 
+                bookTree->search(entry.isbn) == nullptr) {
+                continue;
+            }
+            auto found = position.emplace(entry.isbn, merged.size());
+            if (found.second) {
+                merged.push_back(entry);
+            } else {
+                merged[found.first->second].patrons += entry.patrons;
+            }
+        }
+    }
+    
+    stable_sort(merged.begin(), merged.end(), [](const RelatedBook& a, const RelatedBook& b) {
+        return a.patrons > b.patrons;
+    });
+    if (merged.size() > count) {
+        merged.resize(count);
+    }
+    return merged;
+}
+
+vector<Book*> LibraryManager::getMyBorrowedBooks(const SessionContext& session) {
+    User* currentUser = (authManager != nullptr) ? authManager->getSessionUser(session) 
+                                                 : nullptr;
     if (currentUser == nullptr) {
         return vector<Book*>();
     }
     
     vector<Book*> borrowedBooks;
-    set<string> borrowedISBNs = currentUser->getBorrowedISBNs();
+    const BorrowedBooks& loans = currentUser->getBorrowedBooks();
+    borrowedBooks.reserve(loans.size());
     
-    for (const string& isbn : borrowedISBNs) {
-        Book* book = bookTree->search(isbn);
+    for (int i = 0; i < loans.size(); i++) {
+        Book* book = bookTree->search(loans.isbnAt(i));
         if (book != nullptr) {
             borrowedBooks.push_back(book);
         }
@@ -475,27 +1089,217 @@ vector<Book*> LibraryManager::getMyBorrowedBooks() {
     return borrowedBooks;
 }
 
-vector<Transaction*> LibraryManager::getMyTransactions() {
-    if (authManager == nullptr || !authManager->isUser()) {
-        return vector<Transaction*>();
+Span<Transaction* const> LibraryManager::getMyTransactions(const SessionContext& session) {
+    User* currentUser = (authManager != nullptr) ? authManager->getSessionUser(session) 
+                                                 : nullptr;
+    if (currentUser == nullptr) {
+        return Span<Transaction* const>();
     }
     
-    User* currentUser = authManager->getCurrentUser();
+    return transactionList->getByUserID(currentUser->getID());
+}
+
+TransactionCursor LibraryManager::getMyHistory(const SessionContext& session, size_t pageSize) {
+    User* currentUser = (authManager != nullptr) ? authManager->getSessionUser(session) 
+                                                 : nullptr;
     if (currentUser == nullptr) {
-        return vector<Transaction*>();
+        return TransactionCursor();
+    }
+    
+    return TransactionCursor::forUser(transactionList, currentUser->getID(), pageSize);
+}
+
+TransactionList::Range LibraryManager::getMyMonthlyTransactions(const SessionContext& session, 
+                                                                int year, int month) {
+    User* currentUser = (authManager != nullptr) ? authManager->getSessionUser(session) 
+                                                 : nullptr;
+    int64_t fromMs, toMs;
+    if (currentUser == nullptr || !TimeUtils::monthWindow(year, month, fromMs, toMs)) {
+        return TransactionList::Range();
+    }
+    
+    return transactionList->getByUserIDBetween(currentUser->getID(), fromMs, toMs);
+}
+
+// ============ JOURNAL ============
+
+// Called once a mutation has been applied in memory and before it is
+// reported as done, so anything the user saw succeed survives a crash
+void LibraryManager::logMutation(JournalRecord& record) {
+    if (journal->isOpen() && !journal->append(record)) {
+        cout << "Warning: Change could not be journaled; save to keep it." << endl;
+    }
+}
+
+// IDs grow along the log, so walk the user's history back from the end
+bool LibraryManager::hasTransaction(uint64_t userID, uint64_t transactionID) {
+    Span<Transaction* const> history = transactionList->getByUserID(userID);
+    for (size_t i = history.size(); i > 0; i--) {
+        uint64_t id = history[i - 1]->getID();
+        if (id <= transactionID) {
+            return id == transactionID;
+        }
     }
+    return false;
+}
+
+// Re-applies one journaled mutation to the loaded files' state: books,
+// users, loans lists, the log and hold queues only (everything derived is
+// rebuilt afterwards). Each step is skipped if the files already show it,
+// since a crash partway through writing the CSV files can leave some newer
+// than the checkpoint (the binary snapshot is one file and carries its own
+// LSN); a quantity change later undone by retiring copies is the one case
+// that can then come back. Returns false if nothing applied.
+bool LibraryManager::applyJournalRecord(JournalRecord& record) {
+    string isbn, title, author;
+    uint64_t userID = 0;
+    uint64_t transactionID = 0;
+    int number = 0;
+    int64_t timestamp = 0;
     
-    return transactionList->getByUserID(currentUser->getUserID());
+    switch (record.getType()) {
+        case JournalRecord::BOOK_ADD: {
+            if (!record.getString(isbn) || !record.getString(title) || 
+                !record.getString(author) || !record.getInt(number) || 
+                bookTree->search(isbn) != nullptr) {
+                return false;
+            }
+            bookTree->insert(Book(isbn, title, author, number));
+            return true;
+        }
+        case JournalRecord::BOOK_DETAILS: {
+            Book* book = record.getString(isbn) ? bookTree->search(isbn) : nullptr;
+            if (book == nullptr || !record.getString(title) || !record.getString(author)) {
+                return false;
+            }
+            Book updatedBook = *book;
+            updatedBook.setTitle(title);
+            updatedBook.setAuthor(author);
+            bookTree->insert(updatedBook);
+            return true;
+        }
+        case JournalRecord::BOOK_QUANTITY: {
+            Book* book = record.getString(isbn) ? bookTree->search(isbn) : nullptr;
+            if (book == nullptr || !record.getInt(number) || number == book->getQuantity() ||
+                number < book->getQuantity() - book->getAvailableCopies()) {
+                return false;
+            }
+            book->setQuantity(number);
+            return true;
+        }
+        case JournalRecord::COPY_RETIRE: {
+            Book* book = record.getString(isbn) ? bookTree->search(isbn) : nullptr;
+            return book != nullptr && record.getInt(number) && book->retireCopy(number);
+        }
+        case JournalRecord::BOOK_REMOVE: {
+            if (!record.getString(isbn) || !bookTree->remove(isbn)) {
+                return false;
+            }
+            holdQueues->removeBook(isbn);
+            return true;
+        }
+        case JournalRecord::USER_ADD: {
+            string line;
+            if (!record.getString(line)) {
+                return false;
+            }
+            try {
+                User user = User::fromFileString(line);
+                if (user.getID() == 0 || userMap->insert(user) == nullptr) {
+                    return false;
+                }
+                User::idGenerator.observe(user.getID());
+                return true;
+            } catch (...) {
+                return false;
+            }
+        }
+        case JournalRecord::USER_REMOVE: {
+            if (!record.getUnsigned(userID) || !userMap->remove(userID)) {
+                return false;
+            }
+            holdQueues->removeUser(userID);
+            return true;
+        }
+        case JournalRecord::USER_ACTIVE: {
+            uint64_t active = 0;
+            return record.getUnsigned(userID) && record.getUnsigned(active) && 
+                   userMap->setActive(userID, active != 0);
+        }
+        case JournalRecord::USER_CONTACT: {
+            string email, phone;
+            return record.getUnsigned(userID) && record.getString(email) && 
+                   record.getString(phone) && userMap->updateContact(userID, email, phone);
+        }
+        case JournalRecord::USER_PASSWORD: {
+            string hash;
+            User* user = record.getUnsigned(userID) ? userMap->searchByID(userID) : nullptr;
+            if (user == nullptr || !record.getString(hash)) {
+                return false;
+            }
+            user->setPasswordHash(hash);
+            return true;
+        }
+        case JournalRecord::BORROW:
+        case JournalRecord::RETURN: {
+            if (!record.getUnsigned(transactionID) || !record.getUnsigned(userID) || 
+                !record.getString(isbn) || !record.getInt(number) || 
+                !record.getSigned(timestamp)) {
+                return false;
+            }
+            User* user = userMap->searchByID(userID);
+            Book* book = bookTree->search(isbn);
+            if (user == nullptr || book == nullptr) {
+                return false;
+            }
+            
+            bool borrow = record.getType() == JournalRecord::BORROW;
+            bool changed = false;
+            if (borrow) {
+                changed |= book->takeCopy(number);
+                changed |= !user->hasBorrowedBook(isbn) && user->addBorrowedBook(isbn);
+                changed |= holdQueues->cancel(userID, isbn);
+            } else {
+                changed |= book->getCopyStatus(number) == Book::ON_LOAN && 
+                           book->returnCopy(number);
+                changed |= user->removeBorrowedBook(isbn);
+            }
+            if (!hasTransaction(userID, transactionID)) {
+                transactionList->append(Transaction::restore(
+                    transactionID, userID, isbn, borrow ? "BORROW" : "RETURN",
+                    user->getFullName(), book->getTitle(), number, timestamp));
+                changed = true;
+            }
+            return changed;
+        }
+        case JournalRecord::HOLD_PLACE: {
+            return record.getUnsigned(userID) && record.getString(isbn) && 
+                   record.getSigned(timestamp) && userMap->searchByID(userID) != nullptr && 
+                   holdQueues->place(userID, isbn, timestamp);
+        }
+        case JournalRecord::HOLD_CANCEL: {
+            return record.getUnsigned(userID) && record.getString(isbn) && 
+                   holdQueues->cancel(userID, isbn);
+        }
+    }
+    return false;  // Unknown type (written by a newer version)
 }
 
 // ============ DATA PERSISTENCE ============
 
+// Rewrites every file, then moves the checkpoint to the journal record
+// the capture saw and drops the records up to it. The LSN is read first:
+// a login rehash journaled meanwhile is replayed again, which is harmless.
 bool LibraryManager::saveAllData() {
-    bool success = true;
+    waitForBackgroundSave();
+    DataSnapshot snapshot = FileHandler::captureSnapshot(bookTree, userMap, transactionList, 
+                                                         holdQueues, journal->getLastLSN());
+    bool success = FileHandler::saveSnapshot(snapshot, true);
     
-    success &= FileHandler::saveBooks(BOOKS_FILE, bookTree);
-    success &= FileHandler::saveUsers(USERS_FILE, userMap);
-    success &= FileHandler::saveTransactions(TRANSACTIONS_FILE, transactionList);
+    // Keep the journal unless every file made it
+    if (success && journal->isOpen() && !journal->truncateThrough(snapshot.journalLSN)) {
+        cout << "Warning: Journal could not be trimmed; it will be replayed on start." << endl;
+    }
     
     if (success) {
         cout << "Success: All data saved successfully." << endl;
@@ -506,15 +1310,85 @@ bool LibraryManager::saveAllData() {
     return success;
 }
 
+// Background saves yield the CPU to everything else where the OS allows.
+// On Linux nice applies per thread: at 19 the writer gets about 1.5% of a
+// core that the foreground wants, yet still finishes when it is busy.
+static void lowerThreadPriority() {
+#ifdef __linux__
+    setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 19);
+#endif
+}
+
+// Only the capture runs here: O(books + users + holds) lines and the log's
+// chunk pointers, not the records. A second thread writes the files and
+// trims the journal; changes made meanwhile are journaled after the
+// snapshot's LSN, so they survive the trim.
+bool LibraryManager::saveAllDataInBackground() {
+    if (saving) {
+        cout << "Info: A save is already running; changes are kept in the journal." << endl;
+        return false;
+    }
+    waitForBackgroundSave();   // Reap the previous one
+    
+    DataSnapshot snapshot = FileHandler::captureSnapshot(bookTree, userMap, transactionList, 
+                                                         holdQueues, journal->getLastLSN());
+    saving = true;
+    saveThread = thread([this, snapshot = move(snapshot)]() {
+        lowerThreadPriority();
+        bool success = FileHandler::saveSnapshot(snapshot, false) && 
+                       (!journal->isOpen() || journal->truncateThrough(snapshot.journalLSN));
+        if (!success) {
+            cerr << "Warning: Background save failed; changes remain in the journal." << endl;
+        }
+        saving = false;
+    });
+    
+    cout << "Success: Saving in the background." << endl;
+    return true;
+}
+
+void LibraryManager::waitForBackgroundSave() {
+    if (saveThread.joinable()) {
+        saveThread.join();
+    }
+}
+
 bool LibraryManager::loadAllData() {
-    bool success = true;
+    uint64_t checkpointLSN = 0;
+    bool success = FileHandler::loadSnapshot(bookTree, userMap, transactionList, holdQueues, 
+                                             checkpointLSN);
+    
+    // Replay changes made since that snapshot was saved
+    size_t applied = 0;
+    size_t skipped = 0;
+    size_t tornBytes = 0;
+    bool journalOpen = journal->open(JOURNAL_FILE, checkpointLSN, 
+        [this](JournalRecord& record) { return applyJournalRecord(record); }, 
+        applied, skipped, tornBytes);
     
-    success &= FileHandler::loadBooks(BOOKS_FILE, bookTree);
-    success &= FileHandler::loadUsers(USERS_FILE, userMap);
-    success &= FileHandler::loadTransactions(TRANSACTIONS_FILE, transactionList);
+    if (!journalOpen) {
+        cerr << "Warning: Journal unavailable; changes are kept only by saving." << endl;
+    }
+    if (applied > 0 || skipped > 0) {
+        cout << "  ✓ Journal replayed: " << applied << " records";
+        if (skipped > 0) {
+            cout << " (" << skipped << " already in files)";
+        }
+        cout << endl;
+        success |= applied > 0;   // Changes made before the first save
+    }
+    if (tornBytes > 0) {
+        cout << "  ℹ Journal: dropped " << tornBytes 
+             << " bytes of an unfinished record" << endl;
+    }
     
-    // Rebuild search indices after loading books
+    // Rebuild search indices and aggregates after loading
     searchEngine->buildIndices();
+    rebuildStatistics();
+    rebuildLoans();
+    analytics->rebuild(*transactionList);
+    trends->rebuild(*transactionList, TimeUtils::nowMillis());
+    recommender->rebuild(*analytics);
     
     if (success) {
         cout << "Success: All data loaded successfully." << endl;
@@ -559,6 +1433,7 @@ void LibraryManager::initializeSampleData() {
 bool LibraryManager::isISBNValid(const string& isbn) {
     // Basic ISBN validation (ISBN-10 or ISBN-13 format)
     if (isbn.length() < 10) return false;
+    if (isbn.length() > static_cast<size_t>(MAX_ISBN_LENGTH)) return false;
     
     // Check for ISBN-13 format: 978-X-XXX-XXXXX-X
     if (isbn.find("978") == 0 || isbn.find("979") == 0) {
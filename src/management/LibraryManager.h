@@ -8,22 +8,53 @@
 #include "BookBST.h"
 #include "UserHashMap.h"
 #include "TransactionList.h"
+#include "TransactionCursor.h"
+#include "LoanTable.h"
+#include "HoldQueues.h"
+#include "TransactionAnalytics.h"
+#include "TrendingSketch.h"
+#include "Recommender.h"
 #include "SearchEngine.h"
 #include "AuthManager.h"
+#include "../utils/Journal.h"
 #include "../Config.h"
 #include <string>
 #include <vector>
+#include <thread>
+#include <atomic>
 using namespace std;
 
 class LibraryManager {
 private:
+    // Live aggregates behind the statistics screens, kept in step with
+    // every mutation so reads are O(1). Rebuilt once after loading.
+    struct LibraryStats {
+        int totalCopies;
+        int availableCopies;
+        int borrowsToday;
+        int returnsToday;
+        int64_t statsDay;    // Local day number the *Today counters belong to
+        
+        LibraryStats() : totalCopies(0), availableCopies(0), 
+                         borrowsToday(0), returnsToday(0), statsDay(-1) {}
+    };
+    
     static LibraryManager* instance;
     
     BookBST* bookTree;
     UserHashMap* userMap;
     TransactionList* transactionList;
+    LoanTable* loanTable;
+    HoldQueues* holdQueues;
+    TransactionAnalytics* analytics;   // Column copy of the log for reports
+    TrendingSketch* trends;            // Recent borrows, fixed-size estimates
+    Recommender* recommender;          // Co-borrowed titles
     SearchEngine* searchEngine;
     AuthManager* authManager;
+    Journal* journal;                  // Mutations since the last save
+    thread saveThread;                 // Background save, if one has run
+    atomic<bool> saving;
+    LibraryStats stats;
     
     // Private constructor (Singleton)
     LibraryManager();
@@ -31,6 +62,15 @@ private:
     // Private helper methods (no auth check)
     bool addBookInternal(const string& isbn, const string& title, 
                         const string& author, int quantity);
+    void rebuildStatistics();
+    void rebuildLoans();
+    bool lendCopy(User* user, Book* book);
+    void serveHolds(Book* book);
+    void rollStatsDay();
+    void logMutation(JournalRecord& record);
+    bool applyJournalRecord(JournalRecord& record);
+    bool hasTransaction(uint64_t userID, uint64_t transactionID);
+    void waitForBackgroundSave();
 
 public:
     static LibraryManager* getInstance();
@@ -38,32 +78,68 @@ public:
     
     void setAuthManager(AuthManager* auth);
     
+    // Operations below take the caller's session (from AuthManager login);
+    // its token is validated on every call.
+    
     // ============ ADMIN OPERATIONS ============
     
     // Book Management
-    bool addBook(const string& isbn, const string& title, 
-                const string& author, int quantity);
-    bool removeBook(const string& isbn);
-    bool updateBookDetails(const string& isbn, const string& newTitle, 
-                          const string& newAuthor);
-    bool updateBookQuantity(const string& isbn, int newQuantity);
-    vector<Book*> getAllBooks();
+    bool addBook(const SessionContext& session, const string& isbn, 
+                const string& title, const string& author, int quantity);
+    bool removeBook(const SessionContext& session, const string& isbn);
+    bool updateBookDetails(const SessionContext& session, const string& isbn, 
+                          const string& newTitle, const string& newAuthor);
+    bool updateBookQuantity(const SessionContext& session, const string& isbn, int newQuantity);
+    bool retireCopy(const SessionContext& session, const string& isbn, int copyNumber);
+    vector<Transaction*> getCopyHistory(const SessionContext& session, const string& isbn, 
+                                        int copyNumber);   // Oldest first
+    vector<Book*> getAllBooks(const SessionContext& session);
     vector<Book*> getAvailableBooks();
     
     // User Management
-    vector<User*> getAllUsers();
-    bool removeUser(const string& userID);
-    bool deactivateUser(const string& userID);
-    bool activateUser(const string& userID);
-    User* getUserDetails(const string& userID);
+    Span<const User> getAllUsers(const SessionContext& session);
+    bool removeUser(const SessionContext& session, uint64_t userID);
+    bool deactivateUser(const SessionContext& session, uint64_t userID);
+    bool activateUser(const SessionContext& session, uint64_t userID);
+    User* getUserDetails(const SessionContext& session, uint64_t userID);
+    User* findUserByEmail(const SessionContext& session, const string& email);
+    vector<User*> findUsersByPhone(const SessionContext& session, const string& phone);
     // In LibraryManager class, add public method:
     UserHashMap* getUserMap() { return userMap; }
     
-    // Transaction Management
-    vector<Transaction*> getAllTransactions();
-    vector<Transaction*> getUserTransactions(const string& userID);
-    vector<Transaction*> getBookTransactions(const string& isbn);
-    vector<Transaction*> getRecentTransactions(int count);
+    // Transaction Management (views are oldest first, valid until the next
+    // borrow/return; cursors page newest first unless told otherwise).
+    // getAllTransactions copies the whole log; screens use the cursors.
+    vector<Transaction*> getAllTransactions(const SessionContext& session);
+    TransactionCursor getTransactionHistory(const SessionContext& session, size_t pageSize);
+    Span<Transaction* const> getUserTransactions(const SessionContext& session, uint64_t userID);
+    Span<Transaction* const> getBookTransactions(const SessionContext& session, const string& isbn);
+    TransactionCursor getUserHistory(const SessionContext& session, uint64_t userID, 
+                                     size_t pageSize);
+    TransactionCursor getBookHistory(const SessionContext& session, const string& isbn, 
+                                     size_t pageSize);
+    vector<Transaction*> getRecentTransactions(const SessionContext& session, int count);
+    
+    // Activity windows [fromMs, toMs); daily/monthly use local calendar dates
+    // and return an empty view for a date that does not exist
+    TransactionList::Range getTransactionsBetween(const SessionContext& session, 
+                                                  int64_t fromMs, int64_t toMs);
+    TransactionList::Range getDailyTransactions(const SessionContext& session, 
+                                                int year, int month, int day);
+    TransactionList::Range getMonthlyTransactions(const SessionContext& session, 
+                                                  int year, int month);
+    TransactionList::Range getUserTransactionsBetween(const SessionContext& session, 
+                                                      uint64_t userID, 
+                                                      int64_t fromMs, int64_t toMs);
+    TransactionList::Range getBookTransactionsBetween(const SessionContext& session, 
+                                                      const string& isbn, 
+                                                      int64_t fromMs, int64_t toMs);
+    
+    // Loans (pointers valid until that loan is returned)
+    vector<const Loan*> getOverdueLoans(const SessionContext& session);
+    vector<const Loan*> getLoansDueTomorrow(const SessionContext& session);   // Local day
+    vector<const Loan*> getBookBorrowers(const SessionContext& session, const string& isbn);
+    vector<Hold> getHoldQueue(const SessionContext& session, const string& isbn);
     
     // Reports & Statistics
     int getTotalBooks();
@@ -71,6 +147,26 @@ public:
     int getTotalUsers();
     int getTotalTransactions();
     int getActiveUsersCount();
+    int getInactiveUsersCount();
+    int getTotalCopies();
+    int getBorrowedCopies();
+    int getBorrowsToday();
+    int getReturnsToday();
+    int getOverdueCount();
+    int getTotalHolds();
+    
+    // Analytics over [fromMs, toMs), counting borrows
+    vector<BookCount> getTopBooks(const SessionContext& session, int64_t fromMs, 
+                                  int64_t toMs, size_t count);
+    vector<UserCount> getBusiestUsers(const SessionContext& session, int64_t fromMs, 
+                                      int64_t toMs, size_t count);
+    vector<DayCount> getDailyActivity(const SessionContext& session, int64_t fromMs, 
+                                      int64_t toMs);
+    
+    // Estimates over the trending window (TrendingSketch::getWindowMs)
+    uint64_t getRecentBorrowEstimate(const SessionContext& session, const string& isbn);
+    uint64_t getRecentUniqueBorrowers(const SessionContext& session);
+    uint64_t getRecentBorrows(const SessionContext& session);   // Exact
     
     // ============ USER OPERATIONS ============
     
@@ -79,17 +175,30 @@ public:
     vector<Book*> searchBooksByAuthor(const string& author);
     vector<Book*> searchBooksByKeyword(const string& keyword);
     Book* searchBookByISBN(const string& isbn);
+    vector<TrendingBook> getTrendingBooks(size_t count);   // Estimated, most borrowed first
+    vector<RelatedBook> getRelatedBooks(const string& isbn, size_t count);   // Strongest first
     
     // Borrow & Return
-    bool borrowBook(const string& isbn);
-    bool returnBook(const string& isbn);
-    vector<Book*> getMyBorrowedBooks();
-    vector<Transaction*> getMyTransactions();
+    bool borrowBook(const SessionContext& session, const string& isbn);
+    bool returnBook(const SessionContext& session, const string& isbn);
+    vector<Book*> getMyBorrowedBooks(const SessionContext& session);
+    vector<const Loan*> getMyLoans(const SessionContext& session);
+    vector<RelatedBook> getMyRecommendations(const SessionContext& session, size_t count);
+    
+    // Holds (a returned copy goes straight to the first eligible holder)
+    bool placeHold(const SessionContext& session, const string& isbn);
+    bool cancelHold(const SessionContext& session, const string& isbn);
+    vector<HoldInfo> getMyHolds(const SessionContext& session);
+    Span<Transaction* const> getMyTransactions(const SessionContext& session);
+    TransactionCursor getMyHistory(const SessionContext& session, size_t pageSize);
+    TransactionList::Range getMyMonthlyTransactions(const SessionContext& session, 
+                                                    int year, int month);
     
     // ============ COMMON OPERATIONS ============
     
-    // Data Persistence
-    bool saveAllData();
+    // Data Persistence (both capture the data at the moment of the call)
+    bool saveAllData();                 // Waits for a background save first
+    bool saveAllDataInBackground();     // False if a save is still running
     bool loadAllData();
     void initializeSampleData();
     
@@ -0,0 +1,156 @@
+// management/LoanTable.cpp
+#include "LoanTable.h"
+
+// ============ HELPERS ============
+
+// A user holds at most a handful of loans, so a short scan beats a
+// second hash keyed by (user, book)
+int LoanTable::findSlot(uint64_t userID, const string& isbn) const {
+    auto it = userLoans.find(userID);
+    if (it == userLoans.end()) {
+        return -1;
+    }
+    for (uint32_t slot : it->second) {
+        if (slots[slot].isbn == isbn) {
+            return static_cast<int>(slot);
+        }
+    }
+    return -1;
+}
+
+void LoanTable::eraseSlot(vector<uint32_t>& list, uint32_t slot) {
+    for (size_t i = 0; i < list.size(); i++) {
+        if (list[i] == slot) {
+            list[i] = list.back();
+            list.pop_back();
+            return;
+        }
+    }
+}
+
+// ============ MAIN OPERATIONS ============
+
+bool LoanTable::add(uint64_t userID, const string& isbn, int copyNumber, 
+                    int64_t borrowedAt, int64_t dueAt) {
+    if (findSlot(userID, isbn) >= 0) {
+        return false;  // Already on loan to this user
+    }
+    
+    uint32_t slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(slots.size());
+        slots.emplace_back();
+    }
+    
+    Loan& loan = slots[slot];
+    loan.userID = userID;
+    loan.isbn = isbn;
+    loan.copyNumber = copyNumber;
+    loan.borrowedAt = borrowedAt;
+    loan.dueAt = dueAt;
+    
+    userLoans[userID].push_back(slot);
+    bookLoans[isbn].push_back(slot);
+    dueIndex.insert(make_pair(dueAt, slot));
+    return true;
+}
+
+bool LoanTable::remove(uint64_t userID, const string& isbn) {
+    int found = findSlot(userID, isbn);
+    if (found < 0) {
+        return false;
+    }
+    
+    uint32_t slot = static_cast<uint32_t>(found);
+    Loan& loan = slots[slot];
+    dueIndex.erase(make_pair(loan.dueAt, slot));
+    
+    auto byUser = userLoans.find(userID);
+    eraseSlot(byUser->second, slot);
+    if (byUser->second.empty()) {
+        userLoans.erase(byUser);
+    }
+    
+    auto byBook = bookLoans.find(isbn);
+    eraseSlot(byBook->second, slot);
+    if (byBook->second.empty()) {
+        bookLoans.erase(byBook);
+    }
+    
+    loan = Loan();
+    freeSlots.push_back(slot);
+    return true;
+}
+
+const Loan* LoanTable::find(uint64_t userID, const string& isbn) const {
+    int slot = findSlot(userID, isbn);
+    return (slot >= 0) ? &slots[slot] : nullptr;
+}
+
+// ============ QUERIES ============
+
+vector<const Loan*> LoanTable::getByUser(uint64_t userID) const {
+    vector<const Loan*> result;
+    auto it = userLoans.find(userID);
+    if (it != userLoans.end()) {
+        result.reserve(it->second.size());
+        for (uint32_t slot : it->second) {
+            result.push_back(&slots[slot]);
+        }
+    }
+    return result;
+}
+
+vector<const Loan*> LoanTable::getByBook(const string& isbn) const {
+    vector<const Loan*> result;
+    auto it = bookLoans.find(isbn);
+    if (it != bookLoans.end()) {
+        result.reserve(it->second.size());
+        for (uint32_t slot : it->second) {
+            result.push_back(&slots[slot]);
+        }
+    }
+    return result;
+}
+
+vector<const Loan*> LoanTable::getOverdue(int64_t nowMs) const {
+    vector<const Loan*> result;
+    for (auto it = dueIndex.begin(); it != dueIndex.end() && it->first <= nowMs; ++it) {
+        result.push_back(&slots[it->second]);
+    }
+    return result;
+}
+
+vector<const Loan*> LoanTable::getDueBetween(int64_t fromMs, int64_t toMs) const {
+    vector<const Loan*> result;
+    auto it = dueIndex.lower_bound(make_pair(fromMs, uint32_t(0)));
+    for (; it != dueIndex.end() && it->first < toMs; ++it) {
+        result.push_back(&slots[it->second]);
+    }
+    return result;
+}
+
+// ============ UTILITY ============
+
+size_t LoanTable::size() const {
+    return dueIndex.size();
+}
+
+size_t LoanTable::countOverdue(int64_t nowMs) const {
+    size_t count = 0;
+    for (auto it = dueIndex.begin(); it != dueIndex.end() && it->first <= nowMs; ++it) {
+        count++;
+    }
+    return count;
+}
+
+void LoanTable::clear() {
+    slots.clear();
+    freeSlots.clear();
+    userLoans.clear();
+    bookLoans.clear();
+    dueIndex.clear();
+}
@@ -0,0 +1,69 @@
+// management/LoanTable.h
+#ifndef LOANTABLE_H
+#define LOANTABLE_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <set>
+#include <unordered_map>
+#include <cstdint>
+using namespace std;
+
+// One copy currently out on loan
+struct Loan {
+    uint64_t userID;
+    string isbn;
+    int copyNumber;       // Which physical copy; 0 if unknown (legacy data)
+    int64_t borrowedAt;   // Epoch ms (UTC)
+    int64_t dueAt;        // Epoch ms (UTC)
+    
+    Loan() : userID(0), copyNumber(0), borrowedAt(0), dueAt(0) {}
+    
+    bool isOverdue(int64_t nowMs) const { return dueAt <= nowMs; }
+};
+
+// Active loans keyed by (user, book), with per-user, per-book and
+// due-date indexes. The due-date index is ordered by (dueAt, slot), so
+// "overdue now" and "due in [from, to)" are a range walk: O(log n) plus
+// the size of the result, never a scan of the loan table or the log.
+//
+// Loans live in a deque of reusable slots, so returned pointers stay
+// valid until that loan is removed or the table is cleared.
+class LoanTable {
+private:
+    deque<Loan> slots;
+    vector<uint32_t> freeSlots;
+    
+    unordered_map<uint64_t, vector<uint32_t>> userLoans;   // At most MAX_BORROW_LIMIT each
+    unordered_map<string, vector<uint32_t>> bookLoans;     // At most the copy count each
+    set<pair<int64_t, uint32_t>> dueIndex;                 // (dueAt, slot)
+    
+    int findSlot(uint64_t userID, const string& isbn) const;   // -1 if absent
+    static void eraseSlot(vector<uint32_t>& list, uint32_t slot);
+    
+public:
+    LoanTable() {}
+    
+    LoanTable(const LoanTable&) = delete;
+    LoanTable& operator=(const LoanTable&) = delete;
+    
+    // Main operations
+    bool add(uint64_t userID, const string& isbn, int copyNumber, 
+             int64_t borrowedAt, int64_t dueAt);
+    bool remove(uint64_t userID, const string& isbn);
+    const Loan* find(uint64_t userID, const string& isbn) const;
+    
+    // Queries, O(result)
+    vector<const Loan*> getByUser(uint64_t userID) const;
+    vector<const Loan*> getByBook(const string& isbn) const;   // Who has it
+    vector<const Loan*> getOverdue(int64_t nowMs) const;      // Due at or before nowMs, soonest first
+    vector<const Loan*> getDueBetween(int64_t fromMs, int64_t toMs) const;
+    
+    // Utility
+    size_t size() const;
+    size_t countOverdue(int64_t nowMs) const;
+    void clear();
+};
+
+#endif // LOANTABLE_H
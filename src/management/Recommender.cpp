@@ -0,0 +1,238 @@
+// management/Recommender.cpp
+#include "Recommender.h"
+#include "../Config.h"
+#include <algorithm>
+#include <thread>
+
+// ============ HELPERS ============
+
+uint32_t Recommender::slotFor(const string& isbn) {
+    auto found = slotOf.find(isbn);
+    if (found != slotOf.end()) {
+        return found->second;
+    }
+    uint32_t slot = static_cast<uint32_t>(isbns.size());
+    slotOf.emplace(isbn, slot);
+    isbns.push_back(isbn);
+    neighbours.emplace_back();
+    return slot;
+}
+
+// One more patron links from -> to. The list stays sorted by count, and
+// counts only grow by one, so the entry moves up past equal neighbours.
+void Recommender::bump(uint32_t from, uint32_t to) {
+    vector<Neighbour>& list = neighbours[from];
+
+    size_t i = 0;
+    while (i < list.size() && list[i].slot != to) {
+        i++;
+    }
+    if (i < list.size()) {
+        list[i].count++;
+    } else if (list.size() < static_cast<size_t>(RECOMMEND_TRACKED)) {
+        list.push_back({to, 1});
+    } else {
+        i = list.size() - 1;          // Evict the weakest (Space-Saving)
+        list[i].slot = to;
+        list[i].count++;
+    }
+
+    while (i > 0 && list[i - 1].count < list[i].count) {
+        swap(list[i - 1], list[i]);
+        i--;
+    }
+}
+
+// ============ UPDATES ============
+
+void Recommender::recordBorrow(const Transaction* record, Span<Transaction* const> history) {
+    uint32_t book = slotFor(record->getISBN());
+
+    // The patron's most recent distinct borrows before this one, newest
+    // first; this is the same set rebuild() tracks per patron
+    vector<uint32_t> recent;
+    for (size_t i = history.size(); i > 0 && recent.size() < static_cast<size_t>(RECOMMEND_HISTORY);
+         i--) {
+        const Transaction* earlier = history[i - 1];
+        if (earlier == record || earlier->getType() != "BORROW") {
+            continue;
+        }
+        uint32_t slot = slotFor(earlier->getISBN());
+        if (slot == book) {
+            return;  // Borrowed again while still recent: already paired
+        }
+        if (find(recent.begin(), recent.end(), slot) == recent.end()) {
+            recent.push_back(slot);
+        }
+    }
+
+    for (uint32_t other : recent) {
+        bump(book, other);
+        bump(other, book);
+    }
+}
+
+// Replays one patron's recent-borrow window (the rule recordBorrow
+// follows), calling emit(book, other) for every new pairing both ways
+template <typename Emit>
+static void replayHistory(const uint32_t* books, size_t count, Emit&& emit) {
+    uint32_t recent[RECOMMEND_HISTORY];   // Oldest first
+    size_t held = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint32_t book = books[i];
+        size_t found = 0;
+        while (found < held && recent[found] != book) {
+            found++;
+        }
+        if (found == held) {
+            for (size_t j = 0; j < held; j++) {
+                emit(book, recent[j]);
+                emit(recent[j], book);
+            }
+            found = (held == static_cast<size_t>(RECOMMEND_HISTORY)) ? 0 : held++;
+        }
+        // Move book to the newest end
+        for (size_t j = found; j + 1 < held; j++) {
+            recent[j] = recent[j + 1];
+        }
+        recent[held - 1] = book;
+    }
+}
+
+// Counts the pairs whose source book belongs to this shard. Pass one
+// sizes each book's run of partners, pass two fills them in, then each
+// run is tallied in a dense array and cut down to its strongest entries.
+void Recommender::rebuildShard(const vector<size_t>& historyStarts, 
+                               const vector<uint32_t>& historyBooks,
+                               size_t shard, size_t shardCount) {
+    size_t bookCount = isbns.size();
+    size_t patronCount = historyStarts.size() - 1;
+    size_t localCount = (bookCount + shardCount - 1 - shard) / shardCount;
+    vector<size_t> offsets(localCount + 1, 0);
+
+    for (size_t patron = 0; patron < patronCount; patron++) {
+        replayHistory(&historyBooks[historyStarts[patron]], 
+                      historyStarts[patron + 1] - historyStarts[patron],
+                      [&](uint32_t from, uint32_t) {
+                          if (from % shardCount == shard) {
+                              offsets[from / shardCount + 1]++;
+                          }
+                      });
+    }
+    for (size_t i = 0; i < localCount; i++) {
+        offsets[i + 1] += offsets[i];
+    }
+
+    vector<uint32_t> partners(offsets[localCount]);
+    vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (size_t patron = 0; patron < patronCount; patron++) {
+        replayHistory(&historyBooks[historyStarts[patron]], 
+                      historyStarts[patron + 1] - historyStarts[patron],
+                      [&](uint32_t from, uint32_t to) {
+                          if (from % shardCount == shard) {
+                              partners[cursor[from / shardCount]++] = to;
+                          }
+                      });
+    }
+
+    vector<uint32_t> counts(bookCount, 0);
+    vector<Neighbour> tally;
+    for (size_t local = 0; local < localCount; local++) {
+        tally.clear();
+        for (size_t i = offsets[local]; i < offsets[local + 1]; i++) {
+            if (counts[partners[i]]++ == 0) {
+                tally.push_back({partners[i], 0});
+            }
+        }
+        for (Neighbour& entry : tally) {
+            entry.count = counts[entry.slot];
+            counts[entry.slot] = 0;
+        }
+
+        size_t keep = min(tally.size(), static_cast<size_t>(RECOMMEND_TRACKED));
+        partial_sort(tally.begin(), tally.begin() + keep, tally.end(),
+                     [](const Neighbour& a, const Neighbour& b) {
+                         return a.count > b.count || (a.count == b.count && a.slot < b.slot);
+                     });
+        neighbours[local * shardCount + shard].assign(tally.begin(), tally.begin() + keep);
+    }
+}
+
+void Recommender::rebuild(const TransactionAnalytics& columns) {
+    clear();
+    for (const string& isbn : columns.getISBNs()) {
+        slotFor(isbn);
+    }
+
+    // Group BORROW rows by patron, keeping time order (counting sort)
+    Span<const uint32_t> users = columns.getUserSlotColumn();
+    Span<const uint32_t> books = columns.getBookSlotColumn();
+    Span<const uint8_t> types = columns.getTypeColumn();
+    vector<size_t> historyStarts(columns.getUserCount() + 1, 0);
+    for (size_t row = 0; row < users.size(); row++) {
+        historyStarts[users[row] + 1] += (types[row] == TransactionAnalytics::BORROW_ROW);
+    }
+    for (size_t i = 0; i + 1 < historyStarts.size(); i++) {
+        historyStarts[i + 1] += historyStarts[i];
+    }
+    vector<uint32_t> historyBooks(historyStarts.back());
+    vector<size_t> cursor(historyStarts.begin(), historyStarts.end() - 1);
+    for (size_t row = 0; row < users.size(); row++) {
+        if (types[row] == TransactionAnalytics::BORROW_ROW) {
+            historyBooks[cursor[users[row]]++] = books[row];
+        }
+    }
+
+    size_t hardware = max<size_t>(thread::hardware_concurrency(), 1);
+    size_t shardCount = min(hardware, static_cast<size_t>(RECOMMEND_MAX_THREADS));
+    vector<thread> workers;
+    for (size_t shard = 1; shard < shardCount; shard++) {
+        workers.emplace_back(&Recommender::rebuildShard, this, cref(historyStarts), 
+                             cref(historyBooks), shard, shardCount);
+    }
+    rebuildShard(historyStarts, historyBooks, 0, shardCount);
+    for (thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void Recommender::clear() {
+    isbns.clear();
+    slotOf.clear();
+    neighbours.clear();
+}
+
+// ============ QUERIES ============
+
+vector<RelatedBook> Recommender::related(const string& isbn, size_t k) const {
+    vector<RelatedBook> result;
+    auto found = slotOf.find(isbn);
+    if (found == slotOf.end()) {
+        return result;
+    }
+
+    const vector<Neighbour>& list = neighbours[found->second];
+    for (size_t i = 0; i < list.size() && i < k; i++) {
+        result.push_back({isbns[list[i].slot], list[i].count});
+    }
+    return result;
+}
+
+size_t Recommender::getPairCount() const {
+    size_t pairs = 0;
+    for (const vector<Neighbour>& list : neighbours) {
+        pairs += list.size();
+    }
+    return pairs;
+}
+
+size_t Recommender::getMemoryUsage() const {
+    size_t bytes = neighbours.capacity() * sizeof(vector<Neighbour>);
+    for (const vector<Neighbour>& list : neighbours) {
+        bytes += list.capacity() * sizeof(Neighbour);
+    }
+    for (const string& isbn : isbns) {
+        bytes += sizeof(string) + isbn.capacity();
+    }
+    return bytes;
+}
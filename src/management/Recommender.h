@@ -0,0 +1,71 @@
+// management/Recommender.h
+#ifndef RECOMMENDER_H
+#define RECOMMENDER_H
+
+#include "../entities/Transaction.h"
+#include "../utils/Span.h"
+#include "TransactionAnalytics.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+using namespace std;
+
+struct RelatedBook {
+    string isbn;
+    uint32_t patrons;   // Patrons who borrowed both (see Recommender)
+};
+
+// "Patrons who borrowed this also borrowed": item-to-item co-occurrence
+// over borrow histories (pairing rule in Config.h, RECOMMEND_*).
+//
+// Each book has a sparse neighbour list of at most RECOMMEND_TRACKED
+// entries, kept sorted by count, so a lookup is a copy of its first K.
+// A borrow bumps one pair per recent book of that patron, both ways.
+// When a full list meets a new neighbour, the weakest entry is replaced
+// and the newcomer inherits its count plus one (Space-Saving), so memory
+// stays bounded and any neighbour with more than 1/RECOMMEND_TRACKED of
+// a book's pairings is kept; counts may then be over-estimates.
+//
+// rebuild() recounts exactly from the analytics columns (the loaded
+// transactions.txt in dense slot form). Rows are grouped by patron with
+// a counting sort; then each thread owns the books with
+// slot % threads == its index, replays every patron's history to bucket
+// its pairs by source book, counts each book's pairs in a dense scratch
+// array and keeps the strongest.
+class Recommender {
+private:
+    struct Neighbour {
+        uint32_t slot;
+        uint32_t count;
+    };
+
+    vector<string> isbns;                          // Slot -> ISBN
+    unordered_map<string, uint32_t> slotOf;
+    vector<vector<Neighbour>> neighbours;          // Per slot, strongest first
+
+    uint32_t slotFor(const string& isbn);
+    void bump(uint32_t from, uint32_t to);
+    void rebuildShard(const vector<size_t>& historyStarts, const vector<uint32_t>& historyBooks,
+                      size_t shard, size_t shardCount);
+
+public:
+    Recommender() {}
+
+    Recommender(const Recommender&) = delete;
+    Recommender& operator=(const Recommender&) = delete;
+
+    // record: a BORROW just appended; history: that patron's records,
+    // oldest first (TransactionList::getByUserID), including record
+    void recordBorrow(const Transaction* record, Span<Transaction* const> history);
+    void rebuild(const TransactionAnalytics& columns);   // Book slots follow the columns'
+    void clear();
+
+    vector<RelatedBook> related(const string& isbn, size_t k) const;   // O(k)
+
+    // Utility
+    size_t getPairCount() const;     // Neighbour entries stored
+    size_t getMemoryUsage() const;
+};
+
+#endif // RECOMMENDER_H
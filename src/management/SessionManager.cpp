@@ -0,0 +1,167 @@
+// management/SessionManager.cpp
+#include "SessionManager.h"
+#include "../utils/Crypto.h"
+#include "../utils/HashUtils.h"
+#include "../Config.h"
+#include <chrono>
+#include <algorithm>
+
+// ============ CONSTRUCTOR & DESTRUCTOR ============
+
+SessionManager::SessionManager() : activeCount(0), wheel(SESSION_WHEEL_SLOTS) {
+    for (int i = 0; i < SESSION_STRIPES; i++) {
+        stripes.push_back(new Stripe());
+    }
+    lastSweptTick = tickOf(nowMs());
+}
+
+SessionManager::~SessionManager() {
+    for (Stripe* stripe : stripes) {
+        for (auto& entry : stripe->sessions) {
+            delete entry.second;
+        }
+        delete stripe;
+    }
+}
+
+// ============ HELPERS ============
+
+SessionManager::Stripe& SessionManager::stripeFor(const string& token) const {
+    return *stripes[HashUtils::hashString(token) & (SESSION_STRIPES - 1)];
+}
+
+int64_t SessionManager::nowMs() {
+    return chrono::duration_cast<chrono::milliseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int64_t SessionManager::tickOf(int64_t timeMs) {
+    return timeMs / (SESSION_WHEEL_TICK_SECONDS * 1000LL);
+}
+
+// Files the token under the tick its expiry falls in. Anything already
+// behind the sweep cursor goes into the next bucket to be swept; expiries
+// beyond one revolution land early and are rescheduled when visited.
+void SessionManager::schedule(const string& token, int64_t expiresAt) {
+    lock_guard<mutex> guard(wheelLock);
+    int64_t tick = tickOf(expiresAt);
+    if (tick <= lastSweptTick) {
+        tick = lastSweptTick + 1;
+    }
+    wheel[tick % SESSION_WHEEL_SLOTS].push_back(token);
+}
+
+// ============ MAIN OPERATIONS ============
+
+string SessionManager::create(SessionContext::Role role, uint64_t userID) {
+    sweepExpired();   // Amortized: no-op unless a tick has passed
+    
+    int64_t expiresAt = nowMs() + SESSION_IDLE_TIMEOUT_SECONDS * 1000LL;
+    string token;
+    
+    while (true) {
+        token = Crypto::toHex(Crypto::randomBytes(SESSION_TOKEN_BYTES));
+        Stripe& stripe = stripeFor(token);
+        unique_lock<shared_mutex> guard(stripe.lock);
+        if (stripe.sessions.count(token) == 0) {
+            stripe.sessions[token] = new Session(role, userID, expiresAt);
+            break;
+        }
+    }
+    
+    activeCount++;
+    schedule(token, expiresAt);
+    return token;
+}
+
+bool SessionManager::validate(const string& token, SessionContext& session) {
+    Stripe& stripe = stripeFor(token);
+    shared_lock<shared_mutex> guard(stripe.lock);
+    
+    auto it = stripe.sessions.find(token);
+    if (it == stripe.sessions.end()) {
+        return false;
+    }
+    
+    Session* entry = it->second;
+    int64_t now = nowMs();
+    if (entry->expiresAt.load(memory_order_relaxed) <= now) {
+        return false;   // Expired; the wheel will reclaim it
+    }
+    
+    // Sliding expiry; the wheel notices the new deadline lazily
+    entry->expiresAt.store(now + SESSION_IDLE_TIMEOUT_SECONDS * 1000LL, 
+                           memory_order_relaxed);
+    
+    session.token = token;
+    session.role = entry->role;
+    session.userID = entry->userID;
+    return true;
+}
+
+bool SessionManager::revoke(const string& token) {
+    Stripe& stripe = stripeFor(token);
+    unique_lock<shared_mutex> guard(stripe.lock);
+    
+    auto it = stripe.sessions.find(token);
+    if (it == stripe.sessions.end()) {
+        return false;
+    }
+    
+    // Its wheel entry stays behind and is skipped when swept
+    delete it->second;
+    stripe.sessions.erase(it);
+    activeCount--;
+    return true;
+}
+
+size_t SessionManager::sweepExpired() {
+    int64_t now = nowMs();
+    int64_t tick = tickOf(now);
+    vector<string> due;
+    
+    {
+        lock_guard<mutex> guard(wheelLock);
+        if (tick <= lastSweptTick) {
+            return 0;
+        }
+        
+        // After a long idle gap one full revolution covers every bucket
+        int64_t first = max(lastSweptTick + 1, tick - SESSION_WHEEL_SLOTS + 1);
+        for (int64_t t = first; t <= tick; t++) {
+            vector<string>& bucket = wheel[t % SESSION_WHEEL_SLOTS];
+            due.insert(due.end(), bucket.begin(), bucket.end());
+            bucket.clear();
+        }
+        lastSweptTick = tick;
+    }
+    
+    size_t removed = 0;
+    for (const string& token : due) {
+        Stripe& stripe = stripeFor(token);
+        unique_lock<shared_mutex> guard(stripe.lock);
+        
+        auto it = stripe.sessions.find(token);
+        if (it == stripe.sessions.end()) {
+            continue;   // Revoked earlier
+        }
+        
+        int64_t expiresAt = it->second->expiresAt.load(memory_order_relaxed);
+        if (expiresAt <= now) {
+            delete it->second;
+            stripe.sessions.erase(it);
+            activeCount--;
+            removed++;
+        } else {
+            schedule(token, expiresAt);   // Used since it was filed
+        }
+    }
+    
+    return removed;
+}
+
+// ============ UTILITY ============
+
+size_t SessionManager::getActiveCount() const {
+    return activeCount.load();
+}
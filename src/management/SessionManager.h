@@ -0,0 +1,87 @@
+// management/SessionManager.h
+#ifndef SESSIONMANAGER_H
+#define SESSIONMANAGER_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <shared_mutex>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+using namespace std;
+
+// Who is making a request. Handed out by AuthManager at login and passed
+// to every LibraryManager operation. Only the token is trusted: it is
+// re-validated on each call, role and userID are a copy for display.
+struct SessionContext {
+    enum Role {
+        NONE,
+        ADMIN,
+        USER
+    };
+    
+    string token;
+    Role role;
+    uint64_t userID;   // 0 for the administrator (no User record)
+    
+    SessionContext() : role(NONE), userID(0) {}
+    
+    bool isLoggedIn() const { return role != NONE; }
+    bool isAdmin() const { return role == ADMIN; }
+    bool isUser() const { return role == USER; }
+};
+
+// Table of live sessions keyed by opaque random token. Validation is one
+// hash lookup under a shared stripe lock, no password work. Sessions
+// expire after SESSION_IDLE_TIMEOUT_SECONDS without use; expired entries
+// are reclaimed by a timing wheel (one bucket per tick) that is advanced
+// lazily from create() and sweepExpired(). A bucket entry whose session
+// was used since it was scheduled is simply moved to its new bucket.
+class SessionManager {
+private:
+    struct Session {
+        SessionContext::Role role;
+        uint64_t userID;
+        atomic<int64_t> expiresAt;   // Steady-clock ms; slides on validate()
+        
+        Session(SessionContext::Role role, uint64_t userID, int64_t expiresAt)
+            : role(role), userID(userID), expiresAt(expiresAt) {}
+    };
+    
+    struct Stripe {
+        shared_mutex lock;
+        unordered_map<string, Session*> sessions;
+    };
+    
+    vector<Stripe*> stripes;
+    atomic<size_t> activeCount;
+    
+    // Expiry wheel; lock order is stripe lock before wheelLock
+    mutex wheelLock;
+    vector<vector<string>> wheel;
+    int64_t lastSweptTick;
+    
+    Stripe& stripeFor(const string& token) const;
+    void schedule(const string& token, int64_t expiresAt);
+    static int64_t nowMs();
+    static int64_t tickOf(int64_t timeMs);
+    
+public:
+    SessionManager();
+    ~SessionManager();
+    
+    SessionManager(const SessionManager&) = delete;
+    SessionManager& operator=(const SessionManager&) = delete;
+    
+    // Main operations
+    string create(SessionContext::Role role, uint64_t userID);        // Returns token
+    bool validate(const string& token, SessionContext& session);      // Refreshes expiry
+    bool revoke(const string& token);
+    size_t sweepExpired();                                             // Returns removed
+    
+    // Utility
+    size_t getActiveCount() const;
+};
+
+#endif // SESSIONMANAGER_H
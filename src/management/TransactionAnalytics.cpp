@@ -0,0 +1,219 @@
+// management/TransactionAnalytics.cpp
+#include "TransactionAnalytics.h"
+#include "../utils/TimeUtils.h"
+#include "../Config.h"
+#include <algorithm>
+#include <thread>
+
+// ============ LOADING ============
+
+void TransactionAnalytics::append(const Transaction& trans) {
+    // find before emplace: emplace builds (and frees) a node even on a hit
+    auto user = userSlotOf.find(trans.getUserID());
+    if (user == userSlotOf.end()) {
+        user = userSlotOf.emplace(trans.getUserID(), static_cast<uint32_t>(userIDs.size())).first;
+        userIDs.push_back(trans.getUserID());
+    }
+    
+    auto book = bookSlotOf.find(trans.getISBN());
+    if (book == bookSlotOf.end()) {
+        book = bookSlotOf.emplace(trans.getISBN(), static_cast<uint32_t>(isbns.size())).first;
+        isbns.push_back(trans.getISBN());
+    }
+    
+    // A row older than the newest (the clock stepped back) goes to its
+    // place in time order; otherwise this is a push_back
+    int64_t time = trans.getTimestamp();
+    size_t row = times.size();
+    if (row > 0 && time < times.back()) {
+        row = upper_bound(times.begin(), times.end(), time) - times.begin();
+    }
+    
+    const string& type = trans.getType();
+    times.insert(times.begin() + row, time);
+    userSlots.insert(userSlots.begin() + row, user->second);
+    bookSlots.insert(bookSlots.begin() + row, book->second);
+    types.insert(types.begin() + row, 
+                 type == "BORROW" ? BORROW_ROW : type == "RETURN" ? RETURN_ROW : OTHER_ROW);
+}
+
+void TransactionAnalytics::rebuild(const TransactionList& list) {
+    clear();
+    times.reserve(list.size());
+    userSlots.reserve(list.size());
+    bookSlots.reserve(list.size());
+    types.reserve(list.size());
+    
+    for (size_t seq = 0; seq < list.size(); seq++) {
+        append(*list.at(seq));
+    }
+}
+
+void TransactionAnalytics::clear() {
+    times.clear();
+    userSlots.clear();
+    bookSlots.clear();
+    types.clear();
+    userIDs.clear();
+    isbns.clear();
+    userSlotOf.clear();
+    bookSlotOf.clear();
+}
+
+// ============ HELPERS ============
+
+void TransactionAnalytics::findWindow(int64_t fromMs, int64_t toMs, 
+                                      size_t& begin, size_t& end) const {
+    begin = lower_bound(times.begin(), times.end(), fromMs) - times.begin();
+    end = (fromMs < toMs) ? lower_bound(times.begin() + begin, times.end(), toMs) - times.begin()
+                          : begin;
+}
+
+// Small windows stay on the calling thread; thread start-up would cost more
+size_t TransactionAnalytics::threadsFor(size_t rows) {
+    size_t hardware = thread::hardware_concurrency();
+    size_t threads = min(static_cast<size_t>(ANALYTICS_MAX_THREADS), max<size_t>(hardware, 1));
+    return max<size_t>(1, min(threads, rows / ANALYTICS_ROWS_PER_THREAD));
+}
+
+// counts[key] = BORROW rows in [begin, end) having that key
+vector<uint64_t> TransactionAnalytics::countBorrows(const vector<uint32_t>& keys, 
+                                                    size_t keyCount, 
+                                                    size_t begin, size_t end) const {
+    size_t threadCount = threadsFor(end - begin);
+    vector<vector<uint32_t>> partials(threadCount, vector<uint32_t>(keyCount, 0));
+    
+    // 32-bit partial counts halve the merge traffic; a part would need
+    // 2^32 rows (68 GB of columns) to overflow one
+    auto countPart = [&](size_t part) {
+        size_t first = begin + (end - begin) * part / threadCount;
+        size_t last = begin + (end - begin) * (part + 1) / threadCount;
+        uint32_t* counts = partials[part].data();
+        const uint32_t* key = keys.data();
+        const uint8_t* type = types.data();
+        for (size_t row = first; row < last; row++) {
+            counts[key[row]] += (type[row] == BORROW_ROW);
+        }
+    };
+    
+    vector<thread> workers;
+    for (size_t part = 1; part < threadCount; part++) {
+        workers.emplace_back(countPart, part);
+    }
+    countPart(0);
+    for (thread& worker : workers) {
+        worker.join();
+    }
+    
+    vector<uint64_t> totals(keyCount, 0);
+    for (const vector<uint32_t>& partial : partials) {
+        for (size_t slot = 0; slot < keyCount; slot++) {
+            totals[slot] += partial[slot];
+        }
+    }
+    return totals;
+}
+
+// Highest counts first, ties by slot (first seen); zero counts dropped
+vector<uint32_t> TransactionAnalytics::topSlots(const vector<uint64_t>& counts, size_t n) {
+    vector<uint32_t> slots;
+    for (size_t slot = 0; slot < counts.size(); slot++) {
+        if (counts[slot] > 0) {
+            slots.push_back(static_cast<uint32_t>(slot));
+        }
+    }
+    
+    auto higher = [&counts](uint32_t a, uint32_t b) {
+        return counts[a] != counts[b] ? counts[a] > counts[b] : a < b;
+    };
+    n = min(n, slots.size());
+    partial_sort(slots.begin(), slots.begin() + n, slots.end(), higher);
+    slots.resize(n);
+    return slots;
+}
+
+// ============ REPORTS ============
+
+vector<BookCount> TransactionAnalytics::topBooks(int64_t fromMs, int64_t toMs, size_t n) const {
+    size_t begin, end;
+    findWindow(fromMs, toMs, begin, end);
+    
+    vector<uint64_t> counts = countBorrows(bookSlots, isbns.size(), begin, end);
+    vector<BookCount> result;
+    for (uint32_t slot : topSlots(counts, n)) {
+        result.push_back(BookCount{isbns[slot], counts[slot]});
+    }
+    return result;
+}
+
+vector<UserCount> TransactionAnalytics::topUsers(int64_t fromMs, int64_t toMs, size_t n) const {
+    size_t begin, end;
+    findWindow(fromMs, toMs, begin, end);
+    
+    vector<uint64_t> counts = countBorrows(userSlots, userIDs.size(), begin, end);
+    vector<UserCount> result;
+    for (uint32_t slot : topSlots(counts, n)) {
+        result.push_back(UserCount{userIDs[slot], counts[slot]});
+    }
+    return result;
+}
+
+// Days with no activity are omitted
+vector<DayCount> TransactionAnalytics::dailyActivity(int64_t fromMs, int64_t toMs) const {
+    vector<DayCount> result;
+    size_t begin, end;
+    findWindow(fromMs, toMs, begin, end);
+    
+    while (begin < end) {
+        int64_t day = TimeUtils::dayOf(times[begin]);
+        int64_t nextDay = TimeUtils::startOfDay(day + 1);
+        size_t dayEnd = lower_bound(times.begin() + begin, times.begin() + end, nextDay) 
+                        - times.begin();
+        
+        uint64_t borrows = 0, returns = 0;
+        const uint8_t* type = types.data();
+        for (size_t row = begin; row < dayEnd; row++) {
+            borrows += (type[row] == BORROW_ROW);
+            returns += (type[row] == RETURN_ROW);
+        }
+        
+        result.push_back(DayCount{day, borrows, returns});
+        begin = dayEnd;
+    }
+    return result;
+}
+
+// ============ COLUMN ACCESS ============
+
+Span<const uint32_t> TransactionAnalytics::getUserSlotColumn() const {
+    return userSlots;
+}
+
+Span<const uint32_t> TransactionAnalytics::getBookSlotColumn() const {
+    return bookSlots;
+}
+
+Span<const uint8_t> TransactionAnalytics::getTypeColumn() const {
+    return types;
+}
+
+size_t TransactionAnalytics::getUserCount() const {
+    return userIDs.size();
+}
+
+const vector<string>& TransactionAnalytics::getISBNs() const {
+    return isbns;
+}
+
+// ============ UTILITY ============
+
+size_t TransactionAnalytics::size() const {
+    return times.size();
+}
+
+size_t TransactionAnalytics::getMemoryUsage() const {
+    return times.capacity() * sizeof(int64_t) + 
+           userSlots.capacity() * sizeof(uint32_t) + 
+           bookSlots.capacity() * sizeof(uint32_t) + 
+           types.capacity() * sizeof(uint8_t);
+}
@@ -0,0 +1,94 @@
+// management/TransactionAnalytics.h
+#ifndef TRANSACTIONANALYTICS_H
+#define TRANSACTIONANALYTICS_H
+
+#include "../entities/Transaction.h"
+#include "TransactionList.h"
+#include "../utils/Span.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+using namespace std;
+
+struct BookCount {
+    string isbn;
+    uint64_t count;
+};
+
+struct UserCount {
+    uint64_t userID;
+    uint64_t count;
+};
+
+struct DayCount {
+    int64_t day;          // Local day number (TimeUtils::dayOf)
+    uint64_t borrows;
+    uint64_t returns;
+};
+
+// Column store of the transaction log for reports: one array per field
+// (time, user slot, book slot, type), 17 bytes a row. Users and ISBNs
+// are encoded as dense slot numbers, so group-by is an array increment
+// instead of a string hash.
+//
+// Rows are kept in time order (a record logged after a newer one, e.g.
+// after a clock step back, is inserted at its place), so a [from, to)
+// window is two binary searches. Group-by/top-N split the window across threads
+// that each fill a private count array, then merge; per-day counts are a
+// binary search per day boundary plus a branch-free (vectorisable) sum
+// over the type column.
+class TransactionAnalytics {
+public:
+    enum RowType : uint8_t {
+        BORROW_ROW,
+        RETURN_ROW,
+        OTHER_ROW
+    };
+
+private:
+    vector<int64_t> times;
+    vector<uint32_t> userSlots;
+    vector<uint32_t> bookSlots;
+    vector<uint8_t> types;
+    
+    vector<uint64_t> userIDs;                 // Slot -> user ID
+    vector<string> isbns;                     // Slot -> ISBN
+    unordered_map<uint64_t, uint32_t> userSlotOf;
+    unordered_map<string, uint32_t> bookSlotOf;
+    
+    void findWindow(int64_t fromMs, int64_t toMs, size_t& begin, size_t& end) const;
+    vector<uint64_t> countBorrows(const vector<uint32_t>& keys, size_t keyCount, 
+                                  size_t begin, size_t end) const;
+    static vector<uint32_t> topSlots(const vector<uint64_t>& counts, size_t n);
+    static size_t threadsFor(size_t rows);
+    
+public:
+    TransactionAnalytics() {}
+    
+    TransactionAnalytics(const TransactionAnalytics&) = delete;
+    TransactionAnalytics& operator=(const TransactionAnalytics&) = delete;
+    
+    // Loading (in any order; rows are placed by time)
+    void append(const Transaction& trans);
+    void rebuild(const TransactionList& list);
+    void clear();
+    
+    // Reports over [fromMs, toMs); counts are BORROW rows unless noted
+    vector<BookCount> topBooks(int64_t fromMs, int64_t toMs, size_t n) const;
+    vector<UserCount> topUsers(int64_t fromMs, int64_t toMs, size_t n) const;
+    vector<DayCount> dailyActivity(int64_t fromMs, int64_t toMs) const;   // Borrows and returns
+    
+    // Raw columns and dictionaries for other bulk consumers
+    Span<const uint32_t> getUserSlotColumn() const;
+    Span<const uint32_t> getBookSlotColumn() const;
+    Span<const uint8_t> getTypeColumn() const;
+    size_t getUserCount() const;
+    const vector<string>& getISBNs() const;           // Book slot -> ISBN
+    
+    // Utility
+    size_t size() const;
+    size_t getMemoryUsage() const;   // Column bytes
+};
+
+#endif // TRANSACTIONANALYTICS_H
@@ -0,0 +1,113 @@
+// management/TransactionCursor.cpp
+#include "TransactionCursor.h"
+#include <algorithm>
+
+// ============ CONSTRUCTORS ============
+
+TransactionCursor::TransactionCursor() 
+    : list(nullptr), source(NONE), userID(0), direction(NEWEST_FIRST), 
+      low(0), high(0), total(0), pageSize(0) {}
+
+TransactionCursor TransactionCursor::open(const TransactionList* list, Source source, 
+                                          size_t pageSize) {
+    TransactionCursor cursor;
+    cursor.list = list;
+    cursor.source = source;
+    cursor.pageSize = pageSize;
+    return cursor;
+}
+
+TransactionCursor TransactionCursor::forAll(const TransactionList* list, size_t pageSize) {
+    TransactionCursor cursor = open(list, ALL, pageSize);
+    cursor.total = cursor.high = list->size();
+    return cursor;
+}
+
+TransactionCursor TransactionCursor::forUser(const TransactionList* list, uint64_t userID, 
+                                             size_t pageSize) {
+    TransactionCursor cursor = open(list, BY_USER, pageSize);
+    cursor.userID = userID;
+    cursor.total = cursor.high = cursor.history().size();
+    return cursor;
+}
+
+TransactionCursor TransactionCursor::forBook(const TransactionList* list, const string& isbn, 
+                                             size_t pageSize) {
+    TransactionCursor cursor = open(list, BY_BOOK, pageSize);
+    cursor.isbn = isbn;
+    cursor.total = cursor.high = cursor.history().size();
+    return cursor;
+}
+
+// ============ OPTIONS ============
+
+void TransactionCursor::setDirection(Direction newDirection) {
+    direction = newDirection;
+    low = 0;
+    high = total;
+}
+
+void TransactionCursor::setTypeFilter(const string& type) {
+    typeFilter = type;
+}
+
+void TransactionCursor::seek(size_t position) {
+    if (position > total) {
+        position = total;
+    }
+    if (direction == NEWEST_FIRST) {
+        low = 0;
+        high = position;
+    } else {
+        low = position;
+        high = total;
+    }
+}
+
+// ============ PAGING ============
+
+// Fetched per page: a view is only valid until the next append
+Span<Transaction* const> TransactionCursor::history() const {
+    switch (source) {
+        case BY_USER: return list->getByUserID(userID);
+        case BY_BOOK: return list->getByISBN(isbn);
+        default:      return Span<Transaction* const>();
+    }
+}
+
+bool TransactionCursor::hasMore() const {
+    return low < high;
+}
+
+// Filtered-out records are skipped, so a page may read more than pageSize
+// entries; without a filter it reads exactly what it returns
+vector<Transaction*> TransactionCursor::nextPage() {
+    vector<Transaction*> page;
+    if (low >= high || pageSize == 0) {
+        return page;
+    }
+    
+    Span<Transaction* const> entries = history();
+    page.reserve(min(pageSize, high - low));
+    
+    while (low < high && page.size() < pageSize) {
+        size_t index = (direction == NEWEST_FIRST) ? --high : low++;
+        Transaction* trans = (source == ALL) ? list->at(index) : entries[index];
+        if (typeFilter.empty() || trans->getType() == typeFilter) {
+            page.push_back(trans);
+        }
+    }
+    return page;
+}
+
+size_t TransactionCursor::getPosition() const {
+    return (direction == NEWEST_FIRST) ? high : low;
+}
+
+size_t TransactionCursor::getRemaining() const {
+    return high - low;
+}
+
+size_t TransactionCursor::getTotal() const {
+    return total;
+}
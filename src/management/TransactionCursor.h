@@ -0,0 +1,70 @@
+// management/TransactionCursor.h
+#ifndef TRANSACTIONCURSOR_H
+#define TRANSACTIONCURSOR_H
+
+#include "TransactionList.h"
+#include "../utils/Span.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+using namespace std;
+
+// Pages through the whole log, one user's history or one book's history.
+// The cursor holds a position, not a copy: each page re-reads the live
+// log/index and costs O(page size) however long the history is. Records
+// appended after the cursor was opened are not shown, so paging is stable.
+//
+// getPosition() is a resume token: a cursor opened later on the same
+// source, with the same direction, continues where this one stopped after
+// seek(token).
+class TransactionCursor {
+public:
+    enum Source {
+        NONE,        // Empty cursor (e.g. access denied)
+        ALL,
+        BY_USER,
+        BY_BOOK
+    };
+    
+    enum Direction {
+        NEWEST_FIRST,
+        OLDEST_FIRST
+    };
+
+private:
+    const TransactionList* list;
+    Source source;
+    uint64_t userID;
+    string isbn;
+    Direction direction;
+    string typeFilter;   // Empty = every type
+    size_t low;          // Entries [low, high) not yet returned
+    size_t high;
+    size_t total;
+    size_t pageSize;
+    
+    static TransactionCursor open(const TransactionList* list, Source source, 
+                                  size_t pageSize);
+    Span<Transaction* const> history() const;
+
+public:
+    TransactionCursor();
+    static TransactionCursor forAll(const TransactionList* list, size_t pageSize);
+    static TransactionCursor forUser(const TransactionList* list, uint64_t userID, 
+                                     size_t pageSize);
+    static TransactionCursor forBook(const TransactionList* list, const string& isbn, 
+                                     size_t pageSize);
+    
+    // Options; setDirection rewinds to the start of the new direction
+    void setDirection(Direction newDirection);
+    void setTypeFilter(const string& type);   // "BORROW"/"RETURN", "" = all
+    void seek(size_t position);               // Resume from getPosition()
+    
+    bool hasMore() const;
+    vector<Transaction*> nextPage();     // At most pageSize matching records
+    size_t getPosition() const;
+    size_t getRemaining() const;         // Before type filtering
+    size_t getTotal() const;             // History length when opened
+};
+
+#endif // TRANSACTIONCURSOR_H
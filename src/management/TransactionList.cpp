@@ -1,118 +1,246 @@
 // management/TransactionList.cpp
 #include "TransactionList.h"
+#include <algorithm>
 
 // ============ CONSTRUCTOR & DESTRUCTOR ============
 
-TransactionList::TransactionList() : head(nullptr), tail(nullptr), count(0) {}
+TransactionList::TransactionList() : count(0), latestTime(INT64_MIN), lateCount(0) {}
 
 TransactionList::~TransactionList() {
     clear();
 }
 
 void TransactionList::clear() {
-    TransactionNode* current = head;
-    while (current != nullptr) {
-        TransactionNode* temp = current;
-        current = current->next;
-        delete temp->data;  // Delete Transaction object
-        delete temp;        // Delete node
-    }
-    head = tail = nullptr;
+    for (Transaction* chunk : chunks) {
+        delete[] chunk;
+    }
+    chunks.clear();
+    chunkMinTimes.clear();
+    chunkMaxTimes.clear();
     count = 0;
+    latestTime = INT64_MIN;
+    lateCount = 0;
     userTransIndex.clear();
     bookTransIndex.clear();
 }
 
 // ============ APPEND (Add at end) ============
 
-void TransactionList::append(Transaction* trans) {
-    TransactionNode* newNode = new TransactionNode(trans);
-    
-    if (tail == nullptr) {
-        // Empty list
-        head = tail = newNode;
-    } else {
-        // Add to end
-        tail->next = newNode;
-        newNode->prev = tail;
-        tail = newNode;
-    }
-    
-    count++;
-    
-    // Update indices for O(1) lookup
-    userTransIndex[trans->getUserID()].push_back(trans);
-    bookTransIndex[trans->getISBN()].push_back(trans);
+Transaction* TransactionList::append(const Transaction& trans) {
+    Transaction* stored = nextSlot();
+    *stored = trans;
+    return commit(stored);
 }
 
-// ============ PREPEND (Add at beginning) ============
+Transaction* TransactionList::append(Transaction&& trans) {
+    Transaction* stored = nextSlot();
+    *stored = move(trans);
+    return commit(stored);
+}
 
-void TransactionList::prepend(Transaction* trans) {
-    TransactionNode* newNode = new TransactionNode(trans);
-    
-    if (head == nullptr) {
-        // Empty list
-        head = tail = newNode;
+Transaction* TransactionList::nextSlot() {
+    if ((count & (CHUNK_SIZE - 1)) == 0 && (count >> CHUNK_BITS) == chunks.size()) {
+        chunks.push_back(new Transaction[CHUNK_SIZE]);   // Previous chunk full
+    }
+    return &chunks[count >> CHUNK_BITS][count & (CHUNK_SIZE - 1)];
+}
+
+// Counts the record just written to nextSlot() and indexes it. Its
+// timestamp is left as it is, even if older than the newest so far.
+Transaction* TransactionList::commit(Transaction* stored) {
+    int64_t time = stored->getTimestamp();
+    if ((count & (CHUNK_SIZE - 1)) == 0) {
+        chunkMinTimes.push_back(time);
+        chunkMaxTimes.push_back(time);
     } else {
-        // Add to beginning
-        newNode->next = head;
-        head->prev = newNode;
-        head = newNode;
+        chunkMinTimes.back() = min(chunkMinTimes.back(), time);
+        chunkMaxTimes.back() = max(chunkMaxTimes.back(), time);
+    }
+    if (time < latestTime) {
+        lateCount++;
+    } else {
+        latestTime = time;
     }
-    
     count++;
     
-    // Update indices
-    userTransIndex[trans->getUserID()].push_back(trans);
-    bookTransIndex[trans->getISBN()].push_back(trans);
+    // Update indices for O(1) lookup
+    userTransIndex[stored->getUserID()].push_back(stored);
+    bookTransIndex[stored->getISBN()].push_back(stored);
+    return stored;
+}
+
+void TransactionList::reserve(size_t records, size_t users, size_t books) {
+    chunks.reserve((records + CHUNK_SIZE - 1) >> CHUNK_BITS);
+    chunkMinTimes.reserve(chunks.capacity());
+    chunkMaxTimes.reserve(chunks.capacity());
+    userTransIndex.reserve(users);
+    bookTransIndex.reserve(books);
 }
 
 // ============ RETRIEVAL ============
 
+TransactionList::Prefix TransactionList::getPrefix() const {
+    return Prefix(chunks, count);
+}
+
+Transaction* TransactionList::at(size_t seq) const {
+    return &chunks[seq >> CHUNK_BITS][seq & (CHUNK_SIZE - 1)];
+}
+
 vector<Transaction*> TransactionList::getAll() const {
     vector<Transaction*> result;
-    TransactionNode* current = head;
+    result.reserve(count);
     
-    while (current != nullptr) {
-        result.push_back(current->data);
-        current = current->next;
+    for (size_t chunk = 0; chunk < chunks.size(); chunk++) {
+        size_t used = min(CHUNK_SIZE, count - chunk * CHUNK_SIZE);
+        for (size_t i = 0; i < used; i++) {
+            result.push_back(&chunks[chunk][i]);
+        }
     }
     
     return result;
 }
 
-vector<Transaction*> TransactionList::getByUserID(const string& userID) const {
+Span<Transaction* const> TransactionList::getByUserID(uint64_t userID) const {
     auto it = userTransIndex.find(userID);
     if (it != userTransIndex.end()) {
         return it->second;
     }
-    return vector<Transaction*>();  // Empty vector
+    return Span<Transaction* const>();  // Empty view
 }
 
-vector<Transaction*> TransactionList::getByISBN(const string& isbn) const {
+Span<Transaction* const> TransactionList::getByISBN(const string& isbn) const {
     auto it = bookTransIndex.find(isbn);
     if (it != bookTransIndex.end()) {
         return it->second;
     }
-    return vector<Transaction*>();
+    return Span<Transaction* const>();
 }
 
+// Reverse slice of the newest n sequence numbers
 vector<Transaction*> TransactionList::getRecent(int n) const {
     vector<Transaction*> result;
-    TransactionNode* current = tail;  // Start from end
+    size_t wanted = (n > 0) ? min(static_cast<size_t>(n), count) : 0;
+    result.reserve(wanted);
     
-    int count = 0;
-    while (current != nullptr && count < n) {
-        result.push_back(current->data);
-        current = current->prev;  // Move backward
-        count++;
+    for (size_t seq = count; seq > count - wanted; seq--) {
+        result.push_back(at(seq - 1));
     }
     
     return result;  // Most recent first
 }
 
+// ============ TIME RANGES ============
+
+// Binary search over the chunks' first (oldest) times, then within one
+// chunk; only valid while isTimeOrdered()
+size_t TransactionList::lowerBound(int64_t epochMs) const {
+    size_t chunk = lower_bound(chunkMinTimes.begin(), chunkMinTimes.end(), epochMs) 
+                   - chunkMinTimes.begin();
+    if (chunk == 0) {
+        return 0;   // Everything is at or after epochMs
+    }
+    
+    // The answer is in chunk - 1, or is the first record of chunk
+    const Transaction* records = chunks[chunk - 1];
+    size_t used = min(CHUNK_SIZE, count - (chunk - 1) * CHUNK_SIZE);
+    size_t low = 0, high = used;
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        if (records[mid].getTimestamp() < epochMs) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return (chunk - 1) * CHUNK_SIZE + low;
+}
+
+TransactionList::Range TransactionList::getBetween(int64_t fromMs, int64_t toMs) const {
+    if (fromMs >= toMs) {
+        return Range();
+    }
+    if (isTimeOrdered()) {
+        return Range(this, lowerBound(fromMs), lowerBound(toMs));
+    }
+    
+    // Out of order somewhere: check the records of each chunk that overlaps
+    shared_ptr<vector<Transaction*>> matches = make_shared<vector<Transaction*>>();
+    for (size_t chunk = 0; chunk < chunks.size(); chunk++) {
+        if (chunkMaxTimes[chunk] < fromMs || chunkMinTimes[chunk] >= toMs) {
+            continue;
+        }
+        size_t used = min(CHUNK_SIZE, count - chunk * CHUNK_SIZE);
+        for (size_t i = 0; i < used; i++) {
+            int64_t time = chunks[chunk][i].getTimestamp();
+            if (time >= fromMs && time < toMs) {
+                matches->push_back(&chunks[chunk][i]);
+            }
+        }
+    }
+    return Range(matches);
+}
+
+TransactionList::Range TransactionList::sliceByTime(const vector<Transaction*>& entries, 
+                                                    int64_t fromMs, int64_t toMs) const {
+    if (fromMs >= toMs) {
+        return Range();
+    }
+    
+    auto before = [](const Transaction* trans, int64_t epochMs) {
+        return trans->getTimestamp() < epochMs;
+    };
+    if (isTimeOrdered()) {
+        auto first = lower_bound(entries.begin(), entries.end(), fromMs, before);
+        auto last = lower_bound(first, entries.end(), toMs, before);
+        return Range(Span<Transaction* const>(entries.data() + (first - entries.begin()), 
+                                              static_cast<size_t>(last - first)));
+    }
+    
+    // One user's or book's history: filter it
+    shared_ptr<vector<Transaction*>> matches = make_shared<vector<Transaction*>>();
+    for (Transaction* trans : entries) {
+        if (trans->getTimestamp() >= fromMs && trans->getTimestamp() < toMs) {
+            matches->push_back(trans);
+        }
+    }
+    return Range(matches);
+}
+
+TransactionList::Range TransactionList::getByUserIDBetween(uint64_t userID, int64_t fromMs, 
+                                                           int64_t toMs) const {
+    auto it = userTransIndex.find(userID);
+    if (it == userTransIndex.end()) {
+        return Range();
+    }
+    return sliceByTime(it->second, fromMs, toMs);
+}
+
+TransactionList::Range TransactionList::getByISBNBetween(const string& isbn, int64_t fromMs, 
+                                                         int64_t toMs) const {
+    auto it = bookTransIndex.find(isbn);
+    if (it == bookTransIndex.end()) {
+        return Range();
+    }
+    return sliceByTime(it->second, fromMs, toMs);
+}
+
+bool TransactionList::isTimeOrdered() const {
+    return lateCount == 0;
+}
+
 // ============ UTILITY ============
 
 int TransactionList::getCount() const {
+    return static_cast<int>(count);
+}
+
+size_t TransactionList::size() const {
     return count;
-}
\ No newline at end of file
+}
+
+size_t TransactionList::getMemoryUsage() const {
+    return chunks.size() * CHUNK_SIZE * sizeof(Transaction) + 
+           chunks.capacity() * sizeof(Transaction*) + 
+           (chunkMinTimes.capacity() + chunkMaxTimes.capacity()) * sizeof(int64_t);
+}
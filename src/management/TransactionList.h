@@ -3,44 +3,146 @@
 #define TRANSACTIONLIST_H
 
 #include "../entities/Transaction.h"
+#include "../utils/Span.h"
 #include <vector>
 #include <unordered_map>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
 using namespace std;
 
+// Append-only transaction log. Records are stored by value in fixed-size
+// chunks of CHUNK_SIZE contiguous Transactions; a chunk is allocated when
+// the previous one fills and is never moved, so Transaction pointers stay
+// valid for the life of the log (until clear()).
+//
+// Each record has a sequence number (0 = oldest) in append order.
+// at(seq) is a shift and a mask; scans walk one chunk of contiguous
+// memory at a time.
+//
+// getByUserID/getByISBN return views of the index itself (append order),
+// valid until the next append; use TransactionCursor to page through
+// them across appends.
+//
+// Records keep the timestamp they were created with. Append order is
+// time order unless the clock stepped back; while no record is older
+// than one appended before it, [from, to) windows are found by binary
+// search: O(log n) plus the size of the result. Once one is, windows
+// are found by a scan that skips every chunk whose time span misses the
+// window, and are returned as a list of the matching records.
 class TransactionList {
-private:
-    struct TransactionNode {
-        Transaction* data;
-        TransactionNode* prev;
-        TransactionNode* next;
+public:
+    // Records in a time window, in append order: either a
+    // run of the log, or a list of records (an index slice, valid until
+    // the next append, or matches that the Range owns)
+    class Range {
+    private:
+        const TransactionList* list;                // Log run [first, last), or
+        Span<Transaction* const> entries;           // listed records if list is null
+        shared_ptr<const vector<Transaction*>> owned;
+        size_t first;
+        size_t last;
+        
+    public:
+        class Iterator {
+        private:
+            const TransactionList* list;
+            Transaction* const* entries;
+            size_t seq;
+        public:
+            Iterator(const TransactionList* list, Transaction* const* entries, size_t seq) 
+                : list(list), entries(entries), seq(seq) {}
+            Transaction* operator*() const { return list ? list->at(seq) : entries[seq]; }
+            Iterator& operator++() { seq++; return *this; }
+            bool operator!=(const Iterator& other) const { return seq != other.seq; }
+        };
+        
+        Range() : list(nullptr), first(0), last(0) {}
+        Range(const TransactionList* list, size_t first, size_t last) 
+            : list(list), first(first), last(last) {}
+        explicit Range(Span<Transaction* const> entries) 
+            : list(nullptr), entries(entries), first(0), last(entries.size()) {}
+        explicit Range(shared_ptr<const vector<Transaction*>> matches) 
+            : list(nullptr), entries(*matches), owned(matches), first(0), last(matches->size()) {}
         
-        TransactionNode(Transaction* t) 
-            : data(t), prev(nullptr), next(nullptr) {}
+        Iterator begin() const { return Iterator(list, entries.data(), first); }
+        Iterator end() const { return Iterator(list, entries.data(), last); }
+        Transaction* operator[](size_t i) const { 
+            return list ? list->at(first + i) : entries[first + i]; 
+        }
+        size_t size() const { return last - first; }
+        bool empty() const { return first == last; }
     };
     
-    TransactionNode* head;
-    TransactionNode* tail;
-    int count;
+    // The first size() records as of getPrefix(), readable from another
+    // thread while the log keeps growing (records never change once
+    // appended and chunks never move, so this copies chunk pointers only).
+    // Valid until clear().
+    class Prefix {
+    private:
+        vector<Transaction*> chunks;
+        size_t count;
+        
+    public:
+        Prefix() : count(0) {}
+        Prefix(const vector<Transaction*>& chunks, size_t count) 
+            : chunks(chunks), count(count) {}
+        
+        const Transaction* operator[](size_t seq) const {
+            return &chunks[seq >> CHUNK_BITS][seq & (CHUNK_SIZE - 1)];
+        }
+        size_t size() const { return count; }
+    };
+    
+private:
+    static const size_t CHUNK_BITS = 12;
+    static const size_t CHUNK_SIZE = size_t(1) << CHUNK_BITS;   // Records per chunk
+    
+    vector<Transaction*> chunks;     // Each holds CHUNK_SIZE records
+    vector<int64_t> chunkMinTimes;   // Oldest and newest timestamp in each chunk
+    vector<int64_t> chunkMaxTimes;
+    size_t count;
+    int64_t latestTime;              // Newest timestamp so far
+    size_t lateCount;                // Records older than one appended before them
     
     // Quick access indices
-    unordered_map<string, vector<Transaction*>> userTransIndex;   // userID -> transactions
+    unordered_map<uint64_t, vector<Transaction*>> userTransIndex; // userID -> transactions
     unordered_map<string, vector<Transaction*>> bookTransIndex;   // ISBN -> transactions
     
+    Transaction* nextSlot();
+    Transaction* commit(Transaction* stored);
+    size_t lowerBound(int64_t epochMs) const;   // First seq at or after epochMs; ordered logs
+    Range sliceByTime(const vector<Transaction*>& entries, int64_t fromMs, int64_t toMs) const;
+    
 public:
     TransactionList();
     ~TransactionList();
     
+    TransactionList(const TransactionList&) = delete;
+    TransactionList& operator=(const TransactionList&) = delete;
+    
     // Main operations
-    void append(Transaction* trans);        // Add at end O(1)
-    void prepend(Transaction* trans);       // Add at beginning O(1)
+    Transaction* append(const Transaction& trans);   // Stores a copy, O(1)
+    Transaction* append(Transaction&& trans);
+    void reserve(size_t records, size_t users, size_t books);   // Before a bulk load
+    Transaction* at(size_t seq) const;               // Oldest = 0; no bounds check
     vector<Transaction*> getAll() const;
-    vector<Transaction*> getByUserID(const string& userID) const;
-    vector<Transaction*> getByISBN(const string& isbn) const;
-    vector<Transaction*> getRecent(int n) const;
+    Prefix getPrefix() const;                        // O(chunks)
+    Span<Transaction* const> getByUserID(uint64_t userID) const;
+    Span<Transaction* const> getByISBN(const string& isbn) const;
+    vector<Transaction*> getRecent(int n) const;     // Most recent first
+    
+    // Time windows [fromMs, toMs), in append order
+    Range getBetween(int64_t fromMs, int64_t toMs) const;
+    Range getByUserIDBetween(uint64_t userID, int64_t fromMs, int64_t toMs) const;
+    Range getByISBNBetween(const string& isbn, int64_t fromMs, int64_t toMs) const;
+    bool isTimeOrdered() const;   // No record older than one appended before it
     
     // Utility
     int getCount() const;
+    size_t size() const;
+    size_t getMemoryUsage() const;   // Chunk bytes, excluding indices
     void clear();
 };
 
-#endif // TRANSACTIONLIST_H
\ No newline at end of file
+#endif // TRANSACTIONLIST_H
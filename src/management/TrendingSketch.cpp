@@ -0,0 +1,258 @@
+// management/TrendingSketch.cpp
+#include "TrendingSketch.h"
+#include "../utils/HashUtils.h"
+#include "../Config.h"
+#include <algorithm>
+#include <cmath>
+#include <climits>
+
+static const size_t CELLS_PER_BUCKET = static_cast<size_t>(TREND_SKETCH_DEPTH) * TREND_SKETCH_WIDTH;
+static const size_t USER_REGISTERS = size_t(1) << TREND_HLL_BITS;
+static const size_t BOOK_REGISTERS = size_t(1) << TREND_BOOK_HLL_BITS;
+
+TrendingSketch::TrendingSketch()
+    : newestBucket(INT64_MIN),
+      bucketCounts(TREND_BUCKETS * CELLS_PER_BUCKET, 0),
+      windowCounts(CELLS_PER_BUCKET, 0),
+      bucketBorrows(TREND_BUCKETS, 0),
+      windowBorrows(0),
+      userRegisters(TREND_BUCKETS * USER_REGISTERS, 0) {
+    heavyHitters.reserve(TREND_TOP_K);
+}
+
+// ============ HELPERS ============
+
+int64_t TrendingSketch::bucketMs() {
+    return static_cast<int64_t>(TREND_BUCKET_HOURS) * 3600 * 1000;
+}
+
+int64_t TrendingSketch::getWindowMs() {
+    return TREND_BUCKETS * bucketMs();
+}
+
+// One independent-looking column per row, derived from a single ISBN hash
+size_t TrendingSketch::cell(uint64_t hash, int row) {
+    uint64_t mixed = HashUtils::mix64(hash + (static_cast<uint64_t>(row) + 1) * 0x9E3779B97F4A7C15ULL);
+    return static_cast<size_t>(mixed & (TREND_SKETCH_WIDTH - 1));
+}
+
+// Register = top `bits` of the hash, rank = leading zeros of the rest + 1
+void TrendingSketch::addToRegisters(uint8_t* registers, int bits, uint64_t userID) {
+    uint64_t hash = HashUtils::mix64(userID ^ 0x6A09E667F3BCC909ULL);
+    size_t index = static_cast<size_t>(hash >> (64 - bits));
+    uint64_t rest = hash << bits;
+    uint8_t rank = static_cast<uint8_t>((rest == 0) ? 64 - bits + 1 : __builtin_clzll(rest) + 1);
+    if (rank > registers[index]) {
+        registers[index] = rank;
+    }
+}
+
+// Registers are TREND_BUCKETS consecutive blocks; the window's registers
+// are their element-wise max. Small cardinalities use linear counting.
+uint64_t TrendingSketch::estimateDistinct(const uint8_t* registers, int bits) {
+    size_t m = size_t(1) << bits;
+    double sum = 0.0;
+    size_t zeros = 0;
+    for (size_t j = 0; j < m; j++) {
+        uint8_t rank = 0;
+        for (int ring = 0; ring < TREND_BUCKETS; ring++) {
+            rank = max(rank, registers[ring * m + j]);
+        }
+        sum += ldexp(1.0, -rank);
+        zeros += (rank == 0) ? 1 : 0;
+    }
+
+    double alpha = 0.7213 / (1.0 + 1.079 / static_cast<double>(m));
+    double estimate = alpha * static_cast<double>(m) * static_cast<double>(m) / sum;
+    if (estimate <= 2.5 * static_cast<double>(m) && zeros > 0) {
+        estimate = static_cast<double>(m) * log(static_cast<double>(m) / static_cast<double>(zeros));
+    }
+    return static_cast<uint64_t>(llround(estimate));
+}
+
+uint64_t TrendingSketch::query(uint64_t hash) const {
+    uint32_t best = UINT32_MAX;
+    for (int row = 0; row < TREND_SKETCH_DEPTH; row++) {
+        best = min(best, windowCounts[row * TREND_SKETCH_WIDTH + cell(hash, row)]);
+    }
+    return best;
+}
+
+// Drops one bucket from the window and clears it for reuse
+void TrendingSketch::expire(size_t ring) {
+    if (bucketBorrows[ring] == 0) {
+        return;  // Nothing was recorded there
+    }
+
+    uint32_t* counts = &bucketCounts[ring * CELLS_PER_BUCKET];
+    for (size_t i = 0; i < CELLS_PER_BUCKET; i++) {
+        windowCounts[i] -= counts[i];
+    }
+    fill(counts, counts + CELLS_PER_BUCKET, 0);
+    windowBorrows -= bucketBorrows[ring];
+    bucketBorrows[ring] = 0;
+
+    fill(userRegisters.begin() + ring * USER_REGISTERS,
+         userRegisters.begin() + (ring + 1) * USER_REGISTERS, 0);
+    for (HeavyHitter& entry : heavyHitters) {
+        fill(entry.registers.begin() + ring * BOOK_REGISTERS,
+             entry.registers.begin() + (ring + 1) * BOOK_REGISTERS, 0);
+    }
+}
+
+void TrendingSketch::trackHeavyHitter(const string& isbn, uint64_t hash, size_t ring,
+                                      uint64_t userID) {
+    uint64_t estimate = query(hash);
+    HeavyHitter* entry = nullptr;
+    for (HeavyHitter& candidate : heavyHitters) {
+        if (candidate.hash == hash && candidate.isbn == isbn) {
+            entry = &candidate;
+            break;
+        }
+    }
+
+    if (entry == nullptr) {
+        if (heavyHitters.size() < static_cast<size_t>(TREND_TOP_K)) {
+            heavyHitters.push_back(HeavyHitter());
+            entry = &heavyHitters.back();
+            entry->registers.assign(TREND_BUCKETS * BOOK_REGISTERS, 0);
+        } else {
+            entry = &*min_element(heavyHitters.begin(), heavyHitters.end(),
+                                  [](const HeavyHitter& a, const HeavyHitter& b) {
+                                      return a.estimate < b.estimate;
+                                  });
+            if (estimate <= entry->estimate) {
+                return;  // Not (yet) among the top K
+            }
+            fill(entry->registers.begin(), entry->registers.end(), 0);
+        }
+        entry->isbn = isbn;
+        entry->hash = hash;
+    }
+
+    entry->estimate = estimate;
+    addToRegisters(&entry->registers[ring * BOOK_REGISTERS], TREND_BOOK_HLL_BITS, userID);
+}
+
+// ============ FEEDING ============
+
+void TrendingSketch::add(const Transaction& trans) {
+    if (trans.getType() == "BORROW") {
+        record(trans.getUserID(), trans.getISBN(), trans.getTimestamp());
+    }
+}
+
+void TrendingSketch::record(uint64_t userID, const string& isbn, int64_t timestamp) {
+    int64_t bucket = (timestamp >= 0) ? timestamp / bucketMs()
+                                      : -((-timestamp + bucketMs() - 1) / bucketMs());
+    if (newestBucket == INT64_MIN) {
+        newestBucket = bucket;
+    } else if (bucket > newestBucket) {
+        advance(timestamp);
+    } else if (bucket <= newestBucket - TREND_BUCKETS) {
+        return;  // Already outside the window
+    }
+
+    size_t ring = static_cast<size_t>(((bucket % TREND_BUCKETS) + TREND_BUCKETS) % TREND_BUCKETS);
+    uint64_t hash = HashUtils::hashString(isbn);
+    uint32_t* counts = &bucketCounts[ring * CELLS_PER_BUCKET];
+    for (int row = 0; row < TREND_SKETCH_DEPTH; row++) {
+        size_t index = row * TREND_SKETCH_WIDTH + cell(hash, row);
+        counts[index]++;
+        windowCounts[index]++;
+    }
+    bucketBorrows[ring]++;
+    windowBorrows++;
+
+    addToRegisters(&userRegisters[ring * USER_REGISTERS], TREND_HLL_BITS, userID);
+    trackHeavyHitter(isbn, hash, ring, userID);
+}
+
+void TrendingSketch::advance(int64_t nowMs) {
+    int64_t bucket = (nowMs >= 0) ? nowMs / bucketMs() : -((-nowMs + bucketMs() - 1) / bucketMs());
+    if (newestBucket == INT64_MIN || bucket <= newestBucket) {
+        return;
+    }
+
+    // Each new bucket reuses the ring slot of the one TREND_BUCKETS older
+    int64_t first = max(newestBucket + 1, bucket - TREND_BUCKETS + 1);
+    for (int64_t b = first; b <= bucket; b++) {
+        expire(static_cast<size_t>(((b % TREND_BUCKETS) + TREND_BUCKETS) % TREND_BUCKETS));
+    }
+    newestBucket = bucket;
+
+    // Re-score the heavy hitters against what is left
+    for (HeavyHitter& entry : heavyHitters) {
+        entry.estimate = query(entry.hash);
+    }
+    heavyHitters.erase(remove_if(heavyHitters.begin(), heavyHitters.end(),
+                                 [](const HeavyHitter& entry) { return entry.estimate == 0; }),
+                       heavyHitters.end());
+}
+
+// Replays the part of the log that is still inside the window
+void TrendingSketch::rebuild(const TransactionList& list, int64_t nowMs) {
+    clear();
+    for (Transaction* trans : list.getBetween(nowMs - getWindowMs(), INT64_MAX)) {
+        add(*trans);
+    }
+    advance(nowMs);
+}
+
+void TrendingSketch::clear() {
+    newestBucket = INT64_MIN;
+    fill(bucketCounts.begin(), bucketCounts.end(), 0);
+    fill(windowCounts.begin(), windowCounts.end(), 0);
+    fill(bucketBorrows.begin(), bucketBorrows.end(), 0);
+    windowBorrows = 0;
+    fill(userRegisters.begin(), userRegisters.end(), 0);
+    heavyHitters.clear();
+}
+
+// ============ QUERIES ============
+
+vector<TrendingBook> TrendingSketch::trending(size_t n) const {
+    vector<const HeavyHitter*> ranked;
+    for (const HeavyHitter& entry : heavyHitters) {
+        ranked.push_back(&entry);
+    }
+    sort(ranked.begin(), ranked.end(), [](const HeavyHitter* a, const HeavyHitter* b) {
+        return a->estimate > b->estimate;
+    });
+
+    vector<TrendingBook> result;
+    for (size_t i = 0; i < ranked.size() && i < n; i++) {
+        TrendingBook book;
+        book.isbn = ranked[i]->isbn;
+        book.borrows = ranked[i]->estimate;
+        // Distinct borrowers can't exceed borrows; HLL noise could say so
+        book.uniqueBorrowers = min(book.borrows,
+                                   estimateDistinct(ranked[i]->registers.data(),
+                                                    TREND_BOOK_HLL_BITS));
+        result.push_back(book);
+    }
+    return result;
+}
+
+uint64_t TrendingSketch::estimateBorrows(const string& isbn) const {
+    return query(HashUtils::hashString(isbn));
+}
+
+uint64_t TrendingSketch::estimateUniqueBorrowers() const {
+    return min(windowBorrows, estimateDistinct(userRegisters.data(), TREND_HLL_BITS));
+}
+
+uint64_t TrendingSketch::getWindowBorrows() const {
+    return windowBorrows;
+}
+
+size_t TrendingSketch::getMemoryUsage() const {
+    size_t bytes = bucketCounts.size() * sizeof(uint32_t)
+                 + windowCounts.size() * sizeof(uint32_t)
+                 + bucketBorrows.size() * sizeof(uint64_t)
+                 + userRegisters.size();
+    for (const HeavyHitter& entry : heavyHitters) {
+        bytes += sizeof(HeavyHitter) + entry.registers.size() + entry.isbn.capacity();
+    }
+    return bytes;
+}
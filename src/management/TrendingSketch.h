@@ -0,0 +1,85 @@
+// management/TrendingSketch.h
+#ifndef TRENDINGSKETCH_H
+#define TRENDINGSKETCH_H
+
+#include "../entities/Transaction.h"
+#include "TransactionList.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+using namespace std;
+
+struct TrendingBook {
+    string isbn;
+    uint64_t borrows;            // Count-min estimate (never below the true count)
+    uint64_t uniqueBorrowers;    // HyperLogLog estimate
+};
+
+// Fixed-size summary of recent borrowing (see TREND_* in Config.h for
+// the window and error bounds). Memory does not grow with books, users
+// or traffic: about 1.2 MB at the default settings.
+//
+// The window is a ring of time buckets. Each bucket has its own
+// count-min sketch of borrows per ISBN and HyperLogLog registers of
+// borrower IDs; windowCounts holds the sum of the live buckets' sketches,
+// so a point query is TREND_SKETCH_DEPTH reads. When a bucket falls out
+// of the window its counters are subtracted from the sum and zeroed.
+//
+// Heavy hitters are the TREND_TOP_K books with the highest estimates,
+// updated on each borrow (a newcomer replaces the lowest entry when it
+// overtakes it) and re-scored whenever a bucket expires. A book that
+// only overtakes the list through expiry joins it on its next borrow.
+// Each tracked book keeps its own small per-bucket HyperLogLog; borrowers
+// from before it joined the list are not counted.
+class TrendingSketch {
+private:
+    struct HeavyHitter {
+        string isbn;
+        uint64_t hash;
+        uint64_t estimate;
+        vector<uint8_t> registers;   // TREND_BUCKETS x 2^TREND_BOOK_HLL_BITS
+    };
+
+    int64_t newestBucket;            // Absolute bucket number; INT64_MIN when empty
+    vector<uint32_t> bucketCounts;   // TREND_BUCKETS x DEPTH x WIDTH
+    vector<uint32_t> windowCounts;   // DEPTH x WIDTH, sum of the live buckets
+    vector<uint64_t> bucketBorrows;  // Exact borrows per bucket
+    uint64_t windowBorrows;
+    vector<uint8_t> userRegisters;   // TREND_BUCKETS x 2^TREND_HLL_BITS
+    vector<HeavyHitter> heavyHitters;
+
+    static int64_t bucketMs();
+    static size_t cell(uint64_t hash, int row);
+    static void addToRegisters(uint8_t* registers, int bits, uint64_t userID);
+    static uint64_t estimateDistinct(const uint8_t* registers, int bits);   // Over all buckets
+
+    uint64_t query(uint64_t hash) const;
+    void expire(size_t ring);
+    void trackHeavyHitter(const string& isbn, uint64_t hash, size_t ring, uint64_t userID);
+
+public:
+    TrendingSketch();
+
+    TrendingSketch(const TrendingSketch&) = delete;
+    TrendingSketch& operator=(const TrendingSketch&) = delete;
+
+    // Feeding (BORROW records only; others and records older than the
+    // window are ignored)
+    void add(const Transaction& trans);
+    void record(uint64_t userID, const string& isbn, int64_t timestamp);
+    void advance(int64_t nowMs);     // Expires buckets that left the window
+    void rebuild(const TransactionList& list, int64_t nowMs);
+    void clear();
+
+    // Queries over the current window
+    vector<TrendingBook> trending(size_t n) const;   // Most borrowed first
+    uint64_t estimateBorrows(const string& isbn) const;
+    uint64_t estimateUniqueBorrowers() const;
+    uint64_t getWindowBorrows() const;               // Exact
+
+    // Utility
+    static int64_t getWindowMs();
+    size_t getMemoryUsage() const;
+};
+
+#endif // TRENDINGSKETCH_H
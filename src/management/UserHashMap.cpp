@@ -1,179 +1,218 @@
 // management/UserHashMap.cpp
 #include "UserHashMap.h"
+#include "../utils/StringUtils.h"
 
 // ============ CONSTRUCTOR & DESTRUCTOR ============
 
 UserHashMap::UserHashMap() : UserHashMap(INITIAL_HASH_TABLE_SIZE) {}
 
-UserHashMap::UserHashMap(int size) : tableSize(size), count(0) {
-    userIDTable = new HashNode*[tableSize];
-    usernameTable = new HashNode*[tableSize];
-    
-    for (int i = 0; i < tableSize; i++) {
-        userIDTable[i] = nullptr;
-        usernameTable[i] = nullptr;
-    }
+UserHashMap::UserHashMap(int size) : activeCount(0) {
+    users.reserve(size);
+    usernames.reserve(size);
+    userIDTable = new UserIndex(UserIndex::BY_USER_ID, this, size);
+    usernameTable = new UserIndex(UserIndex::BY_USERNAME, this, size);
+    emailTable = new UserIndex(UserIndex::BY_EMAIL, this, size);
+    phoneTable = new UserIndex(UserIndex::BY_PHONE, this, size);
 }
 
 UserHashMap::~UserHashMap() {
-    clear();
-    delete[] userIDTable;
-    delete[] usernameTable;
+    delete userIDTable;
+    delete usernameTable;
+    delete emailTable;
+    delete phoneTable;
 }
 
 void UserHashMap::clear() {
-    clearTable(userIDTable);
-    clearTable(usernameTable);
-    count = 0;
-}
-
-void UserHashMap::clearTable(HashNode** table) {
-    for (int i = 0; i < tableSize; i++) {
-        HashNode* current = table[i];
-        while (current != nullptr) {
-            HashNode* temp = current;
-            current = current->next;
-            
-            // Only delete User* once (from userIDTable)
-            if (table == userIDTable) {
-                delete temp->value;
-            }
-            delete temp;
-        }
-        table[i] = nullptr;
-    }
+    userIDTable->clear();
+    usernameTable->clear();
+    emailTable->clear();
+    phoneTable->clear();
+    users.clear();
+    usernames.clear();
+    activeCount = 0;
 }
 
-// ============ HASH FUNCTION ============
+// ============ RECORD ACCESS ============
 
-int UserHashMap::hashFunction(const string& key) const {
-    unsigned long hash = 5381;
-    for (char c : key) {
-        hash = ((hash << 5) + hash) + c;  // hash * 33 + c
+const User& UserHashMap::recordAt(uint32_t record) const {
+    return users[record];
+}
+
+const string& UserHashMap::usernameAt(uint32_t record) const {
+    return usernames[record];
+}
+
+User* UserHashMap::resolve(uint32_t record) const {
+    if (record == UserIndex::NOT_FOUND) {
+        return nullptr;
     }
-    return hash % tableSize;
+    return const_cast<User*>(&users[record]);
 }
 
 // ============ INSERT ============
 
-void UserHashMap::insert(User* user) {
+User* UserHashMap::insert(const User& user) {
     // FIX #5: Validate both tables before inserting
-    if (existsInTable(userIDTable, user->getUserID()) ||
-        existsInTable(usernameTable, user->getUsername())) {
-        return;  // Already exists, don't insert
+    if (userIDTable->findID(user.getID()) != UserIndex::NOT_FOUND ||
+        usernameTable->find(user.getUsername()) != UserIndex::NOT_FOUND) {
+        return nullptr;  // Already exists, don't insert
     }
     
-    // Insert into both tables
-    insertIntoTable(userIDTable, user->getUserID(), user);
-    insertIntoTable(usernameTable, user->getUsername(), user);
-    count++;
+    // Append to the dense array, then index the new position
+    uint32_t record = static_cast<uint32_t>(users.size());
+    users.push_back(user);
+    usernames.push_back(user.getUsername());
+    
+    userIDTable->insert(record);
+    usernameTable->insert(record);
+    indexContact(record);
+    if (user.isActive()) {
+        activeCount++;
+    }
+    return &users.back();
 }
 
-void UserHashMap::insertIntoTable(HashNode** table, const string& key, User* user) {
-    int index = hashFunction(key);
-    
-    // Insert at beginning of chain (O(1))
-    HashNode* newNode = new HashNode(key, user);
-    newNode->next = table[index];
-    table[index] = newNode;
+// Blank email/phone values are not indexed
+void UserHashMap::indexContact(uint32_t record) {
+    if (!StringUtils::normalizeEmail(users[record].getEmail()).empty()) {
+        emailTable->insertMulti(record);
+    }
+    if (!StringUtils::normalizePhone(users[record].getPhoneNumber()).empty()) {
+        phoneTable->insertMulti(record);
+    }
+}
+
+void UserHashMap::unindexContact(uint32_t record) {
+    emailTable->erase(record);
+    phoneTable->erase(record);
+}
+
+void UserHashMap::reserve(size_t count) {
+    users.reserve(count);
+    usernames.reserve(count);
+    userIDTable->reserve(count);
+    usernameTable->reserve(count);
+    emailTable->reserve(count);
+    phoneTable->reserve(count);
 }
 
 // ============ SEARCH ============
 
-User* UserHashMap::searchByID(const string& userID) const {
-    return searchInTable(userIDTable, userID);
+User* UserHashMap::searchByID(uint64_t userID) const {
+    return resolve(userIDTable->findID(userID));
 }
 
 User* UserHashMap::searchByUsername(const string& username) const {
-    return searchInTable(usernameTable, username);
+    return resolve(usernameTable->find(username));
 }
 
-User* UserHashMap::searchInTable(HashNode** table, const string& key) const {
-    int index = hashFunction(key);
-    HashNode* current = table[index];
-    
-    while (current != nullptr) {
-        if (current->key == key) {
-            return current->value;
-        }
-        current = current->next;
+User* UserHashMap::searchByEmail(const string& email) const {
+    return resolve(emailTable->find(email));
+}
+
+vector<User*> UserHashMap::searchByPhone(const string& phone) const {
+    vector<User*> result;
+    for (uint32_t record : phoneTable->findAll(phone)) {
+        result.push_back(resolve(record));
     }
-    return nullptr;
+    return result;
 }
 
-// ============ REMOVE ============
+// ============ UPDATE ============
 
-bool UserHashMap::remove(const string& userID) {
-    // FIX #5: Get username before removing
+bool UserHashMap::updateContact(uint64_t userID, const string& email, 
+                                const string& phone) {
+    uint32_t record = userIDTable->findID(userID);
+    if (record == UserIndex::NOT_FOUND) {
+        return false;
+    }
+    
+    // Unindex under the old keys before they change
+    unindexContact(record);
+    users[record].updateContact(email, phone);
+    indexContact(record);
+    return true;
+}
+
+bool UserHashMap::setActive(uint64_t userID, bool status) {
     User* user = searchByID(userID);
     if (user == nullptr) {
         return false;
     }
     
-    string username = user->getUsername();
-    
-    // Remove from both tables
-    bool removed1 = removeFromTable(userIDTable, userID);
-    bool removed2 = removeFromTable(usernameTable, username);
-    
-    if (removed1 && removed2) {
-        delete user;  // Delete the User object
-        count--;
-        return true;
+    if (user->isActive() != status) {
+        activeCount += status ? 1 : -1;
+        user->setActive(status);
     }
-    
-    return false;
+    return true;
 }
 
-bool UserHashMap::removeFromTable(HashNode** table, const string& key) {
-    int index = hashFunction(key);
-    HashNode* current = table[index];
-    HashNode* prev = nullptr;
+// ============ REMOVE ============
+
+bool UserHashMap::remove(uint64_t userID) {
+    uint32_t record = userIDTable->findID(userID);
+    if (record == UserIndex::NOT_FOUND) {
+        return false;
+    }
     
-    while (current != nullptr) {
-        if (current->key == key) {
-            if (prev == nullptr) {
-                table[index] = current->next;
-            } else {
-                prev->next = current->next;
-            }
-            delete current;  // Delete the node (but not the User*)
-            return true;
-        }
-        prev = current;
-        current = current->next;
+    if (users[record].isActive()) {
+        activeCount--;
     }
-    return false;
+    
+    // Drop the record's keys while it is still readable
+    userIDTable->erase(record);
+    usernameTable->erase(record);
+    unindexContact(record);
+    
+    // Swap-remove: move the last user into the hole and repoint its keys
+    uint32_t last = static_cast<uint32_t>(users.size() - 1);
+    if (record != last) {
+        userIDTable->relocate(last, record);
+        usernameTable->relocate(last, record);
+        emailTable->relocate(last, record);
+        phoneTable->relocate(last, record);
+        users[record] = std::move(users[last]);
+        usernames[record] = std::move(usernames[last]);
+    }
+    users.pop_back();
+    usernames.pop_back();
+    return true;
 }
 
 // ============ UTILITY ============
 
 int UserHashMap::getCount() const {
-    return count;
+    return static_cast<int>(users.size());
+}
+
+int UserHashMap::getActiveCount() const {
+    return activeCount;
 }
 
 bool UserHashMap::existsUsername(const string& username) const {
-    return existsInTable(usernameTable, username);
+    return usernameTable->find(username) != UserIndex::NOT_FOUND;
 }
 
-bool UserHashMap::existsUserID(const string& userID) const {
-    return existsInTable(userIDTable, userID);
+bool UserHashMap::existsUserID(uint64_t userID) const {
+    return userIDTable->findID(userID) != UserIndex::NOT_FOUND;
 }
 
-bool UserHashMap::existsInTable(HashNode** table, const string& key) const {
-    return searchInTable(table, key) != nullptr;
+bool UserHashMap::existsEmail(const string& email) const {
+    return emailTable->find(email) != UserIndex::NOT_FOUND;
 }
 
-vector<User*> UserHashMap::getAllUsers() const {
-    vector<User*> result;
-    
-    for (int i = 0; i < tableSize; i++) {
-        HashNode* current = userIDTable[i];
-        while (current != nullptr) {
-            result.push_back(current->value);
-            current = current->next;
+size_t UserHashMap::getMemoryUsage() const {
+    size_t bytes = userIDTable->getMemoryUsage() + usernameTable->getMemoryUsage() +
+                   emailTable->getMemoryUsage() + phoneTable->getMemoryUsage();
+    bytes += usernames.capacity() * sizeof(string);
+    for (const string& username : usernames) {
+        if (username.capacity() > 15) {
+            bytes += username.capacity() + 1;   // Beyond the inline buffer
         }
     }
-    
-    return result;
-}
\ No newline at end of file
+    return bytes;
+}
+
+Span<const User> UserHashMap::getAllUsers() const {
+    return Span<const User>(users.data(), users.size());
+}
@@ -4,31 +4,36 @@
 
 #include "../entities/User.h"
 #include "../Config.h"
+#include "../utils/Span.h"
+#include "UserIndex.h"
 #include <vector>
 using namespace std;
 
-class UserHashMap {
+// Users live by value in one dense array; deletion swaps the last user
+// into the hole. The hash indexes map keys to positions in that array, so
+// full scans (getAllUsers) are a linear walk over contiguous memory.
+//
+// User pointers returned by the search methods stay valid until the next
+// insert or remove.
+//
+// Not synchronised: only the thread that owns LibraryManager uses it
+// (login workers get the stored hash, never the map).
+class UserHashMap : private UserIndex::RecordSource {
 private:
-    struct HashNode {
-        string key;
-        User* value;
-        HashNode* next;
-        
-        HashNode(string k, User* v) : key(k), value(v), next(nullptr) {}
-    };
-    
-    HashNode** userIDTable;      // Hash by userID
-    HashNode** usernameTable;    // Hash by username
-    int tableSize;
-    int count;
+    vector<User> users;          // Dense user storage
+    vector<string> usernames;    // usernames[i] == users[i].getUsername(), packed for probing
+    UserIndex* userIDTable;      // Hash by integer userID
+    UserIndex* usernameTable;    // Hash by username
+    UserIndex* emailTable;       // Hash by normalized email (may repeat)
+    UserIndex* phoneTable;       // Hash by digits-only phone (may repeat)
+    int activeCount;             // Maintained on insert/remove/setActive
     
     // Private helpers
-    int hashFunction(const string& key) const;
-    void insertIntoTable(HashNode** table, const string& key, User* user);
-    User* searchInTable(HashNode** table, const string& key) const;
-    bool removeFromTable(HashNode** table, const string& key);
-    bool existsInTable(HashNode** table, const string& key) const;
-    void clearTable(HashNode** table);
+    const User& recordAt(uint32_t record) const override;
+    const string& usernameAt(uint32_t record) const override;
+    User* resolve(uint32_t record) const;
+    void indexContact(uint32_t record);
+    void unindexContact(uint32_t record);
     
 public:
     UserHashMap();
@@ -36,17 +41,27 @@ public:
     ~UserHashMap();
     
     // Main operations
-    void insert(User* user);
-    User* searchByID(const string& userID) const;
+    User* insert(const User& user);   // Copy of user; nullptr on duplicate
+    void reserve(size_t count);       // Before a bulk load
+    User* searchByID(uint64_t userID) const;
     User* searchByUsername(const string& username) const;
-    bool remove(const string& userID);
-    vector<User*> getAllUsers() const;
+    bool remove(uint64_t userID);
+    Span<const User> getAllUsers() const;
+    
+    // Secondary lookups (keys are normalized before hashing)
+    User* searchByEmail(const string& email) const;
+    vector<User*> searchByPhone(const string& phone) const;
+    bool updateContact(uint64_t userID, const string& email, const string& phone);
+    bool setActive(uint64_t userID, bool status);
     
     // Utility
     int getCount() const;
+    int getActiveCount() const;
     bool existsUsername(const string& username) const;
-    bool existsUserID(const string& userID) const;
+    bool existsUserID(uint64_t userID) const;
+    bool existsEmail(const string& email) const;
+    size_t getMemoryUsage() const;  // Index bytes and username copies, excluding User objects
     void clear();
 };
 
-#endif // USERHASHMAP_H
\ No newline at end of file
+#endif // USERHASHMAP_H
@@ -0,0 +1,410 @@
+// management/UserIndex.cpp
+#include "UserIndex.h"
+#include "../utils/HashUtils.h"
+#include "../utils/StringUtils.h"
+#include "../Config.h"
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define USERINDEX_USE_SSE2 1
+#endif
+
+// ============ CONSTRUCTOR & DESTRUCTOR ============
+
+UserIndex::UserIndex(KeyField field, const RecordSource* source)
+    : UserIndex(field, source, INITIAL_HASH_TABLE_SIZE) {}
+
+UserIndex::UserIndex(KeyField field, const RecordSource* source, size_t initialCapacity)
+    : ctrl(nullptr), slots(nullptr), capacity(0), count(0), tombstones(0), 
+      field(field), source(source) {
+    allocate(roundUpCapacity(initialCapacity));
+}
+
+UserIndex::~UserIndex() {
+    delete[] ctrl;
+    delete[] slots;
+}
+
+void UserIndex::allocate(size_t newCapacity) {
+    capacity = newCapacity;
+    ctrl = new int8_t[capacity];
+    slots = new uint32_t[capacity];
+    memset(ctrl, CTRL_EMPTY, capacity);
+    for (size_t i = 0; i < capacity; i++) {
+        slots[i] = NOT_FOUND;
+    }
+}
+
+void UserIndex::clear() {
+    memset(ctrl, CTRL_EMPTY, capacity);
+    for (size_t i = 0; i < capacity; i++) {
+        slots[i] = NOT_FOUND;
+    }
+    count = 0;
+    tombstones = 0;
+}
+
+// ============ HASHING & GROUP MATCHING ============
+
+bool UserIndex::isNormalized() const {
+    return field == BY_EMAIL || field == BY_PHONE;
+}
+
+string UserIndex::normalize(const string& key) const {
+    switch (field) {
+        case BY_EMAIL: return StringUtils::normalizeEmail(key);
+        case BY_PHONE: return StringUtils::normalizePhone(key);
+        default:       return key;
+    }
+}
+
+// String-keyed fields only (BY_USER_ID is an integer key)
+const string& UserIndex::rawKeyOf(uint32_t record) const {
+    const User& user = source->recordAt(record);
+    switch (field) {
+        case BY_EMAIL: return user.getEmail();
+        case BY_PHONE: return user.getPhoneNumber();
+        default:       return source->usernameAt(record);
+    }
+}
+
+// Equality for short keys without a memcmp call: up to 16 bytes are two
+// overlapping 8-byte (or 4-byte) loads per side
+static inline bool sameText(const string& a, const string& b) {
+    size_t len = a.size();
+    if (len != b.size()) {
+        return false;
+    }
+    const char* x = a.data();
+    const char* y = b.data();
+    if (len >= 8 && len <= 16) {
+        uint64_t x0, x1, y0, y1;
+        memcpy(&x0, x, 8);
+        memcpy(&x1, x + len - 8, 8);
+        memcpy(&y0, y, 8);
+        memcpy(&y1, y + len - 8, 8);
+        return ((x0 ^ y0) | (x1 ^ y1)) == 0;
+    }
+    if (len >= 4 && len < 8) {
+        uint32_t x0, x1, y0, y1;
+        memcpy(&x0, x, 4);
+        memcpy(&x1, x + len - 4, 4);
+        memcpy(&y0, y, 4);
+        memcpy(&y1, y + len - 4, 4);
+        return ((x0 ^ y0) | (x1 ^ y1)) == 0;
+    }
+    return memcmp(x, y, len) == 0;
+}
+
+// key is already normalized; ID/username compare without copying
+bool UserIndex::keyMatches(uint32_t record, const string& key) const {
+    if (isNormalized()) {
+        return sameText(normalize(rawKeyOf(record)), key);
+    }
+    return sameText(rawKeyOf(record), key);
+}
+
+uint64_t UserIndex::hashOf(uint32_t record) const {
+    if (field == BY_USER_ID) {
+        return hashID(source->recordAt(record).getID());
+    }
+    if (isNormalized()) {
+        return hashKey(normalize(rawKeyOf(record)));
+    }
+    return hashKey(rawKeyOf(record));
+}
+
+uint64_t UserIndex::hashKey(const string& key) {
+    return HashUtils::hashString(key);
+}
+
+uint64_t UserIndex::hashID(uint64_t id) {
+    return HashUtils::mix64(id);
+}
+
+size_t UserIndex::roundUpCapacity(size_t requested) {
+    size_t cap = GROUP_SIZE;
+    while (cap < requested) {
+        cap <<= 1;
+    }
+    return cap;
+}
+
+// Each match returns a 16-bit mask with bit i set when group[i] matches
+uint32_t UserIndex::matchByte(const int8_t* group, int8_t value) {
+#ifdef USERINDEX_USE_SSE2
+    __m128i ctrlBytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+    return static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(value), ctrlBytes)));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < GROUP_SIZE; i++) {
+        if (group[i] == value) mask |= (1u << i);
+    }
+    return mask;
+#endif
+}
+
+uint32_t UserIndex::matchEmpty(const int8_t* group) {
+    return matchByte(group, CTRL_EMPTY);
+}
+
+uint32_t UserIndex::matchEmptyOrDeleted(const int8_t* group) {
+#ifdef USERINDEX_USE_SSE2
+    // EMPTY and DELETED are the only control bytes with the high bit set
+    __m128i ctrlBytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+    return static_cast<uint32_t>(_mm_movemask_epi8(ctrlBytes));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < GROUP_SIZE; i++) {
+        if (group[i] < 0) mask |= (1u << i);
+    }
+    return mask;
+#endif
+}
+
+static inline int lowestBit(uint32_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(mask);
+#else
+    int bit = 0;
+    while ((mask & 1u) == 0) {
+        mask >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+// ============ PROBING ============
+
+// Probe sequence visits whole groups: g, g+1, g+3, g+6, ... (triangular),
+// which covers every group when the group count is a power of two.
+// Returns the first slot whose record satisfies matches(), or capacity.
+template<typename Match>
+size_t UserIndex::probe(uint64_t hash, Match matches) const {
+    size_t groupMask = (capacity / GROUP_SIZE) - 1;
+    size_t group = (hash >> 7) & groupMask;
+    int8_t fingerprint = static_cast<int8_t>(hash & 0x7F);
+
+    for (size_t step = 1; step <= groupMask + 1; step++) {
+        const int8_t* groupCtrl = ctrl + group * GROUP_SIZE;
+
+        uint32_t candidates = matchByte(groupCtrl, fingerprint);
+        while (candidates != 0) {
+            size_t index = group * GROUP_SIZE + lowestBit(candidates);
+            if (matches(slots[index])) {
+                return index;
+            }
+            candidates &= candidates - 1;
+        }
+
+        if (matchEmpty(groupCtrl) != 0) {
+            return capacity;  // Chain ends here: not found
+        }
+        group = (group + step) & groupMask;
+    }
+    return capacity;
+}
+
+size_t UserIndex::findSlot(const string& key, uint64_t hash) const {
+    if (field == BY_USERNAME) {
+        return probe(hash, [&](uint32_t record) { return sameText(source->usernameAt(record), key); });
+    }
+    return probe(hash, [&](uint32_t record) { return keyMatches(record, key); });
+}
+
+size_t UserIndex::findIDSlot(uint64_t id, uint64_t hash) const {
+    return probe(hash, [&](uint32_t record) { return source->recordAt(record).getID() == id; });
+}
+
+// Matches the exact record number (needed for multi-valued indexes, where
+// several slots share a key)
+size_t UserIndex::findEntry(uint32_t record, uint64_t hash) const {
+    return probe(hash, [&](uint32_t candidate) { return candidate == record; });
+}
+
+size_t UserIndex::findInsertSlot(uint64_t hash) const {
+    size_t groupMask = (capacity / GROUP_SIZE) - 1;
+    size_t group = (hash >> 7) & groupMask;
+
+    for (size_t step = 1; step <= groupMask + 1; step++) {
+        uint32_t free = matchEmptyOrDeleted(ctrl + group * GROUP_SIZE);
+        if (free != 0) {
+            return group * GROUP_SIZE + lowestBit(free);
+        }
+        group = (group + step) & groupMask;
+    }
+    return capacity;  // Unreachable while load factor < 1
+}
+
+// ============ INSERT ============
+
+bool UserIndex::insert(uint32_t record) {
+    uint64_t hash = hashOf(record);
+    if (field == BY_USER_ID) {
+        if (findIDSlot(source->recordAt(record).getID(), hash) != capacity) {
+            return false;  // Duplicate ID
+        }
+        insertHashed(record, hash);
+        return true;
+    }
+
+    string normalizedKey = isNormalized() ? normalize(rawKeyOf(record)) : string();
+    const string& key = isNormalized() ? normalizedKey : rawKeyOf(record);
+
+    if (findSlot(key, hash) != capacity) {
+        return false;  // Duplicate key
+    }
+
+    insertHashed(record, hash);
+    return true;
+}
+
+void UserIndex::insertMulti(uint32_t record) {
+    insertHashed(record, hashOf(record));
+}
+
+void UserIndex::insertHashed(uint32_t record, uint64_t hash) {
+    // Grow (or just purge tombstones) before crossing the load limit
+    if (static_cast<double>(count + tombstones + 1) > capacity * MAX_LOAD_FACTOR) {
+        size_t newCapacity = (count + 1 > capacity * MAX_LOAD_FACTOR / 2)
+                             ? capacity * 2 : capacity;
+        rehash(newCapacity);
+    }
+
+    size_t index = findInsertSlot(hash);
+    if (ctrl[index] == CTRL_DELETED) {
+        tombstones--;
+    }
+    ctrl[index] = static_cast<int8_t>(hash & 0x7F);
+    slots[index] = record;
+    count++;
+}
+
+void UserIndex::rehash(size_t newCapacity) {
+    int8_t* oldCtrl = ctrl;
+    uint32_t* oldSlots = slots;
+    size_t oldCapacity = capacity;
+
+    allocate(newCapacity);
+    tombstones = 0;
+
+    for (size_t i = 0; i < oldCapacity; i++) {
+        if (oldCtrl[i] >= 0) {
+            uint64_t hash = hashOf(oldSlots[i]);
+            size_t index = findInsertSlot(hash);
+            ctrl[index] = static_cast<int8_t>(hash & 0x7F);
+            slots[index] = oldSlots[i];
+        }
+    }
+
+    delete[] oldCtrl;
+    delete[] oldSlots;
+}
+
+// Grows once up front instead of doubling its way there
+void UserIndex::reserve(size_t records) {
+    size_t needed = roundUpCapacity(static_cast<size_t>(records / MAX_LOAD_FACTOR) + 1);
+    if (needed > capacity) {
+        rehash(needed);
+    }
+}
+
+// ============ SEARCH ============
+
+uint32_t UserIndex::find(const string& key) const {
+    if (isNormalized()) {
+        string normalizedKey = normalize(key);
+        size_t index = findSlot(normalizedKey, hashKey(normalizedKey));
+        return (index != capacity) ? slots[index] : NOT_FOUND;
+    }
+    size_t index = findSlot(key, hashKey(key));
+    return (index != capacity) ? slots[index] : NOT_FOUND;
+}
+
+uint32_t UserIndex::findID(uint64_t id) const {
+    size_t index = findIDSlot(id, hashID(id));
+    return (index != capacity) ? slots[index] : NOT_FOUND;
+}
+
+vector<uint32_t> UserIndex::findAll(const string& key) const {
+    vector<uint32_t> result;
+    string normalizedKey = normalize(key);
+    uint64_t hash = hashKey(normalizedKey);
+
+    size_t groupMask = (capacity / GROUP_SIZE) - 1;
+    size_t group = (hash >> 7) & groupMask;
+    int8_t fingerprint = static_cast<int8_t>(hash & 0x7F);
+
+    for (size_t step = 1; step <= groupMask + 1; step++) {
+        const int8_t* groupCtrl = ctrl + group * GROUP_SIZE;
+
+        uint32_t candidates = matchByte(groupCtrl, fingerprint);
+        while (candidates != 0) {
+            size_t index = group * GROUP_SIZE + lowestBit(candidates);
+            if (keyMatches(slots[index], normalizedKey)) {
+                result.push_back(slots[index]);
+            }
+            candidates &= candidates - 1;
+        }
+
+        if (matchEmpty(groupCtrl) != 0) {
+            break;
+        }
+        group = (group + step) & groupMask;
+    }
+    return result;
+}
+
+// ============ REMOVE ============
+
+bool UserIndex::erase(uint32_t record) {
+    size_t index = findEntry(record, hashOf(record));
+    if (index == capacity) {
+        return false;
+    }
+
+    // A group that still has an EMPTY byte never stopped a probe, so the
+    // slot can go straight back to EMPTY; otherwise leave a tombstone.
+    const int8_t* groupCtrl = ctrl + (index / GROUP_SIZE) * GROUP_SIZE;
+    if (matchEmpty(groupCtrl) != 0) {
+        ctrl[index] = CTRL_EMPTY;
+    } else {
+        ctrl[index] = CTRL_DELETED;
+        tombstones++;
+    }
+    slots[index] = NOT_FOUND;
+    count--;
+    return true;
+}
+
+// Keys are unchanged by a move, so only the slot payload is rewritten.
+// Call while the record is still readable at `from`.
+bool UserIndex::relocate(uint32_t from, uint32_t to) {
+    size_t index = findEntry(from, hashOf(from));
+    if (index == capacity) {
+        return false;
+    }
+    slots[index] = to;
+    return true;
+}
+
+// ============ UTILITY ============
+
+size_t UserIndex::getCapacity() const {
+    return capacity;
+}
+
+uint32_t UserIndex::slotAt(size_t index) const {
+    return (ctrl[index] >= 0) ? slots[index] : NOT_FOUND;
+}
+
+size_t UserIndex::getCount() const {
+    return count;
+}
+
+size_t UserIndex::getMemoryUsage() const {
+    return sizeof(UserIndex) + capacity * (sizeof(int8_t) + sizeof(uint32_t));
+}
@@ -0,0 +1,112 @@
+// management/UserIndex.h
+#ifndef USERINDEX_H
+#define USERINDEX_H
+
+#include "../entities/User.h"
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+using namespace std;
+
+// Open-addressing hash index over User records (Swiss-table layout).
+// One control byte per slot holds a 7-bit hash fingerprint or an
+// EMPTY/DELETED marker; slots hold only a 32-bit record number, and the
+// key is read back from the record (through a RecordSource) on a
+// fingerprint hit. Control bytes are probed 16 at a time with SSE2 where
+// available.
+//
+// BY_USER_ID is keyed on the integer ID (findID); the other fields are
+// string keys (find/findAll).
+//
+// Email and phone keys are normalized (StringUtils::normalizeEmail /
+// normalizePhone) both when indexing and when looking up. Those indexes
+// may hold several records under one key (insertMulti), e.g. a shared
+// household phone number.
+class UserIndex {
+public:
+    enum KeyField {
+        BY_USER_ID,
+        BY_USERNAME,
+        BY_EMAIL,
+        BY_PHONE
+    };
+
+    // Where record numbers resolve to users (e.g. a dense user array).
+    // usernameAt may be overridden with a packed copy of the usernames so
+    // a username probe does not have to touch the whole User record.
+    class RecordSource {
+    public:
+        virtual ~RecordSource() {}
+        virtual const User& recordAt(uint32_t record) const = 0;
+        virtual const string& usernameAt(uint32_t record) const { 
+            return recordAt(record).getUsername(); 
+        }
+    };
+
+    static const uint32_t NOT_FOUND = 0xFFFFFFFFu;
+
+private:
+    static const size_t GROUP_SIZE = 16;
+    static const int8_t CTRL_EMPTY = -128;   // 0b10000000
+    static const int8_t CTRL_DELETED = -2;   // 0b11111110
+
+    int8_t* ctrl;        // capacity control bytes
+    uint32_t* slots;     // capacity record numbers
+    size_t capacity;     // Power of two, multiple of GROUP_SIZE
+    size_t count;
+    size_t tombstones;
+    KeyField field;
+    const RecordSource* source;
+
+    // Private helpers
+    bool isNormalized() const;
+    string normalize(const string& key) const;
+    const string& rawKeyOf(uint32_t record) const;
+    bool keyMatches(uint32_t record, const string& key) const;
+    uint64_t hashOf(uint32_t record) const;
+    static uint64_t hashKey(const string& key);
+    static uint64_t hashID(uint64_t id);
+    static uint32_t matchByte(const int8_t* group, int8_t value);
+    static uint32_t matchEmpty(const int8_t* group);
+    static uint32_t matchEmptyOrDeleted(const int8_t* group);
+    static size_t roundUpCapacity(size_t requested);
+    template<typename Match>
+    size_t probe(uint64_t hash, Match matches) const;
+    size_t findSlot(const string& key, uint64_t hash) const;
+    size_t findIDSlot(uint64_t id, uint64_t hash) const;
+    size_t findEntry(uint32_t record, uint64_t hash) const;
+    size_t findInsertSlot(uint64_t hash) const;
+    void insertHashed(uint32_t record, uint64_t hash);
+    void allocate(size_t newCapacity);
+    void rehash(size_t newCapacity);
+
+public:
+    UserIndex(KeyField field, const RecordSource* source);
+    UserIndex(KeyField field, const RecordSource* source, size_t initialCapacity);
+    ~UserIndex();
+
+    UserIndex(const UserIndex&) = delete;
+    UserIndex& operator=(const UserIndex&) = delete;
+
+    // Main operations (the record must already be readable via source)
+    bool insert(uint32_t record);              // false if key already present
+    void insertMulti(uint32_t record);         // Allows duplicate keys
+    uint32_t find(const string& key) const;    // First match or NOT_FOUND
+    uint32_t findID(uint64_t id) const;        // BY_USER_ID only
+    vector<uint32_t> findAll(const string& key) const;
+    bool erase(uint32_t record);               // Call before the key changes
+    bool relocate(uint32_t from, uint32_t to); // Record `from` moves to `to`
+    void reserve(size_t records);              // Room for this many without growing
+    void clear();
+
+    // Iteration over occupied slots (slot order, not insertion order)
+    size_t getCapacity() const;
+    uint32_t slotAt(size_t index) const;       // NOT_FOUND if empty/deleted
+
+    // Utility
+    size_t getCount() const;
+    size_t getMemoryUsage() const;             // Bytes held by ctrl + slots
+};
+
+#endif // USERINDEX_H
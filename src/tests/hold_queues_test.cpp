@@ -0,0 +1,103 @@
+// tests/hold_queues_test.cpp
+// HoldQueues against a naive model (a list of user IDs per book) over a
+// long run of random place / cancel / hand-off operations, checking
+// every result, queue position and queue length as it goes.
+#include "../management/HoldQueues.h"
+#include <iostream>
+#include <map>
+#include <list>
+#include <string>
+#include <random>
+using namespace std;
+
+static int failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            cerr << "FAIL " << __FILE__ << ":" << __LINE__ << ": " #condition << endl; \
+            failures++; \
+        } \
+    } while (0)
+
+static bool contains(const list<uint64_t>& queue, uint64_t userID) {
+    for (uint64_t holder : queue) {
+        if (holder == userID) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static size_t positionIn(const list<uint64_t>& queue, uint64_t userID) {
+    size_t position = 1;
+    for (uint64_t holder : queue) {
+        if (holder == userID) {
+            return position;
+        }
+        position++;
+    }
+    return 0;
+}
+
+int main() {
+    HoldQueues holds;
+    map<string, list<uint64_t>> model;
+    mt19937 random(3);
+    
+    // Few books and users so queues get long and cancellations pile up
+    for (int step = 0; step < 200000 && failures < 10; step++) {
+        string isbn = "ISBN-" + to_string(random() % 7);
+        uint64_t userID = random() % 40 + 1;
+        list<uint64_t>& queue = model[isbn];
+        
+        switch (random() % 4) {
+        case 0:
+        case 1: {
+            bool placed = holds.place(userID, isbn, step);
+            CHECK(placed == !contains(queue, userID));
+            if (placed) {
+                queue.push_back(userID);
+            }
+            break;
+        }
+        case 2:
+            CHECK(holds.cancel(userID, isbn) == contains(queue, userID));
+            queue.remove(userID);
+            break;
+        default: {
+            // Pass over one holder, who must keep their place
+            uint64_t skipped = userID;
+            uint64_t expected = 0;
+            for (uint64_t holder : queue) {
+                if (holder != skipped) {
+                    expected = holder;
+                    break;
+                }
+            }
+            CHECK(holds.takeNext(isbn, [&](uint64_t id) { return id != skipped; }) == expected);
+            if (expected != 0) {
+                queue.remove(expected);
+            }
+            break;
+        }
+        }
+        
+        uint64_t probe = random() % 40 + 1;
+        CHECK(holds.getPosition(probe, isbn) == positionIn(queue, probe));
+        CHECK(holds.getQueueLength(isbn) == queue.size());
+    }
+    
+    size_t total = 0;
+    for (const auto& entry : model) {
+        total += entry.second.size();
+    }
+    CHECK(holds.size() == total);
+    
+    if (failures > 0) {
+        cerr << failures << " check(s) failed" << endl;
+        return 1;
+    }
+    cout << "hold_queues_test: all checks passed" << endl;
+    return 0;
+}
@@ -0,0 +1,56 @@
+// tests/password_hash_test.cpp
+// Stored scrypt hashes: the configured cost verifies, and hashes whose
+// parameters would demand more than SCRYPT_MAX_MEMORY_BYTES or
+// SCRYPT_MAX_PR are rejected before any work is done.
+#include "../Config.h"
+#include "../entities/User.h"
+#include <iostream>
+#include <string>
+#include <chrono>
+using namespace std;
+
+static int failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            cerr << "FAIL " << __FILE__ << ":" << __LINE__ << ": " #condition << endl; \
+            failures++; \
+        } \
+    } while (0)
+
+// The stored hash with its cost fields replaced
+static string withCost(const string& stored, int logN, int r, int p) {
+    size_t salt = 0;
+    for (int field = 0; field < 4; field++) {
+        salt = stored.find('$', salt) + 1;   // "scrypt$logN$r$p$" precedes the salt
+    }
+    return "scrypt$" + to_string(logN) + "$" + to_string(r) + "$" + to_string(p) + stored.substr(salt - 1);
+}
+
+int main() {
+    const string password = "correct horse";
+    string stored = User::hashPassword(password);
+    CHECK(User::verifyPassword(stored, password));
+    CHECK(!User::verifyPassword(stored, "wrong horse"));
+    CHECK(!User::needsRehash(stored));
+    
+    // 128 * 32 * 2^22 = 16 GiB, 128 * 8 * 2^20 = 1 GiB, 128 * 32 * 2^17 = 512 MiB
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    CHECK(!User::verifyPassword(withCost(stored, 22, 32, 1), password));
+    CHECK(!User::verifyPassword(withCost(stored, 20, 8, 1), password));
+    CHECK(!User::verifyPassword(withCost(stored, 17, 32, 1), password));
+    CHECK(!User::verifyPassword(withCost(stored, 10, 32, 16), password));   // p * r = 512
+    double elapsedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    CHECK(elapsedMs < 100);   // Refused without running the KDF
+    
+    // Rejected parameters read as a legacy hash, due for an upgrade
+    CHECK(User::needsRehash(withCost(stored, 22, 32, 1)));
+    
+    if (failures > 0) {
+        cerr << failures << " check(s) failed" << endl;
+        return 1;
+    }
+    cout << "password_hash_test: all checks passed" << endl;
+    return 0;
+}
@@ -0,0 +1,125 @@
+// tests/snapshot_selection_test.cpp
+// Start-up picks the format holding the later complete save: a save cut
+// short partway through the CSV files, or a CSV file edited afterwards,
+// must leave the binary snapshot in charge; a save cut short after the
+// CSV set (before the snapshot) must load the CSV files. Runs in a
+// scratch directory, since the file names come from Config.h.
+#include "../utils/FileHandler.h"
+#include "../utils/StringDictionary.h"
+#include "../Config.h"
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <string>
+#include <vector>
+using namespace std;
+
+static int failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            cerr << "FAIL " << __FILE__ << ":" << __LINE__ << ": " #condition << endl; \
+            failures++; \
+        } \
+    } while (0)
+
+static const vector<string> CSV_FILES = {BOOKS_FILE, USERS_FILE, STRINGS_FILE, 
+                                         TRANSACTIONS_FILE, HOLDS_FILE};
+
+// Saves a library of `books` books, one user and one transaction
+static void saveLibrary(int books) {
+    BookBST bookTree;
+    UserHashMap userMap;
+    TransactionList transList;
+    HoldQueues holds;
+    for (int i = 0; i < books; i++) {
+        bookTree.insert(Book("978-0-00-00000" + to_string(i), "Title " + to_string(i), 
+                             "Author", 1));
+    }
+    userMap.insert(User::restore(1, "reader", "legacy-hash", "Reader", "r@example.com", 
+                                 "555", true));
+    transList.append(Transaction::restore(1, 1, "978-0-00-000000", "BORROW", "Reader", 
+                                          "Title 0", 1, 1700000000000LL));
+    CHECK(FileHandler::saveSnapshot(FileHandler::captureSnapshot(&bookTree, &userMap, 
+                                                                 &transList, &holds, 0), 
+                                    false));
+}
+
+static int loadedBookCount() {
+    BookBST bookTree;
+    UserHashMap userMap;
+    TransactionList transList;
+    HoldQueues holds;
+    uint64_t journalLSN = 0;
+    StringDictionary::getInstance()->clear();   // Loads expect a fresh process
+    FileHandler::loadSnapshot(&bookTree, &userMap, &transList, &holds, journalLSN);
+    return bookTree.getCount();
+}
+
+static void keep(const string& file) {
+    filesystem::copy_file(file, file + ".kept", filesystem::copy_options::overwrite_existing);
+}
+
+static void restore(const string& file) {
+    filesystem::copy_file(file + ".kept", file, filesystem::copy_options::overwrite_existing);
+}
+
+static void keepAll() {
+    for (const string& file : CSV_FILES) {
+        keep(file);
+    }
+    keep(CHECKPOINT_FILE);
+    keep(SNAPSHOT_FILE);
+}
+
+int main() {
+    filesystem::path scratch = filesystem::temp_directory_path() / "lms_snapshot_selection_test";
+    filesystem::remove_all(scratch);
+    filesystem::create_directories(scratch / DATA_DIR);
+    filesystem::current_path(scratch);
+    
+    // Complete saves: the snapshot is used and holds the latest save
+    saveLibrary(2);
+    CHECK(loadedBookCount() == 2);
+    
+    // A later save stopped after books.txt and users.txt
+    keepAll();
+    saveLibrary(3);
+    for (const string& file : {STRINGS_FILE, TRANSACTIONS_FILE, HOLDS_FILE, 
+                               CHECKPOINT_FILE, SNAPSHOT_FILE}) {
+        restore(file);
+    }
+    CHECK(loadedBookCount() == 2);
+    
+    // A later save stopped after the checkpoint, before the snapshot
+    saveLibrary(4);
+    restore(SNAPSHOT_FILE);
+    CHECK(loadedBookCount() == 4);
+    
+    // The next save numbers above both, so its snapshot wins again
+    saveLibrary(5);
+    CHECK(loadedBookCount() == 5);
+    
+    // books.txt edited by something else after the save
+    {
+        ofstream books(BOOKS_FILE, ios::app);
+        books << "978-0-00-000099,Edited,Author,1,1,S\n";
+    }
+    filesystem::last_write_time(BOOKS_FILE, filesystem::last_write_time(CHECKPOINT_FILE) + 
+                                            chrono::seconds(2));
+    CHECK(loadedBookCount() == 5);
+    
+    // No usable snapshot: the CSV files, whatever state they are in
+    filesystem::remove(SNAPSHOT_FILE);
+    CHECK(loadedBookCount() == 6);
+    
+    filesystem::current_path(scratch.parent_path());
+    filesystem::remove_all(scratch);
+    if (failures > 0) {
+        cerr << failures << " check(s) failed" << endl;
+        return 1;
+    }
+    cout << "snapshot_selection_test: all checks passed" << endl;
+    return 0;
+}
@@ -0,0 +1,72 @@
+// tests/time_utils_test.cpp
+// File timestamps are UTC marked with "Z"; unmarked legacy text is local
+// time; display and calendar days are local. Run under a fixed zone with
+// daylight saving (POSIX TZ rule, so no tz database is needed).
+#include "../utils/TimeUtils.h"
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+using namespace std;
+
+static int failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            cerr << "FAIL " << __FILE__ << ":" << __LINE__ << ": " #condition << endl; \
+            failures++; \
+        } \
+    } while (0)
+
+int main() {
+#ifdef _WIN32
+    _putenv_s("TZ", "EST5EDT");
+    _tzset();
+#else
+    setenv("TZ", "EST5EDT,M3.2.0,M11.1.0", 1);
+    tzset();
+#endif
+    
+    const int64_t HOUR = 3600000;
+    const int64_t winter = 1704067200000LL;   // 2024-01-01 00:00:00 UTC
+    const int64_t summer = 1719792000000LL;   // 2024-07-01 00:00:00 UTC
+    
+    // Files: UTC with the marker, round-tripping exactly
+    CHECK(TimeUtils::formatUTC(winter) == "2024-01-01 00:00:00Z");
+    int64_t parsed = 0;
+    CHECK(TimeUtils::parse("2024-01-01 00:00:00Z", parsed) && parsed == winter);
+    CHECK(TimeUtils::parse(TimeUtils::formatUTC(summer + 1234000), parsed) && 
+          parsed == summer + 1234000);
+    
+    // Legacy rows carry no marker and were written in local time
+    CHECK(TimeUtils::parse("2023-12-31 19:00:00", parsed) && parsed == winter);        // EST
+    CHECK(TimeUtils::parse("2024-06-30 20:00:00", parsed) && parsed == summer);        // EDT
+    CHECK(!TimeUtils::parse("2024-01-01 00:00:00X", parsed));
+    CHECK(!TimeUtils::parse("2024-01-01T00:00:00Z", parsed));
+    
+    // Display is local
+    CHECK(TimeUtils::format(winter) == "2023-12-31 19:00:00");
+    CHECK(TimeUtils::format(summer) == "2024-06-30 20:00:00");
+    
+    // Local calendar days, including the 23-hour day of the spring change
+    int64_t midnight = 0;
+    CHECK(TimeUtils::fromDate(2024, 1, 1, midnight) && midnight == winter + 5 * HOUR);
+    CHECK(TimeUtils::dayOf(winter) + 1 == TimeUtils::dayOf(midnight));
+    int64_t springStart = 0, springEnd = 0;
+    CHECK(TimeUtils::fromDate(2024, 3, 10, springStart));
+    CHECK(TimeUtils::fromDate(2024, 3, 11, springEnd));
+    CHECK(springEnd - springStart == 23 * HOUR);
+    CHECK(TimeUtils::startOfDay(TimeUtils::dayOf(springStart) + 1) == springEnd);
+    
+    int64_t monthFrom = 0, monthTo = 0;
+    CHECK(TimeUtils::monthWindow(2024, 12, monthFrom, monthTo));
+    CHECK(TimeUtils::format(monthFrom) == "2024-12-01 00:00:00");
+    CHECK(TimeUtils::format(monthTo) == "2025-01-01 00:00:00");
+    
+    if (failures > 0) {
+        cerr << failures << " check(s) failed" << endl;
+        return 1;
+    }
+    cout << "time_utils_test: all checks passed" << endl;
+    return 0;
+}
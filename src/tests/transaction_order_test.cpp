@@ -0,0 +1,105 @@
+// tests/transaction_order_test.cpp
+// TransactionList keeps each record's own timestamp, and time windows
+// stay exact once a record arrives older than one before it (a clock
+// step back): checked against a brute-force filter of the log.
+#include "../management/TransactionList.h"
+#include "../management/TransactionAnalytics.h"
+#include <iostream>
+#include <vector>
+#include <random>
+using namespace std;
+
+static int failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            cerr << "FAIL " << __FILE__ << ":" << __LINE__ << ": " #condition << endl; \
+            failures++; \
+        } \
+    } while (0)
+
+static vector<uint64_t> expectedIDs(const vector<Transaction>& records, int64_t fromMs, 
+                                    int64_t toMs, uint64_t userID) {
+    vector<uint64_t> ids;
+    for (const Transaction& trans : records) {
+        if (trans.getTimestamp() >= fromMs && trans.getTimestamp() < toMs && 
+            (userID == 0 || trans.getUserID() == userID)) {
+            ids.push_back(trans.getID());
+        }
+    }
+    return ids;
+}
+
+static vector<uint64_t> idsOf(const TransactionList::Range& range) {
+    vector<uint64_t> ids;
+    for (Transaction* trans : range) {
+        ids.push_back(trans->getID());
+    }
+    return ids;
+}
+
+// Records one minute apart, with the clock stepping back an hour when
+// stepAt is reached
+static vector<Transaction> makeLog(size_t count, size_t stepAt) {
+    vector<Transaction> records;
+    int64_t time = 1700000000000LL;
+    for (size_t i = 0; i < count; i++) {
+        time += (i == stepAt) ? -3600000 : 60000;
+        records.push_back(Transaction::restore(i + 1, 1 + i % 7, "ISBN-" + to_string(i % 5), 
+                                               (i % 2) ? "RETURN" : "BORROW", "Patron", 
+                                               "Title", 1, time));
+    }
+    return records;
+}
+
+static void checkWindows(const vector<Transaction>& records, bool ordered) {
+    TransactionList list;
+    for (const Transaction& trans : records) {
+        list.append(trans);
+    }
+    CHECK(list.isTimeOrdered() == ordered);
+    
+    // Nothing is rewritten
+    for (size_t seq = 0; seq < records.size(); seq++) {
+        CHECK(list.at(seq)->getTimestamp() == records[seq].getTimestamp());
+    }
+    
+    mt19937_64 random(42);
+    int64_t start = records.front().getTimestamp() - 7200000;
+    int64_t span = records.size() * 60000 + 14400000;
+    for (int trial = 0; trial < 500; trial++) {
+        int64_t fromMs = start + static_cast<int64_t>(random() % span);
+        int64_t toMs = fromMs + static_cast<int64_t>(random() % 7200000);
+        uint64_t userID = 1 + random() % 7;
+        
+        CHECK(idsOf(list.getBetween(fromMs, toMs)) == expectedIDs(records, fromMs, toMs, 0));
+        CHECK(idsOf(list.getByUserIDBetween(userID, fromMs, toMs)) == 
+              expectedIDs(records, fromMs, toMs, userID));
+        
+        TransactionList::Range range = list.getBetween(fromMs, toMs);
+        CHECK(range.size() == idsOf(range).size());
+    }
+    
+    // Analytics rows sort themselves, so day totals match the log
+    TransactionAnalytics analytics;
+    analytics.rebuild(list);
+    uint64_t total = 0;
+    for (const DayCount& day : analytics.dailyActivity(INT64_MIN, INT64_MAX)) {
+        total += day.borrows + day.returns;
+    }
+    CHECK(total == records.size());
+}
+
+int main() {
+    checkWindows(makeLog(10000, 10000), true);   // No step
+    checkWindows(makeLog(10000, 6000), false);   // Step back in the middle
+    checkWindows(makeLog(10000, 1), false);      // Step back at the start
+    
+    if (failures > 0) {
+        cerr << failures << " check(s) failed" << endl;
+        return 1;
+    }
+    cout << "transaction_order_test: all checks passed" << endl;
+    return 0;
+}
@@ -0,0 +1,148 @@
+// tests/trending_sketch_test.cpp
+// TrendingSketch estimates against exact counts, for Zipf-distributed
+// borrows spanning two windows (so half have expired): count-min never
+// undercounts and stays within its bound (Config.h) for all but the
+// allowed fraction of books, the heavy hitters include the true top
+// books, the HyperLogLog estimates are within a few standard errors,
+// and a full expiry returns every count to zero.
+#include "../Config.h"
+#include "../management/TrendingSketch.h"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <set>
+#include <unordered_set>
+#include <algorithm>
+#include <random>
+#include <cmath>
+using namespace std;
+
+static int failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            cerr << "FAIL " << __FILE__ << ":" << __LINE__ << ": " #condition << endl; \
+            failures++; \
+        } \
+    } while (0)
+
+static const size_t BOOKS = 20000;
+static const size_t USERS = 20000;
+static const size_t BORROWS = 600000;
+
+static string isbnOf(size_t book) {
+    return "978-" + to_string(1000000 + book);
+}
+
+int main() {
+    const int64_t bucketMs = int64_t(TREND_BUCKET_HOURS) * 3600 * 1000;
+    const int64_t start = 1700000000000LL;
+    const int64_t step = 2 * TrendingSketch::getWindowMs() / int64_t(BORROWS);
+    
+    vector<double> weights(BOOKS);
+    for (size_t book = 0; book < BOOKS; book++) {
+        weights[book] = 1.0 / (book + 1);
+    }
+    discrete_distribution<size_t> pickBook(weights.begin(), weights.end());
+    uniform_int_distribution<uint64_t> pickUser(1, USERS);
+    mt19937_64 random(11);
+    
+    vector<size_t> books(BORROWS);
+    vector<uint64_t> users(BORROWS);
+    for (size_t i = 0; i < BORROWS; i++) {
+        books[i] = pickBook(random);
+        users[i] = pickUser(random);
+    }
+    
+    TrendingSketch sketch;
+    for (size_t i = 0; i < BORROWS; i++) {
+        sketch.record(users[i], isbnOf(books[i]), start + int64_t(i) * step);
+    }
+    int64_t lastMs = start + int64_t(BORROWS - 1) * step;
+    
+    // Exact counts over the live buckets
+    int64_t oldestLive = lastMs / bucketMs - TREND_BUCKETS + 1;
+    vector<uint64_t> exact(BOOKS, 0);
+    vector<unordered_set<uint64_t>> exactBorrowers(BOOKS);
+    unordered_set<uint64_t> allBorrowers;
+    uint64_t windowBorrows = 0;
+    for (size_t i = 0; i < BORROWS; i++) {
+        if ((start + int64_t(i) * step) / bucketMs >= oldestLive) {
+            exact[books[i]]++;
+            exactBorrowers[books[i]].insert(users[i]);
+            allBorrowers.insert(users[i]);
+            windowBorrows++;
+        }
+    }
+    CHECK(windowBorrows > BORROWS / 3 && windowBorrows < BORROWS * 2 / 3);
+    CHECK(sketch.getWindowBorrows() == windowBorrows);
+    
+    // Count-min: estimate - exact <= e / width * N, except with
+    // probability e^-depth per book
+    double bound = exp(1.0) / TREND_SKETCH_WIDTH * windowBorrows;
+    size_t undercounts = 0, overBound = 0;
+    for (size_t book = 0; book < BOOKS; book++) {
+        uint64_t estimate = sketch.estimateBorrows(isbnOf(book));
+        undercounts += (estimate < exact[book]);
+        overBound += (estimate - exact[book] > bound);
+    }
+    CHECK(undercounts == 0);
+    CHECK(overBound <= BOOKS * exp(-double(TREND_SKETCH_DEPTH)));
+    
+    // Heavy hitters: the true top ten are all listed
+    vector<size_t> order(BOOKS);
+    for (size_t book = 0; book < BOOKS; book++) {
+        order[book] = book;
+    }
+    sort(order.begin(), order.end(), [&](size_t a, size_t b) { return exact[a] > exact[b]; });
+    vector<TrendingBook> trending = sketch.trending(TREND_TOP_K);
+    set<string> listed;
+    for (const TrendingBook& entry : trending) {
+        listed.insert(entry.isbn);
+    }
+    CHECK(trending.size() == size_t(TREND_TOP_K));
+    for (size_t rank = 0; rank < 10; rank++) {
+        CHECK(listed.count(isbnOf(order[rank])) == 1);
+    }
+    
+    // HyperLogLog: within three standard errors (1.04 / sqrt(2^bits))
+    double userError = 3 * 1.04 / sqrt(double(1 << TREND_HLL_BITS));
+    double estimate = double(sketch.estimateUniqueBorrowers());
+    CHECK(fabs(estimate - allBorrowers.size()) <= userError * allBorrowers.size());
+    
+    // Per-book HLL, RMS over the true top ten: tracked from their first
+    // borrows (a book that joins the list late misses earlier borrowers)
+    double squares = 0;
+    for (const TrendingBook& entry : trending) {
+        size_t book = size_t(stoull(entry.isbn.substr(4))) - 1000000;
+        if (exact[book] >= exact[order[9]]) {
+            double truth = double(exactBorrowers[book].size());
+            squares += pow((double(entry.uniqueBorrowers) - truth) / truth, 2);
+        }
+    }
+    double bookError = 1.04 / sqrt(double(1 << TREND_BOOK_HLL_BITS));
+    CHECK(sqrt(squares / 10) <= 2 * bookError);
+    
+    // Borrows from before the window are ignored
+    sketch.record(1, isbnOf(0), lastMs - 2 * TrendingSketch::getWindowMs());
+    CHECK(sketch.getWindowBorrows() == windowBorrows);
+    
+    // Once the whole window has passed, nothing is left
+    sketch.advance(lastMs + TrendingSketch::getWindowMs() + bucketMs);
+    CHECK(sketch.getWindowBorrows() == 0);
+    CHECK(sketch.estimateUniqueBorrowers() == 0);
+    CHECK(sketch.trending(TREND_TOP_K).empty());
+    size_t leftover = 0;
+    for (size_t book = 0; book < BOOKS; book++) {
+        leftover += (sketch.estimateBorrows(isbnOf(book)) != 0);
+    }
+    CHECK(leftover == 0);
+    
+    if (failures > 0) {
+        cerr << failures << " check(s) failed" << endl;
+        return 1;
+    }
+    cout << "trending_sketch_test: all checks passed" << endl;
+    return 0;
+}
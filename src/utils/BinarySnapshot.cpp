@@ -0,0 +1,580 @@
+// utils/BinarySnapshot.cpp
+#include "BinarySnapshot.h"
+#include "Crc32c.h"
+#include "StringDictionary.h"
+#include <iostream>
+#include <string_view>
+#include <unordered_map>
+#include <deque>
+#include <vector>
+#include <cstring>
+#include <cstddef>
+
+#ifdef _WIN32
+    #include <fstream>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+
+enum SectionID {
+    DICTIONARY,
+    BOOKS,
+    COPY_STATES,
+    USERS,
+    BORROWED,
+    TRANSACTIONS,
+    HOLDS,
+    STRING_OFFSETS,
+    STRING_BYTES,
+    SECTION_COUNT
+};
+
+const char MAGIC[8] = {'L', 'I', 'B', 'S', 'N', 'A', 'P', '\0'};
+const uint32_t BYTE_ORDER_MARK = 0x01020304;   // Reads back reversed on a big-endian host
+const size_t BUFFER_BYTES = 1 << 20;
+
+struct Section {
+    uint64_t offset;
+    uint64_t count;       // Entries (bytes for COPY_STATES and STRING_BYTES)
+};
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t journalLSN;
+    uint64_t generation;
+    uint64_t fileSize;
+    Section sections[SECTION_COUNT];
+    uint32_t bodyCrc;     // Every byte after the header
+    uint32_t headerCrc;   // Every byte before this field
+};
+
+struct BookRecord {
+    uint32_t isbn;
+    uint32_t title;
+    uint32_t author;
+    uint32_t copyCount;
+    uint64_t firstCopy;   // Into COPY_STATES
+};
+
+struct UserRecord {
+    uint64_t id;
+    uint32_t username;
+    uint32_t passwordHash;
+    uint32_t fullName;
+    uint32_t email;
+    uint32_t phone;
+    uint32_t firstBorrowed;   // Into BORROWED
+    uint16_t borrowedCount;
+    uint16_t active;
+    uint32_t reserved;
+};
+
+struct TransactionRecord {
+    uint64_t id;
+    uint64_t userID;
+    int64_t timestamp;
+    uint32_t isbn;
+    uint32_t type;
+    uint32_t userNameCode;    // StringDictionary codes, not string ids
+    uint32_t bookTitleCode;
+    int32_t copyNumber;
+    uint32_t reserved;
+};
+
+struct HoldRecord {
+    uint64_t userID;
+    int64_t placedAt;
+    uint32_t isbn;
+    uint32_t reserved;
+};
+
+// No implicit padding, so every byte written is a zeroed or set field
+static_assert(sizeof(Header) == 192, "Header layout");
+static_assert(sizeof(BookRecord) == 24, "BookRecord layout");
+static_assert(sizeof(UserRecord) == 40, "UserRecord layout");
+static_assert(sizeof(TransactionRecord) == 48, "TransactionRecord layout");
+static_assert(sizeof(HoldRecord) == 24, "HoldRecord layout");
+
+const size_t ENTRY_BYTES[SECTION_COUNT] = {
+    sizeof(uint32_t), sizeof(BookRecord), 1, sizeof(UserRecord), sizeof(uint32_t),
+    sizeof(TransactionRecord), sizeof(HoldRecord), sizeof(uint64_t), 1
+};
+
+// ============ WRITING ============
+
+// Distinct strings in first-seen order. Views point into the snapshot
+// and the dictionary; strings that were returned by value are kept here.
+class StringTable {
+private:
+    unordered_map<string_view, uint32_t> ids;
+    vector<string_view> strings;
+    deque<string> owned;
+
+public:
+    uint32_t add(string_view text) {
+        auto result = ids.emplace(text, static_cast<uint32_t>(strings.size()));
+        if (result.second) {
+            strings.push_back(text);
+        }
+        return result.first->second;
+    }
+
+    uint32_t add(string&& text) {
+        auto it = ids.find(string_view(text));
+        if (it != ids.end()) {
+            return it->second;
+        }
+        owned.push_back(move(text));
+        return add(string_view(owned.back()));
+    }
+
+    const vector<string_view>& getStrings() const { return strings; }
+};
+
+// Buffers the body, tracking its CRC and the file offset
+class BodyWriter {
+private:
+    ostream& out;
+    string buffer;
+    uint32_t crc;
+    uint64_t offset;
+
+public:
+    BodyWriter(ostream& out, uint64_t start) : out(out), crc(0), offset(start) {
+        buffer.reserve(BUFFER_BYTES);
+    }
+
+    void put(const void* data, size_t length) {
+        buffer.append(static_cast<const char*>(data), length);
+        offset += length;
+        if (buffer.size() >= BUFFER_BYTES) {
+            drain();
+        }
+    }
+
+    template <typename T>
+    void put(const T& value) {
+        put(&value, sizeof(value));
+    }
+
+    // Pads to 8 bytes and records the section's place in the header
+    void begin(Header& header, SectionID id, uint64_t count) {
+        static const char zeros[8] = {};
+        put(zeros, (8 - offset % 8) % 8);
+        header.sections[id].offset = offset;
+        header.sections[id].count = count;
+    }
+
+    void drain() {
+        crc = Crc32c::extend(crc, buffer.data(), buffer.size());
+        out.write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+
+    uint32_t getCrc() const { return crc; }
+    uint64_t getOffset() const { return offset; }
+};
+
+// ============ LOADING ============
+
+// Read-only view of a whole file: mapped where the OS allows, read into
+// memory otherwise
+class MappedFile {
+private:
+    const char* data;
+    size_t length;
+#ifdef _WIN32
+    vector<char> contents;
+#else
+    void* mapping;
+#endif
+
+public:
+    explicit MappedFile(const string& filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const { return data != nullptr; }
+    const char* getData() const { return data; }
+    size_t size() const { return length; }
+};
+
+#ifdef _WIN32
+MappedFile::MappedFile(const string& filename) : data(nullptr), length(0) {
+    ifstream file(filename, ios::binary | ios::ate);
+    if (!file.is_open()) {
+        return;
+    }
+    contents.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (!contents.empty() && file.read(contents.data(), contents.size())) {
+        data = contents.data();
+        length = contents.size();
+    }
+}
+
+MappedFile::~MappedFile() {}
+#else
+MappedFile::MappedFile(const string& filename) : data(nullptr), length(0), mapping(MAP_FAILED) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        mapping = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+            length = static_cast<size_t>(info.st_size);
+            data = static_cast<const char*>(mapping);
+            madvise(mapping, length, MADV_WILLNEED);   // Every page is read once
+        }
+    }
+    close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (mapping != MAP_FAILED) {
+        munmap(mapping, length);
+    }
+}
+#endif
+
+// Typed access to a validated file. Records are copied out with memcpy,
+// which compiles to plain loads.
+class SnapshotView {
+private:
+    const char* data;
+    const Header& header;
+
+public:
+    SnapshotView(const char* data, const Header& header) : data(data), header(header) {}
+
+    uint64_t count(SectionID id) const { return header.sections[id].count; }
+
+    const char* bytes(SectionID id) const { return data + header.sections[id].offset; }
+
+    template <typename T>
+    T at(SectionID id, uint64_t index) const {
+        T value;
+        memcpy(&value, bytes(id) + index * sizeof(T), sizeof(T));
+        return value;
+    }
+
+    bool text(uint32_t id, string_view& value) const {
+        if (id >= count(STRING_OFFSETS) - 1) {
+            return false;
+        }
+        uint64_t begin = at<uint64_t>(STRING_OFFSETS, id);
+        uint64_t end = at<uint64_t>(STRING_OFFSETS, id + uint64_t(1));
+        value = string_view(bytes(STRING_BYTES) + begin, static_cast<size_t>(end - begin));
+        return true;
+    }
+};
+
+bool reject(const string& filename, const string& problem) {
+    cerr << "Warning: Binary snapshot " << filename << " not used: " << problem << endl;
+    return false;
+}
+
+// Everything the loader relies on, checked before anything is loaded
+bool validate(const string& filename, const MappedFile& file, Header& header) {
+    if (file.size() < sizeof(Header)) {
+        return reject(filename, "too short");
+    }
+    memcpy(&header, file.getData(), sizeof(Header));
+    if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        return reject(filename, "not a snapshot file");
+    }
+    if (header.byteOrder != BYTE_ORDER_MARK) {
+        return reject(filename, "written with a different byte order");
+    }
+    if (header.version != BinarySnapshot::VERSION) {
+        return reject(filename, "format version " + to_string(header.version) +
+                                ", expected " + to_string(BinarySnapshot::VERSION));
+    }
+    if (header.headerCrc != Crc32c::compute(&header, offsetof(Header, headerCrc)) ||
+        header.fileSize != file.size()) {
+        return reject(filename, "damaged header or cut short");
+    }
+
+    for (int id = 0; id < SECTION_COUNT; id++) {
+        const Section& section = header.sections[id];
+        if (section.offset < sizeof(Header) || section.offset % 8 != 0 ||
+            section.offset > file.size() ||
+            section.count > (file.size() - section.offset) / ENTRY_BYTES[id]) {
+            return reject(filename, "section out of bounds");
+        }
+    }
+
+    const char* body = file.getData() + sizeof(Header);
+    if (Crc32c::compute(body, file.size() - sizeof(Header)) != header.bodyCrc) {
+        return reject(filename, "checksum mismatch");
+    }
+
+    // Offsets ascend and stay within the string bytes
+    SnapshotView view(file.getData(), header);
+    uint64_t offsets = view.count(STRING_OFFSETS);
+    if (offsets == 0) {
+        return reject(filename, "no string table");
+    }
+    uint64_t previous = 0;
+    for (uint64_t i = 0; i < offsets; i++) {
+        uint64_t offset = view.at<uint64_t>(STRING_OFFSETS, i);
+        if (offset < previous || offset > view.count(STRING_BYTES)) {
+            return reject(filename, "invalid string table");
+        }
+        previous = offset;
+    }
+    return true;
+}
+
+}  // namespace
+
+// ============ WRITE ============
+
+// One pass: records stream out as their strings are interned, and the
+// string table follows them. The header goes in last, over a placeholder.
+bool BinarySnapshot::write(ostream& out, const DataSnapshot& snapshot) {
+    StringDictionary* dictionary = StringDictionary::getInstance();
+    size_t dictionaryCount = dictionary->getCount();
+
+    Header header = {};
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.journalLSN = snapshot.journalLSN;
+    header.generation = snapshot.generation;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    StringTable strings;
+    BodyWriter body(out, sizeof(header));
+
+    body.begin(header, DICTIONARY, dictionaryCount);
+    for (size_t code = 0; code < dictionaryCount; code++) {
+        body.put(strings.add(string_view(dictionary->lookup(static_cast<uint32_t>(code)))));
+    }
+
+    string copyStates;
+    body.begin(header, BOOKS, snapshot.books.size());
+    for (const Book& book : snapshot.books) {
+        string states = book.getCopyStates();
+        BookRecord record = {};
+        record.isbn = strings.add(book.getISBN());
+        record.title = strings.add(book.getTitle());
+        record.author = strings.add(book.getAuthor());
+        record.copyCount = static_cast<uint32_t>(states.size());
+        record.firstCopy = copyStates.size();
+        copyStates += states;
+        body.put(record);
+    }
+    body.begin(header, COPY_STATES, copyStates.size());
+    body.put(copyStates.data(), copyStates.size());
+
+    vector<uint32_t> borrowed;
+    body.begin(header, USERS, snapshot.users.size());
+    for (const User& user : snapshot.users) {
+        const BorrowedBooks& loans = user.getBorrowedBooks();
+        UserRecord record = {};
+        record.id = user.getID();
+        record.username = strings.add(string_view(user.getUsername()));
+        record.passwordHash = strings.add(string_view(user.getPasswordHash()));
+        record.fullName = strings.add(string_view(user.getFullName()));
+        record.email = strings.add(string_view(user.getEmail()));
+        record.phone = strings.add(string_view(user.getPhoneNumber()));
+        record.firstBorrowed = static_cast<uint32_t>(borrowed.size());
+        record.borrowedCount = static_cast<uint16_t>(loans.size());
+        record.active = user.isActive() ? 1 : 0;
+        for (int i = 0; i < loans.size(); i++) {
+            borrowed.push_back(strings.add(string_view(loans.isbnAt(i))));
+        }
+        body.put(record);
+    }
+    body.begin(header, BORROWED, borrowed.size());
+    body.put(borrowed.data(), borrowed.size() * sizeof(uint32_t));
+
+    const TransactionList::Prefix& transactions = snapshot.transactions;
+    body.begin(header, TRANSACTIONS, transactions.size());
+    for (size_t seq = 0; seq < transactions.size(); seq++) {
+        const Transaction* trans = transactions[seq];
+        TransactionRecord record = {};
+        record.id = trans->getID();
+        record.userID = trans->getUserID();
+        record.timestamp = trans->getTimestamp();
+        record.isbn = strings.add(string_view(trans->getISBN()));
+        record.type = strings.add(string_view(trans->getType()));
+        record.userNameCode = trans->getUserNameCode();
+        record.bookTitleCode = trans->getBookTitleCode();
+        record.copyNumber = trans->getCopyNumber();
+        body.put(record);
+    }
+
+    body.begin(header, HOLDS, snapshot.holds.size());
+    for (const auto& entry : snapshot.holds) {
+        HoldRecord record = {};
+        record.userID = entry.second.userID;
+        record.placedAt = entry.second.placedAt;
+        record.isbn = strings.add(string_view(entry.first));
+        body.put(record);
+    }
+
+    const vector<string_view>& table = strings.getStrings();
+    uint64_t position = 0;
+    body.begin(header, STRING_OFFSETS, table.size() + 1);
+    for (string_view text : table) {
+        body.put(position);
+        position += text.size();
+    }
+    body.put(position);
+    body.begin(header, STRING_BYTES, position);
+    for (string_view text : table) {
+        body.put(text.data(), text.size());
+    }
+    body.drain();
+
+    header.fileSize = body.getOffset();
+    header.bodyCrc = body.getCrc();
+    header.headerCrc = Crc32c::compute(&header, offsetof(Header, headerCrc));
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    return out.good();
+}
+
+// ============ LOAD ============
+
+bool BinarySnapshot::load(const string& filename, BookBST* bookTree, UserHashMap* userMap,
+                          TransactionList* transList, HoldQueues* holds, uint64_t& journalLSN) {
+    if (bookTree == nullptr || userMap == nullptr || transList == nullptr || holds == nullptr) {
+        cerr << "Error: Snapshot target is null" << endl;
+        return false;
+    }
+
+    MappedFile file(filename);
+    if (!file.isOpen()) {
+        return reject(filename, "could not be read");
+    }
+    Header header;
+    if (!validate(filename, file, header)) {
+        return false;
+    }
+    SnapshotView view(file.getData(), header);
+
+    // Dictionary codes must come out as they were, so stop at a bad one
+    StringDictionary* dictionary = StringDictionary::getInstance();
+    uint64_t codes = view.count(DICTIONARY);
+    dictionary->reserve(codes);
+    uint32_t loadedCodes = 0;
+    for (; loadedCodes < codes; loadedCodes++) {
+        string_view text;
+        if (!view.text(view.at<uint32_t>(DICTIONARY, loadedCodes), text) ||
+            !dictionary->loadEntry(loadedCodes, text)) {
+            cerr << "Warning: Invalid strings entry, stopped at code " << loadedCodes << endl;
+            break;
+        }
+    }
+    cout << "  ✓ Strings loaded: " << loadedCodes << " records" << endl;
+
+    int loaded = 0;
+    for (uint64_t i = 0; i < view.count(BOOKS); i++) {
+        BookRecord record = view.at<BookRecord>(BOOKS, i);
+        string_view isbn, title, author;
+        if (!view.text(record.isbn, isbn) || !view.text(record.title, title) ||
+            !view.text(record.author, author) ||
+            record.firstCopy + record.copyCount > view.count(COPY_STATES)) {
+            cerr << "Warning: Skipped invalid book record" << endl;
+            continue;
+        }
+        Book book = Book::restore(string(isbn), string(title), string(author),
+                                  string_view(view.bytes(COPY_STATES) + record.firstCopy,
+                                              record.copyCount));
+        if (!book.getISBN().empty()) {
+            bookTree->insert(book);
+            loaded++;
+        }
+    }
+    cout << "  ✓ Books loaded: " << loaded << " records" << endl;
+
+    loaded = 0;
+    userMap->reserve(view.count(USERS));
+    for (uint64_t i = 0; i < view.count(USERS); i++) {
+        UserRecord record = view.at<UserRecord>(USERS, i);
+        string_view username, passwordHash, fullName, email, phone;
+        if (record.id == 0 || !view.text(record.username, username) ||
+            !view.text(record.passwordHash, passwordHash) ||
+            !view.text(record.fullName, fullName) || !view.text(record.email, email) ||
+            !view.text(record.phone, phone) ||
+            uint64_t(record.firstBorrowed) + record.borrowedCount > view.count(BORROWED)) {
+            cerr << "Warning: Skipped invalid user record" << endl;
+            continue;
+        }
+        User user = User::restore(record.id, string(username), string(passwordHash),
+                                  string(fullName), string(email), string(phone),
+                                  record.active != 0);
+        for (uint32_t k = 0; k < record.borrowedCount; k++) {
+            string_view isbn;
+            if (view.text(view.at<uint32_t>(BORROWED, uint64_t(record.firstBorrowed) + k), isbn)) {
+                user.addBorrowedBook(string(isbn));
+            }
+        }
+        User::idGenerator.observe(record.id);
+        if (userMap->insert(user) != nullptr) {
+            loaded++;
+        }
+    }
+    cout << "  ✓ Users loaded: " << loaded << " records" << endl;
+
+    loaded = 0;
+    transList->reserve(view.count(TRANSACTIONS), userMap->getCount(), bookTree->getCount());
+    for (uint64_t i = 0; i < view.count(TRANSACTIONS); i++) {
+        TransactionRecord record = view.at<TransactionRecord>(TRANSACTIONS, i);
+        string_view isbn, type;
+        if (record.id == 0 || !view.text(record.isbn, isbn) || !view.text(record.type, type) ||
+            (record.userNameCode >= loadedCodes && record.userNameCode != StringDictionary::NO_CODE) ||
+            (record.bookTitleCode >= loadedCodes && record.bookTitleCode != StringDictionary::NO_CODE)) {
+            cerr << "Warning: Skipped invalid transaction record" << endl;
+            continue;
+        }
+        transList->append(Transaction::restore(record.id, record.userID, string(isbn),
+                                               string(type), record.userNameCode,
+                                               record.bookTitleCode, record.copyNumber,
+                                               record.timestamp));
+        loaded++;
+    }
+    cout << "  ✓ Transactions loaded: " << loaded << " records" << endl;
+
+    // Holds of unknown users are dropped, as from holds.txt
+    loaded = 0;
+    for (uint64_t i = 0; i < view.count(HOLDS); i++) {
+        HoldRecord record = view.at<HoldRecord>(HOLDS, i);
+        string_view isbn;
+        if (view.text(record.isbn, isbn) && userMap->searchByID(record.userID) != nullptr &&
+            holds->place(record.userID, string(isbn), record.placedAt)) {
+            loaded++;
+        }
+    }
+    cout << "  ✓ Holds loaded: " << loaded << " records" << endl;
+
+    journalLSN = header.journalLSN;
+    return true;
+}
+
+bool BinarySnapshot::readGeneration(const string& filename, uint64_t& generation) {
+    ifstream file(filename, ios::binary);
+    Header header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || 
+        header.byteOrder != BYTE_ORDER_MARK || header.version != VERSION ||
+        header.headerCrc != Crc32c::compute(&header, offsetof(Header, headerCrc))) {
+        return false;
+    }
+    generation = header.generation;
+    return true;
+}
@@ -0,0 +1,56 @@
+// utils/BinarySnapshot.h
+#ifndef BINARYSNAPSHOT_H
+#define BINARYSNAPSHOT_H
+
+#include "FileHandler.h"
+#include <string>
+#include <ostream>
+#include <cstdint>
+using namespace std;
+
+// Binary form of a DataSnapshot, built to be mapped into memory and
+// loaded without parsing text. Layout (little-endian, sections 8-byte
+// aligned, in file order):
+//
+//     header        magic, version, byte-order mark, journal LSN, save
+//                   generation, file size, {offset, count} per section,
+//                   CRC-32C of the body, CRC-32C of the header
+//     DICTIONARY    u32 string id per StringDictionary code, code order
+//     BOOKS         24-byte records: isbn/title/author ids, copy count,
+//                   offset of the book's states in COPY_STATES
+//     COPY_STATES   one S/L/R byte per copy, as in books.txt
+//     USERS         40-byte records: ID, five string ids, active, and a
+//                   [first, first + count) range of BORROWED
+//     BORROWED      u32 ISBN string id per loan
+//     TRANSACTIONS  48-byte records: IDs, timestamp, isbn and type ids,
+//                   dictionary codes for name and title, copy number
+//     HOLDS         24-byte records: user ID, placed-at, isbn id
+//     STRING_OFFSETS  u64 start of each string in STRING_BYTES, plus
+//                   one for the end
+//     STRING_BYTES  every distinct string once, back to back
+//
+// Each distinct string (ISBN, title, name, hash, ...) is stored once,
+// however many records use it. The string table comes last so the
+// writer can stream records in one pass, interning as it goes. The
+// header counts let the loader size every container before filling it.
+class BinarySnapshot {
+public:
+    static const uint32_t VERSION = 2;   // 2: save generation in the header
+
+    // Writes snapshot plus the current StringDictionary (which only
+    // grows, so it covers every code the records use). out must be
+    // seekable: the header is written last.
+    static bool write(ostream& out, const DataSnapshot& snapshot);
+
+    // Loads into empty structures and an empty StringDictionary, and
+    // sets journalLSN to the snapshot's. Returns false, having loaded
+    // nothing, if the file is missing, from another version or corrupt.
+    static bool load(const string& filename, BookBST* bookTree, UserHashMap* userMap,
+                     TransactionList* transList, HoldQueues* holds, uint64_t& journalLSN);
+    
+    // Reads only the header; false, quietly, if the file is missing, from
+    // another version or its header is damaged (load says why)
+    static bool readGeneration(const string& filename, uint64_t& generation);
+};
+
+#endif // BINARYSNAPSHOT_H
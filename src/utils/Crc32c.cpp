@@ -0,0 +1,134 @@
+// utils/Crc32c.cpp
+#include "Crc32c.h"
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define CRC32C_X86 1
+    #include <nmmintrin.h>
+#elif defined(__GNUC__) && defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+    #define CRC32C_ARM 1
+    #include <arm_acle.h>
+#endif
+
+namespace {
+
+const uint32_t POLYNOMIAL = 0x82F63B78;   // Reflected Castagnoli
+
+// table[k][b]: CRC of byte b followed by k zero bytes
+struct SliceTables {
+    uint32_t table[8][256];
+
+    SliceTables() {
+        for (uint32_t b = 0; b < 256; b++) {
+            uint32_t crc = b;
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc >> 1) ^ ((crc & 1) ? POLYNOMIAL : 0);
+            }
+            table[0][b] = crc;
+        }
+        for (uint32_t b = 0; b < 256; b++) {
+            for (int k = 1; k < 8; k++) {
+                table[k][b] = (table[k - 1][b] >> 8) ^ table[0][table[k - 1][b] & 0xFF];
+            }
+        }
+    }
+};
+
+const SliceTables& tables() {
+    static const SliceTables instance;
+    return instance;
+}
+
+uint32_t extendSoftware(uint32_t crc, const unsigned char* p, size_t length) {
+    const uint32_t (*t)[256] = tables().table;
+    while (length >= 8) {
+        uint32_t low;
+        uint32_t high;
+        memcpy(&low, p, 4);
+        memcpy(&high, p + 4, 4);
+        low ^= crc;   // Little-endian byte order assumed, as everywhere here
+        crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^
+              t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^
+              t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^
+              t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+        p += 8;
+        length -= 8;
+    }
+    while (length-- > 0) {
+        crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xFF];
+    }
+    return crc;
+}
+
+#if defined(CRC32C_X86)
+__attribute__((target("sse4.2")))
+uint32_t extendHardware(uint32_t crc, const unsigned char* p, size_t length) {
+#if defined(__x86_64__)
+    uint64_t crc64 = crc;
+    while (length >= 8) {
+        uint64_t word;
+        memcpy(&word, p, 8);
+        crc64 = _mm_crc32_u64(crc64, word);
+        p += 8;
+        length -= 8;
+    }
+    crc = static_cast<uint32_t>(crc64);
+#endif
+    while (length >= 4) {
+        uint32_t word;
+        memcpy(&word, p, 4);
+        crc = _mm_crc32_u32(crc, word);
+        p += 4;
+        length -= 4;
+    }
+    while (length-- > 0) {
+        crc = _mm_crc32_u8(crc, *p++);
+    }
+    return crc;
+}
+
+bool detectHardware() {
+    return __builtin_cpu_supports("sse4.2");
+}
+#elif defined(CRC32C_ARM)
+uint32_t extendHardware(uint32_t crc, const unsigned char* p, size_t length) {
+    while (length >= 8) {
+        uint64_t word;
+        memcpy(&word, p, 8);
+        crc = __crc32cd(crc, word);
+        p += 8;
+        length -= 8;
+    }
+    while (length-- > 0) {
+        crc = __crc32cb(crc, *p++);
+    }
+    return crc;
+}
+
+bool detectHardware() {
+    return true;   // Compiled for a CPU with the CRC extension
+}
+#else
+uint32_t extendHardware(uint32_t crc, const unsigned char* p, size_t length) {
+    return extendSoftware(crc, p, length);
+}
+
+bool detectHardware() {
+    return false;
+}
+#endif
+
+const bool HAS_HARDWARE = detectHardware();
+
+}  // namespace
+
+uint32_t Crc32c::extend(uint32_t crc, const void* data, size_t length) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    crc = ~crc;
+    crc = HAS_HARDWARE ? extendHardware(crc, p, length) : extendSoftware(crc, p, length);
+    return ~crc;
+}
+
+bool Crc32c::isHardwareAccelerated() {
+    return HAS_HARDWARE;
+}
@@ -0,0 +1,25 @@
+// utils/Crc32c.h
+#ifndef CRC32C_H
+#define CRC32C_H
+
+#include <cstddef>
+#include <cstdint>
+using namespace std;
+
+// CRC-32C (Castagnoli), as used by iSCSI, ext4 and most storage logs.
+// Uses the SSE4.2 crc32 instruction (x86) or the ARMv8 CRC extension
+// when the CPU has it, checked once at startup; otherwise a
+// slicing-by-8 table, roughly a byte per cycle.
+class Crc32c {
+public:
+    // Extends crc (the result of a previous call, 0 to start) over data
+    static uint32_t extend(uint32_t crc, const void* data, size_t length);
+
+    static uint32_t compute(const void* data, size_t length) {
+        return extend(0, data, length);
+    }
+
+    static bool isHardwareAccelerated();
+};
+
+#endif // CRC32C_H
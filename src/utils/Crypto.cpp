@@ -0,0 +1,332 @@
+// utils/Crypto.cpp
+#include "Crypto.h"
+#include <random>
+#include <cstring>
+
+// ============ SHA-256 ============
+
+namespace {
+
+const uint32_t SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+inline uint32_t rotr(uint32_t x, int n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+inline uint32_t rotl(uint32_t x, int n) {
+    return (x << n) | (x >> (32 - n));
+}
+
+// Incremental SHA-256 so HMAC can hash key pad + message without copying
+class Sha256 {
+private:
+    uint32_t state[8];
+    uint8_t buffer[64];
+    size_t bufferLen;
+    uint64_t totalLen;
+
+    void compress(const uint8_t* block) {
+        uint32_t w[64];
+        for (int i = 0; i < 16; i++) {
+            w[i] = (uint32_t(block[i * 4]) << 24) | (uint32_t(block[i * 4 + 1]) << 16) |
+                   (uint32_t(block[i * 4 + 2]) << 8) | uint32_t(block[i * 4 + 3]);
+        }
+        for (int i = 16; i < 64; i++) {
+            uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+        for (int i = 0; i < 64; i++) {
+            uint32_t S1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+            uint32_t ch = (e & f) ^ (~e & g);
+            uint32_t temp1 = h + S1 + ch + SHA256_K[i] + w[i];
+            uint32_t S0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+            uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+            uint32_t temp2 = S0 + maj;
+
+            h = g; g = f; f = e; e = d + temp1;
+            d = c; c = b; b = a; a = temp1 + temp2;
+        }
+
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+    }
+
+public:
+    Sha256() : bufferLen(0), totalLen(0) {
+        static const uint32_t init[8] = {
+            0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+            0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+        };
+        memcpy(state, init, sizeof(state));
+    }
+
+    void update(const uint8_t* data, size_t len) {
+        totalLen += len;
+        while (len > 0) {
+            size_t take = 64 - bufferLen;
+            if (take > len) take = len;
+            memcpy(buffer + bufferLen, data, take);
+            bufferLen += take;
+            data += take;
+            len -= take;
+            if (bufferLen == 64) {
+                compress(buffer);
+                bufferLen = 0;
+            }
+        }
+    }
+
+    void finish(uint8_t out[32]) {
+        uint64_t bitLen = totalLen * 8;
+        uint8_t pad = 0x80;
+        update(&pad, 1);
+        uint8_t zero = 0;
+        while (bufferLen != 56) {
+            update(&zero, 1);
+        }
+        uint8_t lenBytes[8];
+        for (int i = 0; i < 8; i++) {
+            lenBytes[i] = static_cast<uint8_t>(bitLen >> (56 - 8 * i));
+        }
+        update(lenBytes, 8);
+        for (int i = 0; i < 8; i++) {
+            out[i * 4] = static_cast<uint8_t>(state[i] >> 24);
+            out[i * 4 + 1] = static_cast<uint8_t>(state[i] >> 16);
+            out[i * 4 + 2] = static_cast<uint8_t>(state[i] >> 8);
+            out[i * 4 + 3] = static_cast<uint8_t>(state[i]);
+        }
+    }
+};
+
+// ============ SCRYPT CORE ============
+
+void salsa20_8(uint32_t B[16]) {
+    uint32_t x[16];
+    memcpy(x, B, sizeof(x));
+    for (int i = 0; i < 8; i += 2) {
+        // Columns
+        x[4] ^= rotl(x[0] + x[12], 7);   x[8] ^= rotl(x[4] + x[0], 9);
+        x[12] ^= rotl(x[8] + x[4], 13);  x[0] ^= rotl(x[12] + x[8], 18);
+        x[9] ^= rotl(x[5] + x[1], 7);    x[13] ^= rotl(x[9] + x[5], 9);
+        x[1] ^= rotl(x[13] + x[9], 13);  x[5] ^= rotl(x[1] + x[13], 18);
+        x[14] ^= rotl(x[10] + x[6], 7);  x[2] ^= rotl(x[14] + x[10], 9);
+        x[6] ^= rotl(x[2] + x[14], 13);  x[10] ^= rotl(x[6] + x[2], 18);
+        x[3] ^= rotl(x[15] + x[11], 7);  x[7] ^= rotl(x[3] + x[15], 9);
+        x[11] ^= rotl(x[7] + x[3], 13);  x[15] ^= rotl(x[11] + x[7], 18);
+        // Rows
+        x[1] ^= rotl(x[0] + x[3], 7);    x[2] ^= rotl(x[1] + x[0], 9);
+        x[3] ^= rotl(x[2] + x[1], 13);   x[0] ^= rotl(x[3] + x[2], 18);
+        x[6] ^= rotl(x[5] + x[4], 7);    x[7] ^= rotl(x[6] + x[5], 9);
+        x[4] ^= rotl(x[7] + x[6], 13);   x[5] ^= rotl(x[4] + x[7], 18);
+        x[11] ^= rotl(x[10] + x[9], 7);  x[8] ^= rotl(x[11] + x[10], 9);
+        x[9] ^= rotl(x[8] + x[11], 13);  x[10] ^= rotl(x[9] + x[8], 18);
+        x[12] ^= rotl(x[15] + x[14], 7); x[13] ^= rotl(x[12] + x[15], 9);
+        x[14] ^= rotl(x[13] + x[12], 13); x[15] ^= rotl(x[14] + x[13], 18);
+    }
+    for (int i = 0; i < 16; i++) {
+        B[i] += x[i];
+    }
+}
+
+// BlockMix over 2r 64-byte blocks; Y is scratch of the same size
+void blockMix(uint32_t* B, uint32_t* Y, uint32_t r) {
+    uint32_t X[16];
+    memcpy(X, &B[(2 * r - 1) * 16], 64);
+
+    for (uint32_t i = 0; i < 2 * r; i++) {
+        for (int k = 0; k < 16; k++) {
+            X[k] ^= B[i * 16 + k];
+        }
+        salsa20_8(X);
+        // Even blocks to the first half, odd blocks to the second
+        uint32_t dest = (i / 2) + (i & 1) * r;
+        memcpy(&Y[dest * 16], X, 64);
+    }
+    memcpy(B, Y, 128 * r);
+}
+
+void roMix(uint8_t* block, uint32_t r, uint64_t N, vector<uint32_t>& V) {
+    size_t words = 32 * r;
+    vector<uint32_t> X(words), Y(words);
+
+    for (size_t k = 0; k < words; k++) {
+        const uint8_t* p = block + 4 * k;
+        X[k] = uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+    }
+
+    for (uint64_t i = 0; i < N; i++) {
+        memcpy(&V[i * words], X.data(), words * 4);
+        blockMix(X.data(), Y.data(), r);
+    }
+    for (uint64_t i = 0; i < N; i++) {
+        uint64_t j = X[(2 * r - 1) * 16] & (N - 1);   // Integerify
+        for (size_t k = 0; k < words; k++) {
+            X[k] ^= V[j * words + k];
+        }
+        blockMix(X.data(), Y.data(), r);
+    }
+
+    for (size_t k = 0; k < words; k++) {
+        uint8_t* p = block + 4 * k;
+        p[0] = static_cast<uint8_t>(X[k]);
+        p[1] = static_cast<uint8_t>(X[k] >> 8);
+        p[2] = static_cast<uint8_t>(X[k] >> 16);
+        p[3] = static_cast<uint8_t>(X[k] >> 24);
+    }
+}
+
+} // namespace
+
+// ============ PUBLIC API ============
+
+vector<uint8_t> Crypto::sha256(const uint8_t* data, size_t len) {
+    Sha256 ctx;
+    ctx.update(data, len);
+    vector<uint8_t> out(32);
+    ctx.finish(out.data());
+    return out;
+}
+
+vector<uint8_t> Crypto::hmacSha256(const uint8_t* key, size_t keyLen,
+                                   const uint8_t* data, size_t dataLen) {
+    uint8_t keyBlock[64] = {0};
+    if (keyLen > 64) {
+        vector<uint8_t> hashed = sha256(key, keyLen);
+        memcpy(keyBlock, hashed.data(), hashed.size());
+    } else if (keyLen > 0) {
+        memcpy(keyBlock, key, keyLen);
+    }
+
+    uint8_t ipad[64], opad[64];
+    for (int i = 0; i < 64; i++) {
+        ipad[i] = keyBlock[i] ^ 0x36;
+        opad[i] = keyBlock[i] ^ 0x5c;
+    }
+
+    uint8_t inner[32];
+    Sha256 innerCtx;
+    innerCtx.update(ipad, 64);
+    innerCtx.update(data, dataLen);
+    innerCtx.finish(inner);
+
+    vector<uint8_t> out(32);
+    Sha256 outerCtx;
+    outerCtx.update(opad, 64);
+    outerCtx.update(inner, 32);
+    outerCtx.finish(out.data());
+    return out;
+}
+
+vector<uint8_t> Crypto::pbkdf2Sha256(const uint8_t* password, size_t passwordLen,
+                                     const uint8_t* salt, size_t saltLen,
+                                     uint32_t iterations, size_t outLen) {
+    vector<uint8_t> out;
+    out.reserve(outLen);
+    vector<uint8_t> saltBlock(salt, salt + saltLen);
+    saltBlock.resize(saltLen + 4);
+
+    for (uint32_t blockIndex = 1; out.size() < outLen; blockIndex++) {
+        saltBlock[saltLen] = static_cast<uint8_t>(blockIndex >> 24);
+        saltBlock[saltLen + 1] = static_cast<uint8_t>(blockIndex >> 16);
+        saltBlock[saltLen + 2] = static_cast<uint8_t>(blockIndex >> 8);
+        saltBlock[saltLen + 3] = static_cast<uint8_t>(blockIndex);
+
+        vector<uint8_t> u = hmacSha256(password, passwordLen, saltBlock.data(), saltBlock.size());
+        vector<uint8_t> t = u;
+        for (uint32_t i = 1; i < iterations; i++) {
+            u = hmacSha256(password, passwordLen, u.data(), u.size());
+            for (size_t k = 0; k < t.size(); k++) {
+                t[k] ^= u[k];
+            }
+        }
+
+        size_t take = outLen - out.size();
+        if (take > t.size()) take = t.size();
+        out.insert(out.end(), t.begin(), t.begin() + take);
+    }
+    return out;
+}
+
+vector<uint8_t> Crypto::scrypt(const string& password, const vector<uint8_t>& salt,
+                               uint64_t N, uint32_t r, uint32_t p, size_t outLen) {
+    const uint8_t* pw = reinterpret_cast<const uint8_t*>(password.data());
+    size_t blockSize = 128 * r;
+
+    vector<uint8_t> B = pbkdf2Sha256(pw, password.size(), salt.data(), salt.size(),
+                                     1, p * blockSize);
+
+    vector<uint32_t> V(32 * r * N);   // The memory-hard scratch area
+    for (uint32_t i = 0; i < p; i++) {
+        roMix(&B[i * blockSize], r, N, V);
+    }
+
+    return pbkdf2Sha256(pw, password.size(), B.data(), B.size(), 1, outLen);
+}
+
+// ============ HELPERS ============
+
+vector<uint8_t> Crypto::randomBytes(size_t count) {
+    random_device rd;
+    vector<uint8_t> out(count);
+    for (size_t i = 0; i < count; i++) {
+        out[i] = static_cast<uint8_t>(rd());
+    }
+    return out;
+}
+
+string Crypto::toHex(const vector<uint8_t>& bytes) {
+    static const char digits[] = "0123456789abcdef";
+    string hex;
+    hex.reserve(bytes.size() * 2);
+    for (uint8_t b : bytes) {
+        hex += digits[b >> 4];
+        hex += digits[b & 0x0F];
+    }
+    return hex;
+}
+
+vector<uint8_t> Crypto::fromHex(const string& hex) {
+    if (hex.size() % 2 != 0) {
+        return vector<uint8_t>();
+    }
+    vector<uint8_t> out(hex.size() / 2);
+    for (size_t i = 0; i < out.size(); i++) {
+        int value = 0;
+        for (int k = 0; k < 2; k++) {
+            char c = hex[i * 2 + k];
+            int nibble;
+            if (c >= '0' && c <= '9') nibble = c - '0';
+            else if (c >= 'a' && c <= 'f') nibble = c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') nibble = c - 'A' + 10;
+            else return vector<uint8_t>();
+            value = value * 16 + nibble;
+        }
+        out[i] = static_cast<uint8_t>(value);
+    }
+    return out;
+}
+
+bool Crypto::constantTimeEquals(const vector<uint8_t>& a, const vector<uint8_t>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    uint8_t diff = 0;
+    for (size_t i = 0; i < a.size(); i++) {
+        diff |= a[i] ^ b[i];
+    }
+    return diff == 0;
+}
@@ -0,0 +1,33 @@
+// utils/Crypto.h
+#ifndef CRYPTO_H
+#define CRYPTO_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+using namespace std;
+
+// In-tree password hashing primitives: SHA-256, HMAC-SHA-256,
+// PBKDF2-HMAC-SHA-256 and scrypt (RFC 7914). No external dependencies.
+class Crypto {
+public:
+    static vector<uint8_t> sha256(const uint8_t* data, size_t len);
+    static vector<uint8_t> hmacSha256(const uint8_t* key, size_t keyLen,
+                                      const uint8_t* data, size_t dataLen);
+    static vector<uint8_t> pbkdf2Sha256(const uint8_t* password, size_t passwordLen,
+                                        const uint8_t* salt, size_t saltLen,
+                                        uint32_t iterations, size_t outLen);
+
+    // Memory-hard KDF: uses 128 * r * N bytes of scratch memory.
+    // N must be a power of two greater than 1.
+    static vector<uint8_t> scrypt(const string& password, const vector<uint8_t>& salt,
+                                  uint64_t N, uint32_t r, uint32_t p, size_t outLen);
+
+    // Helpers
+    static vector<uint8_t> randomBytes(size_t count);
+    static string toHex(const vector<uint8_t>& bytes);
+    static vector<uint8_t> fromHex(const string& hex);   // Empty on bad input
+    static bool constantTimeEquals(const vector<uint8_t>& a, const vector<uint8_t>& b);
+};
+
+#endif // CRYPTO_H
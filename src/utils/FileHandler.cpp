@@ -1,16 +1,37 @@
 // utils/FileHandler.cpp
 #include "FileHandler.h"
+#include "BinarySnapshot.h"
 #include "../utils/StringUtils.h"
+#include "../utils/StringDictionary.h"
+#include "../utils/TimeUtils.h"
+#include "../Config.h"
 #include <fstream>
 #include <iostream>
 #include <algorithm>
+#include <filesystem>
 #include <sys/stat.h>  // For directory creation
 
 #ifdef _WIN32
     #include <direct.h>
+    #include <io.h>
+    #include <fcntl.h>
     #define mkdir _mkdir
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
 #endif
 
+uint64_t FileHandler::lastGeneration = 0;
+
+// Header line carrying the save generation in each CSV file
+static const string GENERATION_PREFIX = "# Save generation: ";
+
+static vector<string> stampedHeader(const vector<string>& header, uint64_t generation) {
+    vector<string> lines = header;
+    lines.push_back(GENERATION_PREFIX + to_string(generation));
+    return lines;
+}
+
 // ============ HELPER: CREATE DIRECTORY ============
 
 bool createDirectory(const string& path) {
@@ -21,6 +42,31 @@ bool createDirectory(const string& path) {
     #endif
 }
 
+// ============ HELPER: SYNC TO DISK ============
+
+// Flushes a closed file, or a directory's entries, out of the OS cache.
+// Windows cannot open directories this way and commits renames itself.
+static bool syncPath(const string& path, bool directory) {
+    #ifdef _WIN32
+        if (directory) {
+            return true;
+        }
+        int fd = _open(path.c_str(), _O_RDWR | _O_BINARY);
+        bool success = fd >= 0 && _commit(fd) == 0;
+        if (fd >= 0) {
+            _close(fd);
+        }
+        return success;
+    #else
+        int fd = open(path.c_str(), directory ? O_RDONLY | O_DIRECTORY : O_RDONLY);
+        bool success = fd >= 0 && fsync(fd) == 0;
+        if (fd >= 0) {
+            close(fd);
+        }
+        return success;
+    #endif
+}
+
 // ============ FILE OPERATIONS ============
 
 bool FileHandler::fileExists(const string& filename) {
@@ -65,30 +111,106 @@ vector<string> FileHandler::readLines(const string& filename) {
 }
 
 bool FileHandler::writeLines(const string& filename, const vector<string>& lines) {
+    return writeFile(filename, [&lines](ostream& out) {
+        for (const string& line : lines) {
+            out << line << '\n';
+        }
+    });
+}
+
+// Write a side file, sync it, and rename it over the old one, so a crash
+// mid-save leaves the previous version intact. The directory is synced
+// last: only then has the rename itself reached the disk, and callers
+// trim the journal only after every file returned true.
+bool FileHandler::writeFile(const string& filename, const function<void(ostream&)>& body, 
+                            bool binary) {
     // Ensure directory exists
+    string dir = ".";
     size_t lastSlash = filename.find_last_of("/\\");
     if (lastSlash != string::npos) {
-        string dir = filename.substr(0, lastSlash);
+        dir = filename.substr(0, lastSlash);
         createDirectory(dir);
     }
     
-    ofstream file(filename);
+    string tempName = filename + ".tmp";
+    ofstream file(tempName, binary ? ios::out | ios::binary : ios::out);
     
     if (!file.is_open()) {
         cerr << "Error: Could not open file for writing: " << filename << endl;
         return false;
     }
     
-    for (const string& line : lines) {
-        file << line << endl;
+    body(file);
+    file.close();
+    if (file.fail() || !syncPath(tempName, false)) {
+        cerr << "Error: Could not write file: " << filename << endl;
+        return false;
     }
     
-    file.close();
+    error_code error;
+    filesystem::rename(tempName, filename, error);
+    if (error) {
+        cerr << "Error: Could not replace file: " << filename << endl;
+        return false;
+    }
+    if (!syncPath(dir, true)) {
+        cerr << "Error: Could not sync directory: " << dir << endl;
+        return false;
+    }
     return true;
 }
 
+bool FileHandler::writeRecords(const string& filename, const vector<string>& header, 
+                               const vector<string>& records) {
+    return writeFile(filename, [&header, &records](ostream& out) {
+        for (const string& line : header) {
+            out << line << '\n';
+        }
+        for (const string& line : records) {
+            out << line << '\n';
+        }
+    });
+}
+
+// Formats as it writes, so no line vector is built
+template <typename Records>
+bool FileHandler::writeObjects(const string& filename, const vector<string>& header, 
+                               const Records& records) {
+    return writeFile(filename, [&header, &records](ostream& out) {
+        for (const string& line : header) {
+            out << line << '\n';
+        }
+        for (const auto& record : records) {
+            out << record.toFileString() << '\n';
+        }
+    });
+}
+
+void FileHandler::report(bool success, const string& what, size_t records) {
+    if (success) {
+        cout << "  ✓ " << what << " saved: " << records << " records" << endl;
+    } else {
+        cerr << "  ✗ Failed to save " << StringUtils::toLower(what) << endl;
+    }
+}
+
+// False if either file is missing
+bool FileHandler::isNewer(const string& filename, const string& than) {
+    error_code error;
+    auto time = filesystem::last_write_time(filename, error);
+    if (error) {
+        return false;
+    }
+    auto thanTime = filesystem::last_write_time(than, error);
+    return !error && time > thanTime;
+}
 // ============ BOOK OPERATIONS ============
 
+static const vector<string> BOOKS_HEADER = {
+    "# Library Books Data",
+    "# Format: ISBN,Title,Author,Quantity,AvailableCopies,CopyStates(S=shelf,L=loan,R=retired)"
+};
+
 bool FileHandler::saveBooks(const string& filename, BookBST* bookTree) {
     if (bookTree == nullptr) {
         cerr << "Error: BookBST is null" << endl;
@@ -96,23 +218,13 @@ bool FileHandler::saveBooks(const string& filename, BookBST* bookTree) {
     }
     
     vector<string> lines;
-    lines.push_back("# Library Books Data");
-    lines.push_back("# Format: ISBN,Title,Author,Quantity,AvailableCopies");
-    
-    vector<Book*> books = bookTree->getAllBooksSorted();
-    for (Book* book : books) {
+    for (Book* book : bookTree->getAllBooksSorted()) {
         lines.push_back(book->toFileString());
     }
-    
-    bool success = writeLines(filename, lines);
-    if (success) {
-        cout << "  ✓ Books saved: " << books.size() << " records" << endl;
-    } else {
-        cerr << "  ✗ Failed to save books" << endl;
-    }
+    bool success = writeRecords(filename, BOOKS_HEADER, lines);
+    report(success, "Books", lines.size());
     return success;
 }
-
 bool FileHandler::loadBooks(const string& filename, BookBST* bookTree) {
     if (bookTree == nullptr) {
         cerr << "Error: BookBST is null" << endl;
@@ -145,30 +257,22 @@ bool FileHandler::loadBooks(const string& filename, BookBST* bookTree) {
 
 // ============ USER OPERATIONS ============
 
+static const vector<string> USERS_HEADER = {
+    "# Library Users Data",
+    "# Format: UserID,Username,PasswordHash,FullName,Email,Phone,Active,BorrowedISBNs"
+};
+
 bool FileHandler::saveUsers(const string& filename, UserHashMap* userMap) {
     if (userMap == nullptr) {
         cerr << "Error: UserHashMap is null" << endl;
         return false;
     }
     
-    vector<string> lines;
-    lines.push_back("# Library Users Data");
-    lines.push_back("# Format: UserID,Username,PasswordHash,FullName,Email,Phone,Active,BorrowedISBNs");
-    
-    vector<User*> users = userMap->getAllUsers();
-    for (User* user : users) {
-        lines.push_back(user->toFileString());
-    }
-    
-    bool success = writeLines(filename, lines);
-    if (success) {
-        cout << "  ✓ Users saved: " << users.size() << " records" << endl;
-    } else {
-        cerr << "  ✗ Failed to save users" << endl;
-    }
+    Span<const User> users = userMap->getAllUsers();
+    bool success = writeObjects(filename, USERS_HEADER, users);
+    report(success, "Users", users.size());
     return success;
 }
-
 bool FileHandler::loadUsers(const string& filename, UserHashMap* userMap) {
     if (userMap == nullptr) {
         cerr << "Error: UserHashMap is null" << endl;
@@ -181,21 +285,17 @@ bool FileHandler::loadUsers(const string& filename, UserHashMap* userMap) {
     }
     
     vector<string> lines = readLines(filename);
-    int maxUserID = 0;
     int loaded = 0;
     
     for (const string& line : lines) {
         try {
             User user = User::fromFileString(line);
-            if (!user.getUserID().empty()) {  // Valid user
-                // Extract user ID number for counter update
-                string idStr = user.getUserID().substr(1);  // Remove 'U'
-                int idNum = stoi(idStr);
-                maxUserID = max(maxUserID, idNum);
+            if (user.getID() != 0) {  // Valid user
+                // Keep new IDs above every loaded one
+                User::idGenerator.observe(user.getID());
                 
-                // Insert user (need to allocate on heap)
-                User* userPtr = new User(user);
-                userMap->insert(userPtr);
+                // Insert user (copied into the map's dense storage)
+                userMap->insert(user);
                 loaded++;
             }
         } catch (...) {
@@ -203,39 +303,39 @@ bool FileHandler::loadUsers(const string& filename, UserHashMap* userMap) {
         }
     }
     
-    // FIX #3: Update user counter to prevent duplicate IDs
-    User::userCounter = maxUserID + 1;
-    
     cout << "  ✓ Users loaded: " << loaded << " records" << endl;
     return loaded > 0;
 }
 
 // ============ TRANSACTION OPERATIONS ============
 
+// Streamed: the log can be far too large to hold as lines
+// generation 0 = not part of a snapshot save, so no stamp
+bool FileHandler::writeTransactions(const string& filename, 
+                                    const TransactionList::Prefix& transactions, 
+                                    uint64_t generation) {
+    return writeFile(filename, [&transactions, generation](ostream& out) {
+        out << "# Library Transactions Data\n"
+            << "# Format: TransactionID,UserID,ISBN,Type,Timestamp(UTC),@UserNameCode,@BookTitleCode,Copy\n";
+        if (generation != 0) {
+            out << GENERATION_PREFIX << generation << '\n';
+        }
+        for (size_t seq = 0; seq < transactions.size(); seq++) {
+            out << transactions[seq]->toFileString() << '\n';
+        }
+    });
+}
+
 bool FileHandler::saveTransactions(const string& filename, TransactionList* transList) {
     if (transList == nullptr) {
         cerr << "Error: TransactionList is null" << endl;
         return false;
     }
     
-    vector<string> lines;
-    lines.push_back("# Library Transactions Data");
-    lines.push_back("# Format: TransactionID,UserID,ISBN,Type,Timestamp,UserName,BookTitle");
-    
-    vector<Transaction*> transactions = transList->getAll();
-    for (Transaction* trans : transactions) {
-        lines.push_back(trans->toFileString());
-    }
-    
-    bool success = writeLines(filename, lines);
-    if (success) {
-        cout << "  ✓ Transactions saved: " << transactions.size() << " records" << endl;
-    } else {
-        cerr << "  ✗ Failed to save transactions" << endl;
-    }
+    bool success = writeTransactions(filename, transList->getPrefix(), 0);
+    report(success, "Transactions", transList->size());
     return success;
 }
-
 bool FileHandler::loadTransactions(const string& filename, TransactionList* transList) {
     if (transList == nullptr) {
         cerr << "Error: TransactionList is null" << endl;
@@ -248,21 +348,17 @@ bool FileHandler::loadTransactions(const string& filename, TransactionList* tran
     }
     
     vector<string> lines = readLines(filename);
-    int maxTransID = 0;
     int loaded = 0;
     
     for (const string& line : lines) {
         try {
             Transaction trans = Transaction::fromFileString(line);
-            if (!trans.getTransactionID().empty()) {  // Valid transaction
-                // Extract transaction ID number for counter update
-                string idStr = trans.getTransactionID().substr(1);  // Remove 'T'
-                int idNum = stoi(idStr);
-                maxTransID = max(maxTransID, idNum);
+            if (trans.getID() != 0) {  // Valid transaction
+                // Keep new IDs above every loaded one
+                Transaction::idGenerator.observe(trans.getID());
                 
-                // Insert transaction (allocate on heap)
-                Transaction* transPtr = new Transaction(trans);
-                transList->append(transPtr);
+                // Copied into the log's chunk storage
+                transList->append(move(trans));
                 loaded++;
             }
         } catch (...) {
@@ -270,9 +366,336 @@ bool FileHandler::loadTransactions(const string& filename, TransactionList* tran
         }
     }
     
-    // FIX #3: Update transaction counter to prevent duplicate IDs
-    Transaction::transactionCounter = maxTransID + 1;
-    
     cout << "  ✓ Transactions loaded: " << loaded << " records" << endl;
     return loaded > 0;
-}
\ No newline at end of file
+}
+
+// ============ STRING DICTIONARY OPERATIONS ============
+
+static const vector<string> STRINGS_HEADER = {
+    "# Interned Strings (user names, book titles)",
+    "# Format: Code,Text"
+};
+
+bool FileHandler::saveStrings(const string& filename) {
+    vector<string> entries = StringDictionary::getInstance()->toFileLines();
+    bool success = writeRecords(filename, STRINGS_HEADER, entries);
+    report(success, "Strings", entries.size());
+    return success;
+}
+bool FileHandler::loadStrings(const string& filename) {
+    if (!fileExists(filename)) {
+        cout << "  ℹ No strings file found (will be created on first save)" << endl;
+        return false;
+    }
+    
+    StringDictionary* dictionary = StringDictionary::getInstance();
+    vector<string> lines = readLines(filename);
+    int loaded = 0;
+    
+    for (const string& line : lines) {
+        if (dictionary->loadFileLine(line)) {
+            loaded++;
+        } else {
+            // Later codes would shift, so stop at the first bad entry
+            cerr << "Warning: Invalid strings entry, stopped at code " << loaded << endl;
+            break;
+        }
+    }
+    
+    cout << "  ✓ Strings loaded: " << loaded << " records" << endl;
+    return loaded > 0;
+}
+
+// ============ HOLD QUEUE OPERATIONS ============
+
+static const vector<string> HOLDS_HEADER = {
+    "# Hold Queues (each book's holds in queue order)",
+    "# Format: ISBN,UserID,PlacedAt(UTC)"
+};
+
+bool FileHandler::saveHolds(const string& filename, HoldQueues* holds) {
+    if (holds == nullptr) {
+        cerr << "Error: HoldQueues is null" << endl;
+        return false;
+    }
+    
+    vector<string> lines = holds->toFileLines();
+    bool success = writeRecords(filename, HOLDS_HEADER, lines);
+    report(success, "Holds", lines.size());
+    return success;
+}
+bool FileHandler::loadHolds(const string& filename, HoldQueues* holds, UserHashMap* userMap) {
+    if (holds == nullptr || userMap == nullptr) {
+        cerr << "Error: HoldQueues or UserHashMap is null" << endl;
+        return false;
+    }
+    
+    if (!fileExists(filename)) {
+        cout << "  ℹ No holds file found (will be created on first save)" << endl;
+        return false;
+    }
+    
+    vector<string> lines = readLines(filename);
+    int loaded = 0;
+    
+    for (const string& line : lines) {
+        vector<string> fields = StringUtils::splitCSV(line);
+        uint64_t userID;
+        int64_t placedAt;
+        if (fields.size() != 3 || !User::parseID(fields[1], userID) || 
+            !TimeUtils::parse(fields[2], placedAt)) {
+            cerr << "Warning: Skipped invalid hold line" << endl;
+            continue;
+        }
+        
+        if (userMap->searchByID(userID) != nullptr && 
+            holds->place(userID, fields[0], placedAt)) {
+            loaded++;
+        }
+    }
+    
+    cout << "  ✓ Holds loaded: " << loaded << " records" << endl;
+    return loaded > 0;
+}
+
+// ============ CHECKPOINT OPERATIONS ============
+
+bool FileHandler::saveCheckpoint(const string& filename, uint64_t lsn, uint64_t generation) {
+    vector<string> lines;
+    lines.push_back("# Last journal record included in the saved files, then their save generation");
+    lines.push_back(to_string(lsn));
+    lines.push_back(to_string(generation));
+    return writeLines(filename, lines);
+}
+
+uint64_t FileHandler::loadCheckpoint(const string& filename, uint64_t& generation) {
+    generation = 0;
+    vector<string> lines = readLines(filename);
+    if (lines.empty()) {
+        return 0;  // No snapshot yet: replay the whole journal
+    }
+    try {
+        if (lines.size() > 1) {
+            generation = stoull(lines[1]);   // Absent before generations existed
+        }
+        return stoull(lines[0]);
+    } catch (...) {
+        cerr << "Warning: Invalid checkpoint, replaying the whole journal" << endl;
+        generation = 0;
+        return 0;
+    }
+}
+
+// ============ SAVE GENERATIONS ============
+
+// Only the comment lines at the top are read
+uint64_t FileHandler::readGeneration(const string& filename) {
+    ifstream file(filename);
+    string line;
+    while (getline(file, line) && !line.empty() && line[0] == '#') {
+        if (line.compare(0, GENERATION_PREFIX.length(), GENERATION_PREFIX) == 0) {
+            try {
+                return stoull(line.substr(GENERATION_PREFIX.length()));
+            } catch (...) {
+                return 0;
+            }
+        }
+    }
+    return 0;
+}
+
+// A save writes the five files, then the checkpoint naming their
+// generation. The set is complete only if every file carries that
+// generation and none was changed after the checkpoint: a save that
+// stopped partway leaves newer stamps than the checkpoint, and an edit
+// by something else (the Node backend, a text editor) leaves a file
+// newer than it. Every stamp seen is noted, so later saves number above
+// even an unfinished one.
+bool FileHandler::isCompleteCSVSet(uint64_t& generation) {
+    loadCheckpoint(CHECKPOINT_FILE, generation);
+    noteGeneration(generation);
+    
+    bool complete = (generation != 0);
+    for (const string& csvFile : {BOOKS_FILE, USERS_FILE, STRINGS_FILE, 
+                                  TRANSACTIONS_FILE, HOLDS_FILE}) {
+        uint64_t stamp = readGeneration(csvFile);
+        noteGeneration(stamp);
+        if (stamp != generation || isNewer(csvFile, CHECKPOINT_FILE)) {
+            complete = false;
+        }
+    }
+    return complete;
+}
+
+void FileHandler::noteGeneration(uint64_t generation) {
+    lastGeneration = max(lastGeneration, generation);
+}
+
+// ============ SNAPSHOT OPERATIONS ============
+
+DataSnapshot FileHandler::captureSnapshot(BookBST* bookTree, UserHashMap* userMap, 
+                                          TransactionList* transList, HoldQueues* holds, 
+                                          uint64_t journalLSN) {
+    DataSnapshot snapshot;
+    snapshot.journalLSN = journalLSN;
+    snapshot.generation = ++lastGeneration;
+    for (Book* book : bookTree->getAllBooksSorted()) {
+        snapshot.books.push_back(*book);
+    }
+    Span<const User> users = userMap->getAllUsers();
+    snapshot.users.assign(users.begin(), users.end());
+    snapshot.holds = holds->getAll();
+    snapshot.transactions = transList->getPrefix();
+    return snapshot;
+}
+
+// Same files and order as the individual saves. The dictionary is read
+// now rather than captured: it only grows and codes never change, so
+// it covers every code the captured records use.
+bool FileHandler::saveCSV(const DataSnapshot& snapshot, bool verbose) {
+    vector<string> strings = StringDictionary::getInstance()->toFileLines();
+    vector<string> holdLines;
+    holdLines.reserve(snapshot.holds.size());
+    for (const auto& entry : snapshot.holds) {
+        holdLines.push_back(HoldQueues::toFileLine(entry.first, entry.second));
+    }
+    
+    uint64_t generation = snapshot.generation;
+    bool books = writeObjects(BOOKS_FILE, stampedHeader(BOOKS_HEADER, generation), 
+                              snapshot.books);
+    bool users = writeObjects(USERS_FILE, stampedHeader(USERS_HEADER, generation), 
+                              snapshot.users);
+    bool dictionary = writeRecords(STRINGS_FILE, stampedHeader(STRINGS_HEADER, generation), 
+                                   strings);
+    bool transactions = writeTransactions(TRANSACTIONS_FILE, snapshot.transactions, generation);
+    bool holdQueues = writeRecords(HOLDS_FILE, stampedHeader(HOLDS_HEADER, generation), 
+                                   holdLines);
+    
+    if (verbose) {
+        report(books, "Books", snapshot.books.size());
+        report(users, "Users", snapshot.users.size());
+        report(dictionary, "Strings", strings.size());
+        report(transactions, "Transactions", snapshot.transactions.size());
+        report(holdQueues, "Holds", holdLines.size());
+    }
+    
+    // The checkpoint moves only once every file holds the snapshot
+    return books && users && dictionary && transactions && holdQueues && 
+           saveCheckpoint(CHECKPOINT_FILE, snapshot.journalLSN, generation);
+}
+
+bool FileHandler::saveBinary(const DataSnapshot& snapshot, bool verbose) {
+    bool written = false;
+    bool success = writeFile(SNAPSHOT_FILE, [&snapshot, &written](ostream& out) {
+        written = BinarySnapshot::write(out, snapshot);
+    }, true) && written;
+    
+    if (verbose) {
+        report(success, "Binary snapshot", snapshot.books.size() + snapshot.users.size() + 
+                                           snapshot.transactions.size() + snapshot.holds.size());
+    }
+    return success;
+}
+
+// Both formats carry the same generation. The binary snapshot goes last,
+// so a save that stops after the CSV set leaves that set the later one.
+bool FileHandler::saveSnapshot(const DataSnapshot& snapshot, bool verbose) {
+    bool csv = !SNAPSHOT_WRITE_CSV || saveCSV(snapshot, verbose);
+    bool binary = saveBinary(snapshot, verbose);
+    return csv && binary;
+}
+
+bool FileHandler::loadCSV(BookBST* bookTree, UserHashMap* userMap, 
+                          TransactionList* transList, HoldQueues* holds, 
+                          uint64_t& journalLSN) {
+    bool success = true;
+    success &= loadBooks(BOOKS_FILE, bookTree);
+    success &= loadUsers(USERS_FILE, userMap);
+    loadStrings(STRINGS_FILE);  // Absent for pre-dictionary data
+    success &= loadTransactions(TRANSACTIONS_FILE, transList);
+    loadHolds(HOLDS_FILE, holds, userMap);  // Absent if nobody waits
+    
+    uint64_t generation = 0;
+    journalLSN = loadCheckpoint(CHECKPOINT_FILE, generation);
+    noteGeneration(generation);
+    return success;
+}
+
+// Whichever format holds the later complete save wins; both carry its
+// generation. CSV files that are not one complete save (a save stopped
+// partway through them, or something else edited one) never win over a
+// usable binary snapshot: the snapshot plus the journal is the
+// consistent state. --import-csv takes such files deliberately.
+bool FileHandler::loadSnapshot(BookBST* bookTree, UserHashMap* userMap, 
+                               TransactionList* transList, HoldQueues* holds, 
+                               uint64_t& journalLSN) {
+    uint64_t csvGeneration = 0;
+    bool csvComplete = isCompleteCSVSet(csvGeneration);
+    
+    if (fileExists(SNAPSHOT_FILE)) {
+        uint64_t binaryGeneration = 0;
+        BinarySnapshot::readGeneration(SNAPSHOT_FILE, binaryGeneration);   // 0 if unusable
+        noteGeneration(binaryGeneration);
+        
+        if (csvComplete && csvGeneration > binaryGeneration) {
+            cout << "  ℹ The CSV files hold a later save than the binary snapshot; loading them" << endl;
+            return loadCSV(bookTree, userMap, transList, holds, journalLSN);
+        }
+        
+        if (!csvComplete) {
+            for (const string& csvFile : {BOOKS_FILE, USERS_FILE, STRINGS_FILE, 
+                                          TRANSACTIONS_FILE, HOLDS_FILE}) {
+                if (isNewer(csvFile, SNAPSHOT_FILE)) {
+                    cout << "  ℹ " << csvFile << " changed outside a complete save; loading the "
+                         << "binary snapshot (use --import-csv to load the CSV files)" << endl;
+                    break;
+                }
+            }
+        }
+        if (BinarySnapshot::load(SNAPSHOT_FILE, bookTree, userMap, transList, holds, 
+                                 journalLSN)) {
+            return bookTree->getCount() > 0 && userMap->getCount() > 0 && transList->size() > 0;
+        }
+    }
+    return loadCSV(bookTree, userMap, transList, holds, journalLSN);
+}
+
+// ============ FORMAT CONVERSION ============
+
+// Each converter loads one format into its own structures and writes the
+// other. The journal is left alone: its records after the converted
+// snapshot's LSN still apply on the next start. Exported CSV files keep
+// the snapshot's generation (same save, so start-up keeps the faster
+// format); an imported snapshot is numbered above everything seen.
+bool FileHandler::exportCSV() {
+    BookBST bookTree;
+    UserHashMap userMap;
+    TransactionList transList;
+    HoldQueues holds;
+    uint64_t journalLSN = 0;
+    
+    uint64_t generation = 0;
+    if (!BinarySnapshot::load(SNAPSHOT_FILE, &bookTree, &userMap, &transList, &holds, 
+                              journalLSN) ||
+        !BinarySnapshot::readGeneration(SNAPSHOT_FILE, generation)) {
+        cerr << "Error: Could not load " << SNAPSHOT_FILE << endl;
+        return false;
+    }
+    DataSnapshot snapshot = captureSnapshot(&bookTree, &userMap, &transList, &holds, journalLSN);
+    snapshot.generation = generation;
+    return saveCSV(snapshot, true);
+}
+
+bool FileHandler::importCSV() {
+    BookBST bookTree;
+    UserHashMap userMap;
+    TransactionList transList;
+    HoldQueues holds;
+    uint64_t journalLSN = 0;
+    
+    uint64_t generation = 0;
+    isCompleteCSVSet(generation);   // Numbers the new snapshot above every stamp
+    loadCSV(&bookTree, &userMap, &transList, &holds, journalLSN);
+    return saveBinary(captureSnapshot(&bookTree, &userMap, &transList, &holds, journalLSN), true);
+}
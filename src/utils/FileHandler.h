@@ -0,0 +1,120 @@
+// utils/FileHandler.h
+#ifndef FILEHANDLER_H
+#define FILEHANDLER_H
+
+#include "../entities/Book.h"
+#include "../entities/User.h"
+#include "../entities/Transaction.h"
+#include "../management/BookBST.h"
+#include "../management/UserHashMap.h"
+#include "../management/TransactionList.h"
+#include "../management/HoldQueues.h"
+#include <string>
+#include <vector>
+#include <fstream>
+#include <functional>
+#include <cstdint>
+using namespace std;
+
+// Everything saveAllData writes, captured at one instant so it can be
+// written out from another thread while the library keeps changing.
+// Books, users and holds are plain copies (formatting waits for the
+// writer), and transactions are a TransactionList::Prefix (chunk
+// pointers only).
+struct DataSnapshot {
+    uint64_t journalLSN;     // Last journaled change included
+    uint64_t generation;     // Numbers saves; stamped in every file of this one
+    vector<Book> books;
+    vector<User> users;
+    vector<pair<string, Hold>> holds;
+    TransactionList::Prefix transactions;
+    
+    DataSnapshot() : journalLSN(0), generation(0) {}
+};
+
+class FileHandler {
+private:
+    static uint64_t lastGeneration;   // Highest save generation seen or used
+    
+    // Writes filename.tmp through body, then renames it over filename
+    static bool writeFile(const string& filename, const function<void(ostream&)>& body, 
+                          bool binary = false);
+    static bool writeRecords(const string& filename, const vector<string>& header, 
+                             const vector<string>& records);
+    static bool writeTransactions(const string& filename, 
+                                  const TransactionList::Prefix& transactions, 
+                                  uint64_t generation);
+    static void report(bool success, const string& what, size_t records);
+    static bool isNewer(const string& filename, const string& than);
+    
+    // Save generations: the stamp in a CSV file's header (0 if none), and
+    // whether the CSV files are exactly what one complete save wrote
+    static uint64_t readGeneration(const string& filename);
+    static bool isCompleteCSVSet(uint64_t& generation);
+    static void noteGeneration(uint64_t generation);
+    
+    // One snapshot in one format: the CSV files then the checkpoint, or
+    // SNAPSHOT_FILE
+    static bool saveCSV(const DataSnapshot& snapshot, bool verbose);
+    static bool saveBinary(const DataSnapshot& snapshot, bool verbose);
+    
+    template <typename Records>
+    static bool writeObjects(const string& filename, const vector<string>& header, 
+                             const Records& records);
+
+public:
+    // File operations
+    static bool fileExists(const string& filename);
+    static bool createFile(const string& filename);
+    static vector<string> readLines(const string& filename);
+    static bool writeLines(const string& filename, const vector<string>& lines);
+    
+    // Data-specific operations
+    static bool saveBooks(const string& filename, BookBST* bookTree);
+    static bool loadBooks(const string& filename, BookBST* bookTree);
+    
+    static bool saveUsers(const string& filename, UserHashMap* userMap);
+    static bool loadUsers(const string& filename, UserHashMap* userMap);
+    
+    static bool saveTransactions(const string& filename, TransactionList* transList);
+    static bool loadTransactions(const string& filename, TransactionList* transList);
+    
+    // Interned strings referenced by transactions; load before them
+    static bool saveStrings(const string& filename);
+    static bool loadStrings(const string& filename);
+    
+    // Hold queues; holds of unknown users are dropped, so load users first
+    static bool saveHolds(const string& filename, HoldQueues* holds);
+    static bool loadHolds(const string& filename, HoldQueues* holds, UserHashMap* userMap);
+    
+    // Journal LSN the other files were saved at, and the save generation
+    // they carry; 0 if none. Written after them, so it names a complete set.
+    static bool saveCheckpoint(const string& filename, uint64_t lsn, uint64_t generation);
+    static uint64_t loadCheckpoint(const string& filename, uint64_t& generation);
+    
+    // Snapshots: capture on the thread that owns the data, save on any.
+    // saveSnapshot writes the CSV files and checkpoint (unless
+    // SNAPSHOT_WRITE_CSV is off), then the binary snapshot, all to the
+    // Config.h paths; verbose prints a line per file.
+    static DataSnapshot captureSnapshot(BookBST* bookTree, UserHashMap* userMap, 
+                                        TransactionList* transList, HoldQueues* holds, 
+                                        uint64_t journalLSN);
+    static bool saveSnapshot(const DataSnapshot& snapshot, bool verbose);
+    
+    // Loads the binary snapshot, or the CSV files if they are one complete
+    // save later than it (or the snapshot is missing or unusable), into
+    // empty structures. journalLSN is where journal replay starts. Returns
+    // true if books, users and transactions were all found.
+    static bool loadSnapshot(BookBST* bookTree, UserHashMap* userMap, 
+                             TransactionList* transList, HoldQueues* holds, 
+                             uint64_t& journalLSN);
+    static bool loadCSV(BookBST* bookTree, UserHashMap* userMap, 
+                        TransactionList* transList, HoldQueues* holds, 
+                        uint64_t& journalLSN);
+    
+    // Converters between the formats (main's --export-csv/--import-csv)
+    static bool exportCSV();   // SNAPSHOT_FILE -> CSV files + checkpoint
+    static bool importCSV();   // CSV files + checkpoint -> SNAPSHOT_FILE
+};
+
+#endif // FILEHANDLER_H
\ No newline at end of file
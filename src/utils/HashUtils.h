@@ -0,0 +1,76 @@
+// utils/HashUtils.h
+#ifndef HASHUTILS_H
+#define HASHUTILS_H
+
+#include <string>
+#include <cstdint>
+#include <cstring>
+using namespace std;
+
+class HashUtils {
+private:
+    static const uint64_t PRIME_1 = 0x87c37b91114253d5ULL;
+    static const uint64_t PRIME_2 = 0x4cf5ad432745937fULL;
+    static const uint64_t DEFAULT_SEED = 0x9E3779B97F4A7C15ULL;
+
+    static uint64_t rotl(uint64_t x, int r) {
+        return (x << r) | (x >> (64 - r));
+    }
+
+public:
+    // Final avalanche step (MurmurHash3 fmix64)
+    static uint64_t mix64(uint64_t k) {
+        k ^= k >> 33;
+        k *= 0xff51afd7ed558ccdULL;
+        k ^= k >> 33;
+        k *= 0xc4ceb9fe1a85ec53ULL;
+        k ^= k >> 33;
+        return k;
+    }
+
+    // 64-bit hash over raw bytes: 8 bytes per round, then a mixed tail.
+    // Replaces DJB2, which only mixes one byte per step and clusters badly
+    // on short, similar keys such as "U001", "U002".
+    static uint64_t hashBytes(const char* data, size_t len, uint64_t seed = DEFAULT_SEED) {
+        uint64_t h = seed ^ (len * PRIME_1);
+
+        while (len >= 8) {
+            uint64_t k;
+            memcpy(&k, data, 8);  // Unaligned-safe load
+            k *= PRIME_1;
+            k = rotl(k, 31);
+            k *= PRIME_2;
+            h ^= k;
+            h = rotl(h, 27) * 5 + 0x52dce729;
+            data += 8;
+            len -= 8;
+        }
+
+        // 1-7 bytes left: two overlapping loads instead of a byte loop
+        if (len > 0) {
+            uint64_t tail;
+            if (len >= 4) {
+                uint32_t low, high;
+                memcpy(&low, data, 4);
+                memcpy(&high, data + len - 4, 4);
+                tail = low | (static_cast<uint64_t>(high) << 32);
+            } else {
+                tail = static_cast<unsigned char>(data[0]) 
+                       | (static_cast<uint64_t>(static_cast<unsigned char>(data[len / 2])) << 8)
+                       | (static_cast<uint64_t>(static_cast<unsigned char>(data[len - 1])) << 16);
+            }
+            tail *= PRIME_1;
+            tail = rotl(tail, 31);
+            tail *= PRIME_2;
+            h ^= tail;
+        }
+
+        return mix64(h);
+    }
+
+    static uint64_t hashString(const string& key) {
+        return hashBytes(key.data(), key.size());
+    }
+};
+
+#endif // HASHUTILS_H
@@ -0,0 +1,81 @@
+// utils/IdGenerator.h
+#ifndef IDGENERATOR_H
+#define IDGENERATOR_H
+
+#include <string>
+#include <atomic>
+#include <cstdint>
+using namespace std;
+
+// Thread-safe source of 64-bit surrogate keys (1, 2, 3, ...). IDs are
+// integers everywhere inside the system; the legacy "U001"/"T0001" text
+// form is produced by format() only for files and the console, and read
+// back with parse(). 0 is never issued and means "no ID".
+class IdGenerator {
+private:
+    atomic<uint64_t> next;
+
+public:
+    IdGenerator() : next(1) {}
+
+    IdGenerator(const IdGenerator&) = delete;
+    IdGenerator& operator=(const IdGenerator&) = delete;
+
+    uint64_t allocate() {
+        return next.fetch_add(1, memory_order_relaxed);
+    }
+
+    // Ensures future IDs are greater than one seen while loading
+    void observe(uint64_t id) {
+        uint64_t current = next.load(memory_order_relaxed);
+        while (current <= id &&
+               !next.compare_exchange_weak(current, id + 1, memory_order_relaxed)) {
+        }
+    }
+
+    void reset() {
+        next.store(1, memory_order_relaxed);
+    }
+
+    // prefix + decimal digits, zero-padded to minDigits (wider IDs simply
+    // grow, e.g. U999 -> U1000)
+    static string format(char prefix, uint64_t id, int minDigits) {
+        char digits[20];
+        int length = 0;
+        do {
+            digits[length++] = static_cast<char>('0' + id % 10);
+            id /= 10;
+        } while (id != 0);
+
+        string text;
+        text.reserve(1 + (length > minDigits ? length : minDigits));
+        text += prefix;
+        for (int i = length; i < minDigits; i++) {
+            text += '0';
+        }
+        while (length > 0) {
+            text += digits[--length];
+        }
+        return text;
+    }
+
+    // Accepts prefix + 1..19 digits; false (id untouched) otherwise
+    static bool parse(const string& text, char prefix, uint64_t& id) {
+        if (text.length() < 2 || text.length() > 20 || text[0] != prefix) {
+            return false;
+        }
+
+        uint64_t value = 0;
+        for (size_t i = 1; i < text.length(); i++) {
+            if (text[i] < '0' || text[i] > '9') return false;
+            value = value * 10 + static_cast<uint64_t>(text[i] - '0');
+        }
+        if (value == 0) {
+            return false;
+        }
+        id = value;
+        return true;
+    }
+};
+
+#endif // IDGENERATOR_H
@@ -0,0 +1,489 @@
+// utils/Journal.cpp
+#include "Journal.h"
+#include "Crc32c.h"
+#include "../Config.h"
+#include <fstream>
+#include <iterator>
+#include <filesystem>
+#include <iostream>
+#include <chrono>
+#include <algorithm>
+
+#ifdef _WIN32
+    #include <io.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+// ============ RECORD ENCODING ============
+
+void JournalRecord::putUnsigned(uint64_t value) {
+    while (value >= 0x80) {
+        payload += static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    payload += static_cast<char>(value);
+}
+
+void JournalRecord::putSigned(int64_t value) {
+    // Zigzag: small negative numbers stay short
+    putUnsigned((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+void JournalRecord::putString(const string& value) {
+    putUnsigned(value.size());
+    payload += value;
+}
+
+bool JournalRecord::getUnsigned(uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (readPos >= payload.size()) {
+            return false;
+        }
+        uint8_t byte = static_cast<uint8_t>(payload[readPos++]);
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;  // More than 10 bytes
+}
+
+bool JournalRecord::getSigned(int64_t& value) {
+    uint64_t encoded;
+    if (!getUnsigned(encoded)) {
+        return false;
+    }
+    value = static_cast<int64_t>(encoded >> 1) ^ -static_cast<int64_t>(encoded & 1);
+    return true;
+}
+
+bool JournalRecord::getInt(int& value) {
+    int64_t wide;
+    if (!getSigned(wide) || wide < INT32_MIN || wide > INT32_MAX) {
+        return false;
+    }
+    value = static_cast<int>(wide);
+    return true;
+}
+
+bool JournalRecord::getString(string& value) {
+    uint64_t length;
+    if (!getUnsigned(length) || length > payload.size() - readPos) {
+        return false;
+    }
+    value.assign(payload, readPos, static_cast<size_t>(length));
+    readPos += static_cast<size_t>(length);
+    return true;
+}
+
+// ============ HELPERS ============
+
+static void putFixed32(string& out, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        out += static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+}
+
+static uint32_t getFixed32(const char* in) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) {
+        value |= static_cast<uint32_t>(static_cast<uint8_t>(in[i])) << (8 * i);
+    }
+    return value;
+}
+
+static const size_t HEADER_BYTES = 8;   // length + crc
+
+static string encodeFrame(JournalRecord::Type type, uint64_t lsn, const string& payload) {
+    string body;
+    body += static_cast<char>(type);
+    while (lsn >= 0x80) {
+        body += static_cast<char>((lsn & 0x7F) | 0x80);
+        lsn >>= 7;
+    }
+    body += static_cast<char>(lsn);
+    body += payload;
+
+    string frame;
+    frame.reserve(HEADER_BYTES + body.size());
+    putFixed32(frame, static_cast<uint32_t>(body.size()));
+    putFixed32(frame, Crc32c::extend(Crc32c::compute(frame.data(), 4), body.data(), body.size()));
+    frame += body;
+    return frame;
+}
+
+// Decodes the frame at pos into record; returns its size, or 0 if it is
+// cut short or fails its checksum (a torn tail)
+size_t Journal::readFrame(const string& data, size_t pos, JournalRecord& record) {
+    if (data.size() - pos < HEADER_BYTES) {
+        return 0;
+    }
+    uint32_t length = getFixed32(&data[pos]);
+    if (length == 0 || length > static_cast<uint32_t>(JOURNAL_MAX_RECORD_BYTES) ||
+        length > data.size() - pos - HEADER_BYTES) {
+        return 0;  // Cut short
+    }
+    uint32_t crc = Crc32c::extend(Crc32c::compute(&data[pos], 4),
+                                  &data[pos + HEADER_BYTES], length);
+    if (crc != getFixed32(&data[pos + 4])) {
+        return 0;  // Partly written
+    }
+
+    record = JournalRecord(static_cast<JournalRecord::Type>(data[pos + HEADER_BYTES]));
+    record.payload.assign(data, pos + HEADER_BYTES + 1, length - 1);
+    uint64_t lsn;
+    if (!record.getUnsigned(lsn)) {
+        return 0;
+    }
+    record.lsn = lsn;
+    record.payload.erase(0, record.readPos);
+    record.readPos = 0;
+    return HEADER_BYTES + length;
+}
+
+static string readAll(const string& filename) {
+    string data;
+    ifstream in(filename, ios::binary);
+    if (in.is_open()) {
+        data.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+    }
+    return data;
+}
+
+static bool syncToDisk(FILE* file) {
+    if (fflush(file) != 0) {
+        return false;
+    }
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+// Makes file creations and deletions in filename's directory durable.
+// Windows has no directory handle to sync and commits them itself.
+static bool syncDirectory(const string& filename) {
+#ifdef _WIN32
+    (void)filename;
+    return true;
+#else
+    string dir = filesystem::path(filename).parent_path().string();
+    int fd = ::open(dir.empty() ? "." : dir.c_str(), O_RDONLY | O_DIRECTORY);
+    bool success = fd >= 0 && fsync(fd) == 0;
+    if (fd >= 0) {
+        ::close(fd);
+    }
+    return success;
+#endif
+}
+
+// The named file (first LSN 0) and every "<filename>.<first LSN>"
+// beside it, oldest first
+static vector<pair<uint64_t, string>> findSegments(const string& filename) {
+    vector<pair<uint64_t, string>> found;
+    if (filesystem::exists(filename)) {
+        found.push_back(make_pair(0, filename));
+    }
+    filesystem::path base(filename);
+    filesystem::path dir = base.parent_path().empty() ? filesystem::path(".") : base.parent_path();
+    string prefix = base.filename().string() + ".";
+    error_code error;
+    for (filesystem::directory_iterator entry(dir, error), end; !error && entry != end; 
+         entry.increment(error)) {
+        string name = entry->path().filename().string();
+        if (name.size() <= prefix.size() || name.compare(0, prefix.size(), prefix) != 0 ||
+            name.find_first_not_of("0123456789", prefix.size()) != string::npos) {
+            continue;
+        }
+        found.push_back(make_pair(stoull(name.substr(prefix.size())), 
+                                  (dir / name).string()));
+    }
+    sort(found.begin(), found.end());
+    return found;
+}
+
+// ============ LIFECYCLE ============
+
+Journal::Journal(JournalMode mode, int windowMicros, size_t batchBytes)
+    : segmentSynced(true), file(nullptr), mode(mode), windowMicros(windowMicros), batchBytes(batchBytes),
+      lastLSN(0), writtenLSN(0), flushing(false), stopping(false), stats() {}
+
+Journal::~Journal() {
+    close();
+}
+
+bool Journal::open(const string& filename, uint64_t snapshotLSN,
+                   const function<bool(JournalRecord&)>& apply,
+                   size_t& applied, size_t& skipped, size_t& tornBytes) {
+    close();
+    lock_guard<mutex> guard(lock);
+    path = filename;
+    lastLSN = snapshotLSN;
+    applied = 0;
+    skipped = 0;
+    tornBytes = 0;
+
+    // No segments = nothing logged since the snapshot
+    segments = findSegments(filename);
+    if (segments.empty()) {
+        error_code ignored;
+        filesystem::path dir = filesystem::path(filename).parent_path();
+        if (!dir.empty()) {
+            filesystem::create_directories(dir, ignored);
+        }
+        segments.push_back(make_pair(0, filename));
+    }
+
+    for (const pair<uint64_t, string>& segment : segments) {
+        string data = readAll(segment.second);
+        size_t pos = 0;
+        JournalRecord record;
+        while (size_t frameBytes = readFrame(data, pos, record)) {
+            if (record.lsn > snapshotLSN) {
+                if (apply(record)) {
+                    applied++;
+                } else {
+                    skipped++;
+                }
+            }
+            if (record.lsn > lastLSN) {
+                lastLSN = record.lsn;
+            }
+            pos += frameBytes;
+        }
+
+        if (pos < data.size()) {
+            tornBytes += data.size() - pos;
+            error_code ignored;
+            filesystem::resize_file(segment.second, pos, ignored);
+        }
+    }
+
+    writtenLSN = lastLSN;
+    pending.clear();
+    failedRanges.clear();
+    stats = JournalStats();
+    segmentPath = segments.back().second;
+    segmentSynced = filesystem::exists(segmentPath);
+    file = fopen(segmentPath.c_str(), "ab");
+    if (file != nullptr && mode == JOURNAL_ASYNC) {
+        flusher = thread(&Journal::flusherLoop, this);
+    }
+    return file != nullptr;
+}
+
+void Journal::close() {
+    unique_lock<mutex> guard(lock);
+    if (file == nullptr) {
+        return;
+    }
+    waitWritten(guard, lastLSN, false);
+    stopping = true;
+    filled.notify_all();
+    guard.unlock();
+    if (flusher.joinable()) {
+        flusher.join();
+    }
+    guard.lock();
+    fclose(file);
+    file = nullptr;
+    stopping = false;
+}
+
+// ============ WRITING ============
+
+// Caller owns the file (holds the lock, or has set flushing). The first
+// write to a new segment also syncs its directory entry.
+bool Journal::writeFrames(const string& frames) {
+    long start = ftell(file);
+    if (fwrite(frames.data(), 1, frames.size(), file) == frames.size() && syncToDisk(file) &&
+        (segmentSynced || syncDirectory(segmentPath))) {
+        segmentSynced = true;
+        return true;
+    }
+
+    // Cut off any partial frame so later records stay reachable
+    fflush(file);
+    if (start >= 0) {
+        error_code ignored;
+        filesystem::resize_file(segmentPath, static_cast<uintmax_t>(start), ignored);
+    }
+    return false;
+}
+
+// Writes everything pending with the lock released. The caller has set
+// flushing, so appends keep queueing meanwhile.
+void Journal::flushBatch(unique_lock<mutex>& guard) {
+    string batch;
+    batch.swap(pending);
+    uint64_t firstLSN = writtenLSN + 1;
+    uint64_t batchLSN = lastLSN;
+
+    guard.unlock();
+    bool success = batch.empty() || writeFrames(batch);
+    guard.lock();
+
+    if (!batch.empty()) {
+        stats.syncs++;
+    }
+    if (!success) {
+        failedRanges.push_back(make_pair(firstLSN, batchLSN));
+        stats.failed += batchLSN - firstLSN + 1;
+        if (mode == JOURNAL_ASYNC) {
+            cerr << "Warning: " << (batchLSN - firstLSN + 1)
+                 << " journal records could not be written." << endl;
+        }
+    }
+    writtenLSN = batchLSN;
+    flushing = false;
+    written.notify_all();
+}
+
+// Until lsn is written: lead a flush if none is running, else wait for
+// the running one. Returns false if lsn's batch failed.
+bool Journal::waitWritten(unique_lock<mutex>& guard, uint64_t lsn, bool useWindow) {
+    while (writtenLSN < lsn) {
+        if (flushing) {
+            written.wait(guard);
+            continue;
+        }
+        flushing = true;
+        if (useWindow && windowMicros > 0 && pending.size() < batchBytes) {
+            filled.wait_for(guard, chrono::microseconds(windowMicros), [this]() {
+                return pending.size() >= batchBytes || stopping;
+            });
+        }
+        flushBatch(guard);
+    }
+    for (const pair<uint64_t, uint64_t>& range : failedRanges) {
+        if (lsn >= range.first && lsn <= range.second) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Journal::flusherLoop() {
+    unique_lock<mutex> guard(lock);
+    while (!stopping) {
+        filled.wait_for(guard, chrono::microseconds(windowMicros), [this]() {
+            return pending.size() >= batchBytes || stopping;
+        });
+        if (!pending.empty() && !flushing) {
+            flushing = true;
+            flushBatch(guard);
+        }
+    }
+}
+
+bool Journal::append(JournalRecord& record) {
+    unique_lock<mutex> guard(lock);
+    if (file == nullptr) {
+        return false;
+    }
+    record.lsn = ++lastLSN;
+    stats.records++;
+
+    if (mode == JOURNAL_SYNC) {
+        // One at a time: the lock is held across the fsync
+        while (flushing) {
+            written.wait(guard);
+        }
+        bool success = writeFrames(encodeFrame(record.getType(), record.lsn, record.payload));
+        stats.syncs++;
+        if (!success) {
+            failedRanges.push_back(make_pair(record.lsn, record.lsn));
+            stats.failed++;
+        }
+        writtenLSN = record.lsn;
+        return success;
+    }
+
+    pending += encodeFrame(record.getType(), record.lsn, record.payload);
+    if (pending.size() >= batchBytes) {
+        filled.notify_all();
+    }
+    if (mode == JOURNAL_ASYNC) {
+        return true;
+    }
+    return waitWritten(guard, record.lsn, true);
+}
+
+bool Journal::flush() {
+    unique_lock<mutex> guard(lock);
+    if (file == nullptr) {
+        return false;
+    }
+    size_t failuresBefore = failedRanges.size();
+    waitWritten(guard, lastLSN, false);
+    return failedRanges.size() == failuresBefore;
+}
+
+// Starts a new segment, then deletes every segment the snapshot covers
+// whole. Appends wait only for the batch in flight and the swap; records
+// after lsn in a kept segment are skipped on replay, and the segment goes
+// at the next save.
+bool Journal::truncateThrough(uint64_t lsn) {
+    unique_lock<mutex> guard(lock);
+    if (file == nullptr) {
+        return false;
+    }
+    while (flushing) {
+        written.wait(guard);   // The batch in flight ends in the old segment
+    }
+
+    // Queued frames go to the new segment, so it starts after writtenLSN
+    uint64_t firstLSN = writtenLSN + 1;
+    if (firstLSN > segments.back().first) {
+        string nextPath = path + "." + to_string(firstLSN);
+        FILE* next = fopen(nextPath.c_str(), "ab");
+        if (next == nullptr) {
+            return false;
+        }
+        fclose(file);
+        file = next;
+        segments.push_back(make_pair(firstLSN, nextPath));
+        segmentPath = nextPath;
+        segmentSynced = false;
+    }
+
+    // Segment i holds LSNs below segment i + 1's first
+    vector<string> covered;
+    while (segments.size() > 1 && segments[1].first - 1 <= lsn) {
+        covered.push_back(segments.front().second);
+        segments.erase(segments.begin());
+    }
+    failedRanges.erase(remove_if(failedRanges.begin(), failedRanges.end(), 
+                                 [lsn](const pair<uint64_t, uint64_t>& range) {
+                                     return range.second <= lsn;
+                                 }), 
+                       failedRanges.end());
+    guard.unlock();
+
+    bool success = true;
+    for (const string& segment : covered) {
+        error_code error;
+        filesystem::remove(segment, error);
+        success &= !error;
+    }
+    return success && (covered.empty() || syncDirectory(path));
+}
+
+uint64_t Journal::getLastLSN() {
+    lock_guard<mutex> guard(lock);
+    return lastLSN;
+}
+
+bool Journal::isOpen() {
+    lock_guard<mutex> guard(lock);
+    return file != nullptr;
+}
+
+JournalStats Journal::getStats() {
+    lock_guard<mutex> guard(lock);
+    return stats;
+}
@@ -0,0 +1,150 @@
+// utils/Journal.h
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include "../Config.h"
+#include <string>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <functional>
+using namespace std;
+
+// One mutation, encoded compactly: a type byte, then fields as LEB128
+// varints (zigzag for signed values) and length-prefixed strings. Build
+// one with the put* calls; read it back with get* calls in the same
+// order, which return false once the payload runs out or is malformed.
+class JournalRecord {
+public:
+    enum Type : uint8_t {
+        BOOK_ADD = 1,      // isbn, title, author, quantity
+        BOOK_DETAILS,      // isbn, title, author
+        BOOK_QUANTITY,     // isbn, quantity
+        COPY_RETIRE,       // isbn, copy
+        BOOK_REMOVE,       // isbn
+        USER_ADD,          // users.txt line
+        USER_REMOVE,       // userID
+        USER_ACTIVE,       // userID, active
+        USER_CONTACT,      // userID, email, phone
+        USER_PASSWORD,     // userID, password hash
+        BORROW,            // transactionID, userID, isbn, copy, timestamp
+        RETURN,            // transactionID, userID, isbn, copy, timestamp
+        HOLD_PLACE,        // userID, isbn, placedAt
+        HOLD_CANCEL        // userID, isbn
+    };
+
+private:
+    uint8_t type;
+    uint64_t lsn;          // Log sequence number, assigned by Journal::append
+    string payload;
+    size_t readPos;
+
+public:
+    JournalRecord() : type(0), lsn(0), readPos(0) {}
+    explicit JournalRecord(Type type) : type(type), lsn(0), readPos(0) {}
+
+    Type getType() const { return static_cast<Type>(type); }
+    uint64_t getLSN() const { return lsn; }
+
+    void putUnsigned(uint64_t value);
+    void putSigned(int64_t value);
+    void putString(const string& value);
+
+    bool getUnsigned(uint64_t& value);
+    bool getSigned(int64_t& value);
+    bool getInt(int& value);
+    bool getString(string& value);
+
+    friend class Journal;
+};
+
+struct JournalStats {
+    uint64_t records;     // Appended since open
+    uint64_t syncs;       // Writes + fsyncs issued
+    uint64_t failed;      // Records whose write or fsync failed
+};
+
+// Append-only write-ahead journal. Each record on disk is
+//
+//     u32 length | u32 crc | type | varint lsn | payload
+//
+// (little-endian; length counts the bytes after the crc, and the crc is
+// CRC-32C over the length field and those bytes).
+//
+// Durability follows the mode (JOURNAL_MODE in Config.h). In group mode
+// frames queue in pending; the first caller to find no flush running
+// becomes the leader, takes everything queued, writes and fsyncs it
+// with the lock released, then wakes the callers it covered. Callers
+// arriving meanwhile queue up behind the next leader, so under load one
+// fsync serves many records. Async mode hands the same job to a
+// background thread on a timer.
+//
+// The journal is a chain of segment files: the named file, then
+// "<name>.<first LSN>" for each later one. truncateThrough starts a new
+// segment and deletes the ones a snapshot covers whole, so it never
+// rewrites records and appends only wait for the swap.
+//
+// Recovery: open() reads the segments in order and hands each record
+// newer than the snapshot's LSN to the caller. The first record that is
+// cut short or fails its checksum marks a torn tail (a crash mid-write);
+// the segment is truncated there and appending resumes in the last one.
+class Journal {
+private:
+    string path;
+    vector<pair<uint64_t, string>> segments;   // First LSN and file, oldest first
+    string segmentPath;      // The last segment, which file appends to
+    bool segmentSynced;      // Its directory entry is on disk
+    FILE* file;
+    JournalMode mode;
+    int windowMicros;
+    size_t batchBytes;
+    
+    uint64_t lastLSN;        // Newest assigned
+    uint64_t writtenLSN;     // Every record up to here has been written (or failed)
+    string pending;          // Encoded frames after writtenLSN
+    bool flushing;           // A batch is being written; only its owner touches file
+    bool stopping;
+    vector<pair<uint64_t, uint64_t>> failedRanges;   // LSNs lost to I/O errors
+    JournalStats stats;
+    
+    mutex lock;
+    condition_variable written;   // writtenLSN moved or flushing cleared
+    condition_variable filled;    // pending reached batchBytes, or stopping
+    thread flusher;               // Async mode only
+    
+    static size_t readFrame(const string& data, size_t pos, JournalRecord& record);
+    bool writeFrames(const string& frames);   // Cuts a failed write back off
+    void flushBatch(unique_lock<mutex>& guard);
+    bool waitWritten(unique_lock<mutex>& guard, uint64_t lsn, bool useWindow);
+    void flusherLoop();
+
+public:
+    Journal(JournalMode mode, int windowMicros, size_t batchBytes);
+    ~Journal();
+
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    // Replays records with LSN > snapshotLSN through apply (false from
+    // apply counts the record as skipped), then opens for appending.
+    // Returns false if the file cannot be read or opened.
+    bool open(const string& filename, uint64_t snapshotLSN,
+              const function<bool(JournalRecord&)>& apply,
+              size_t& applied, size_t& skipped, size_t& tornBytes);
+    void close();                         // Flushes first
+
+    // Thread-safe; sets record's LSN. Returns once the record is on disk,
+    // except in async mode, where it returns once queued.
+    bool append(JournalRecord& record);
+    bool flush();                         // Waits for everything queued
+    bool truncateThrough(uint64_t lsn);   // Drops segments a snapshot covers; LSNs carry on
+
+    uint64_t getLastLSN();
+    bool isOpen();
+    JournalStats getStats();
+};
+
+#endif // JOURNAL_H
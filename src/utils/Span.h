@@ -0,0 +1,32 @@
+// utils/Span.h
+#ifndef SPAN_H
+#define SPAN_H
+
+#include <cstddef>
+#include <vector>
+using namespace std;
+
+// Non-owning view over a contiguous run of elements (C++17 stand-in for
+// std::span). Valid only while the underlying storage is not resized.
+template <typename T>
+class Span {
+private:
+    T* first;
+    size_t length;
+
+public:
+    Span() : first(nullptr), length(0) {}
+    Span(T* data, size_t size) : first(data), length(size) {}
+    
+    template <typename U>
+    Span(const vector<U>& vec) : first(vec.data()), length(vec.size()) {}
+
+    T* begin() const { return first; }
+    T* end() const { return first + length; }
+    T& operator[](size_t i) const { return first[i]; }
+    T* data() const { return first; }
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+};
+
+#endif // SPAN_H
@@ -0,0 +1,123 @@
+// utils/StringDictionary.cpp
+#include "StringDictionary.h"
+#include "StringUtils.h"
+#include <mutex>
+
+static const string EMPTY_STRING;
+
+// ============ SINGLETON ============
+
+StringDictionary::StringDictionary() : stringBytes(0) {}
+
+StringDictionary* StringDictionary::getInstance() {
+    static StringDictionary dictionary;   // Thread-safe initialization
+    return &dictionary;
+}
+
+// ============ MAIN OPERATIONS ============
+
+uint32_t StringDictionary::intern(const string& text) {
+    {
+        shared_lock<shared_mutex> guard(lock);
+        auto it = codes.find(string_view(text));
+        if (it != codes.end()) {
+            return it->second;
+        }
+    }
+
+    unique_lock<shared_mutex> guard(lock);
+    auto it = codes.find(string_view(text));   // Raced with another writer?
+    if (it != codes.end()) {
+        return it->second;
+    }
+
+    uint32_t code = static_cast<uint32_t>(strings.size());
+    strings.push_back(text);
+    codes.emplace(string_view(strings.back()), code);
+    stringBytes += text.capacity() + 1;
+    return code;
+}
+
+uint32_t StringDictionary::find(const string& text) const {
+    shared_lock<shared_mutex> guard(lock);
+    auto it = codes.find(string_view(text));
+    return (it != codes.end()) ? it->second : NO_CODE;
+}
+
+const string& StringDictionary::lookup(uint32_t code) const {
+    shared_lock<shared_mutex> guard(lock);
+    return (code < strings.size()) ? strings[code] : EMPTY_STRING;
+}
+
+bool StringDictionary::contains(uint32_t code) const {
+    shared_lock<shared_mutex> guard(lock);
+    return code < strings.size();
+}
+
+// ============ PERSISTENCE ============
+
+vector<string> StringDictionary::toFileLines() const {
+    shared_lock<shared_mutex> guard(lock);
+    vector<string> lines;
+    lines.reserve(strings.size());
+    for (size_t code = 0; code < strings.size(); code++) {
+        lines.push_back(to_string(code) + "," + StringUtils::escapeCSV(strings[code]));
+    }
+    return lines;
+}
+
+// Lines must arrive in code order (as written by toFileLines)
+bool StringDictionary::loadFileLine(const string& line) {
+    size_t comma = line.find(',');
+    if (comma == string::npos) {
+        return false;
+    }
+
+    uint32_t code;
+    try {
+        code = static_cast<uint32_t>(stoul(line.substr(0, comma)));
+    } catch (...) {
+        return false;
+    }
+
+    return loadEntry(code, StringUtils::unescapeCSV(line.substr(comma + 1)));
+}
+
+bool StringDictionary::loadEntry(uint32_t code, string_view text) {
+    unique_lock<shared_mutex> guard(lock);
+    if (code != strings.size() || codes.count(text) != 0) {
+        return false;   // Gap or duplicate: file is not a dictionary dump
+    }
+
+    strings.emplace_back(text);
+    codes.emplace(string_view(strings.back()), code);
+    stringBytes += strings.back().capacity() + 1;
+    return true;
+}
+
+void StringDictionary::reserve(size_t count) {
+    unique_lock<shared_mutex> guard(lock);
+    codes.reserve(count);
+}
+
+// ============ UTILITY ============
+
+size_t StringDictionary::getCount() const {
+    shared_lock<shared_mutex> guard(lock);
+    return strings.size();
+}
+
+size_t StringDictionary::getMemoryUsage() const {
+    shared_lock<shared_mutex> guard(lock);
+    // Strings plus their heap text, and roughly one hash node per entry
+    return strings.size() * sizeof(string) + stringBytes +
+           codes.size() * (sizeof(string_view) + sizeof(uint32_t) + 2 * sizeof(void*)) +
+           codes.bucket_count() * sizeof(void*);
+}
+
+void StringDictionary::clear() {
+    unique_lock<shared_mutex> guard(lock);
+    codes.clear();
+    strings.clear();
+    stringBytes = 0;
+}
@@ -0,0 +1,59 @@
+// utils/StringDictionary.h
+#ifndef STRINGDICTIONARY_H
+#define STRINGDICTIONARY_H
+
+#include <string>
+#include <string_view>
+#include <deque>
+#include <vector>
+#include <unordered_map>
+#include <shared_mutex>
+#include <cstdint>
+using namespace std;
+
+// Process-wide string interning table. Each distinct string is stored
+// once and identified by a dense 32-bit code (0, 1, 2, ... in first-seen
+// order). Codes are never reused or removed, so they can be written to
+// disk and stay valid across saves. Transactions keep user names and book
+// titles as codes; the catalog and user directory share the same table.
+//
+// Thread-safe: intern() takes the write lock only for a new string,
+// lookups take a shared lock. Returned references stay valid for the
+// life of the dictionary.
+class StringDictionary {
+public:
+    static const uint32_t NO_CODE = 0xFFFFFFFFu;
+
+private:
+    deque<string> strings;                        // code -> string (stable)
+    unordered_map<string_view, uint32_t> codes;   // Views into strings
+    size_t stringBytes;
+    mutable shared_mutex lock;
+
+    StringDictionary();
+
+public:
+    static StringDictionary* getInstance();
+
+    StringDictionary(const StringDictionary&) = delete;
+    StringDictionary& operator=(const StringDictionary&) = delete;
+
+    uint32_t intern(const string& text);
+    uint32_t find(const string& text) const;     // NO_CODE if absent
+    const string& lookup(uint32_t code) const;   // Empty string if unknown
+    bool contains(uint32_t code) const;
+
+    // Persistence: "code,text" lines, or entries one code at a time from
+    // 0; loading expects an empty dictionary
+    vector<string> toFileLines() const;
+    bool loadFileLine(const string& line);
+    bool loadEntry(uint32_t code, string_view text);
+    void reserve(size_t count);
+
+    // Utility
+    size_t getCount() const;
+    size_t getMemoryUsage() const;   // Approximate bytes held
+    void clear();
+};
+
+#endif // STRINGDICTIONARY_H
@@ -61,6 +61,22 @@ public:
         return lower;
     }
     
+    // Canonical email for lookups: trimmed, lowercase
+    static string normalizeEmail(const string& email) {
+        return toLower(trim(email));
+    }
+    
+    // Canonical phone number for lookups: digits only
+    static string normalizePhone(const string& phone) {
+        string digits;
+        for (char c : phone) {
+            if (c >= '0' && c <= '9') {
+                digits += c;
+            }
+        }
+        return digits;
+    }
+    
     // Split string by delimiter (handles quoted CSV fields)
     static vector<string> splitCSV(const string& line) {
         vector<string> result;
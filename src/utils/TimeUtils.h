@@ -0,0 +1,223 @@
+// utils/TimeUtils.h
+#ifndef TIMEUTILS_H
+#define TIMEUTILS_H
+
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <ctime>
+using namespace std;
+
+// Timestamps are int64 milliseconds since the Unix epoch (UTC). Text is
+// only produced at display/CSV boundaries:
+//   - files hold "YYYY-MM-DD HH:MM:SSZ", UTC; rows written before the
+//     marker existed have no "Z" and are local time, and parse converts
+//     them
+//   - the screen shows "YYYY-MM-DD HH:MM:SS" local time, and calendar
+//     days (dayOf, fromDate, reports) are local days
+// Calendar math is done directly; the local offset comes from
+// localtime_r/localtime_s, so everything here is reentrant.
+class TimeUtils {
+private:
+    static const int64_t MS_PER_SECOND = 1000;
+    static const int64_t SECONDS_PER_DAY = 86400;
+
+    // Floor division, so times before 1970 land on the right day
+    static int64_t floorDiv(int64_t a, int64_t b) {
+        return (a >= 0) ? a / b : -((-a + b - 1) / b);
+    }
+
+    // Days since 1970-01-01 -> civil date (H. Hinnant's algorithm)
+    static void civilFromDays(int64_t days, int& year, int& month, int& day) {
+        days += 719468;
+        int64_t era = floorDiv(days, 146097);
+        int64_t dayOfEra = days - era * 146097;
+        int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524
+                             - dayOfEra / 146096) / 365;
+        int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        int64_t mp = (5 * dayOfYear + 2) / 153;
+        day = static_cast<int>(dayOfYear - (153 * mp + 2) / 5 + 1);
+        month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+        year = static_cast<int>(yearOfEra + era * 400 + (month <= 2 ? 1 : 0));
+    }
+
+    static int64_t daysFromCivil(int year, int month, int day) {
+        year -= (month <= 2) ? 1 : 0;
+        int64_t era = floorDiv(year, 400);
+        int64_t yearOfEra = year - era * 400;
+        int64_t dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + dayOfEra - 719468;
+    }
+
+    static void putDigits(char* out, int value, int width) {
+        for (int i = width - 1; i >= 0; i--) {
+            out[i] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+    }
+
+    // Local time minus UTC at epochMs, daylight saving included
+    static int64_t localOffsetMs(int64_t epochMs) {
+        time_t seconds = static_cast<time_t>(floorDiv(epochMs, MS_PER_SECOND));
+        tm local;
+#ifdef _WIN32
+        if (localtime_s(&local, &seconds) != 0) return 0;
+#else
+        if (localtime_r(&seconds, &local) == nullptr) return 0;
+#endif
+        int64_t localSeconds = daysFromCivil(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday)
+                               * SECONDS_PER_DAY + local.tm_hour * 3600 + local.tm_min * 60 
+                               + local.tm_sec;
+        return (localSeconds - static_cast<int64_t>(seconds)) * MS_PER_SECOND;
+    }
+
+    // Local wall-clock ms -> epoch ms. The second guess uses the offset in
+    // force at the first, which settles it across a DST change; a time
+    // skipped by the change comes out an hour off, one repeated by it as
+    // the first occurrence.
+    static int64_t fromLocalMs(int64_t localMs) {
+        int64_t guess = localMs - localOffsetMs(localMs);
+        return localMs - localOffsetMs(guess);
+    }
+
+    // Writes TEXT_LENGTH chars plus a terminator for the wall clock that
+    // reads civilMs. Each thread caches the last second it formatted and
+    // the date prefix of the last day, so bursts of records in the same
+    // second are a memcpy and same-day records only rebuild "HH:MM:SS".
+    static void writeCivil(int64_t civilMs, char* out) {
+        struct Cache {
+            int64_t second;
+            int64_t day;
+            char text[TEXT_LENGTH + 1];
+            Cache() : second(INT64_MIN), day(INT64_MIN) { text[0] = '\0'; }
+        };
+        static thread_local Cache cache;
+
+        int64_t second = floorDiv(civilMs, MS_PER_SECOND);
+        if (second != cache.second) {
+            int64_t day = floorDiv(second, SECONDS_PER_DAY);
+            if (day != cache.day) {
+                int year, month, dayOfMonth;
+                civilFromDays(day, year, month, dayOfMonth);
+                putDigits(cache.text, year, 4);
+                cache.text[4] = '-';
+                putDigits(cache.text + 5, month, 2);
+                cache.text[7] = '-';
+                putDigits(cache.text + 8, dayOfMonth, 2);
+                cache.text[10] = ' ';
+                cache.day = day;
+            }
+
+            int secondOfDay = static_cast<int>(second - day * SECONDS_PER_DAY);
+            putDigits(cache.text + 11, secondOfDay / 3600, 2);
+            cache.text[13] = ':';
+            putDigits(cache.text + 14, (secondOfDay / 60) % 60, 2);
+            cache.text[16] = ':';
+            putDigits(cache.text + 17, secondOfDay % 60, 2);
+            cache.text[TEXT_LENGTH] = '\0';
+            cache.second = second;
+        }
+        memcpy(out, cache.text, TEXT_LENGTH + 1);
+    }
+
+    static bool readDigits(const char* text, int width, int& value) {
+        value = 0;
+        for (int i = 0; i < width; i++) {
+            if (text[i] < '0' || text[i] > '9') return false;
+            value = value * 10 + (text[i] - '0');
+        }
+        return true;
+    }
+
+public:
+    static const size_t TEXT_LENGTH = 19;        // "YYYY-MM-DD HH:MM:SS"
+    static const size_t UTC_TEXT_LENGTH = 20;    // "YYYY-MM-DD HH:MM:SSZ"
+
+    static int64_t nowMillis() {
+        return chrono::duration_cast<chrono::milliseconds>(
+            chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    static const int64_t MS_PER_DAY = SECONDS_PER_DAY * MS_PER_SECOND;
+
+    // Local calendar day, as days since 1970-01-01
+    static int64_t dayOf(int64_t epochMs) {
+        return floorDiv(epochMs + localOffsetMs(epochMs), MS_PER_DAY);
+    }
+
+    // Local midnight starting a dayOf() day. Days are not always
+    // MS_PER_DAY long (DST), so step with startOfDay(day + 1).
+    static int64_t startOfDay(int64_t day) {
+        return fromLocalMs(day * MS_PER_DAY);
+    }
+
+    // Local midnight of a calendar date; false if the date does not exist
+    static bool fromDate(int year, int month, int day, int64_t& epochMs) {
+        static const int DAYS_IN_MONTH[] = {31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        if (month < 1 || month > 12 || day < 1 || day > DAYS_IN_MONTH[month - 1]) {
+            return false;
+        }
+        bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+        if (month == 2 && day == 29 && !leap) {
+            return false;
+        }
+        epochMs = startOfDay(daysFromCivil(year, month, day));
+        return true;
+    }
+
+    // [fromMs, toMs) covering one calendar month (local time)
+    static bool monthWindow(int year, int month, int64_t& fromMs, int64_t& toMs) {
+        if (!fromDate(year, month, 1, fromMs)) {
+            return false;
+        }
+        return (month == 12) ? fromDate(year + 1, 1, 1, toMs) 
+                             : fromDate(year, month + 1, 1, toMs);
+    }
+
+    // Local time, for display
+    static string format(int64_t epochMs) {
+        char text[TEXT_LENGTH + 1];
+        writeCivil(epochMs + localOffsetMs(epochMs), text);
+        return string(text, TEXT_LENGTH);
+    }
+
+    // UTC with the "Z" marker, for files
+    static string formatUTC(int64_t epochMs) {
+        char text[TEXT_LENGTH + 1];
+        writeCivil(epochMs, text);
+        string result(text, TEXT_LENGTH);
+        result += 'Z';
+        return result;
+    }
+
+    // Parses formatUTC's "YYYY-MM-DD HH:MM:SSZ", or the legacy unmarked
+    // form as local time; false on malformed input
+    static bool parse(const string& text, int64_t& epochMs) {
+        bool utc = (text.length() == UTC_TEXT_LENGTH && text[TEXT_LENGTH] == 'Z');
+        if ((text.length() != TEXT_LENGTH && !utc) || text[4] != '-' || text[7] != '-' ||
+            text[10] != ' ' || text[13] != ':' || text[16] != ':') {
+            return false;
+        }
+
+        const char* s = text.c_str();
+        int year, month, day, hour, minute, second;
+        if (!readDigits(s, 4, year) || !readDigits(s + 5, 2, month) ||
+            !readDigits(s + 8, 2, day) || !readDigits(s + 11, 2, hour) ||
+            !readDigits(s + 14, 2, minute) || !readDigits(s + 17, 2, second)) {
+            return false;
+        }
+        if (month < 1 || month > 12 || day < 1 || day > 31 ||
+            hour > 23 || minute > 59 || second > 60) {
+            return false;
+        }
+
+        int64_t seconds = daysFromCivil(year, month, day) * SECONDS_PER_DAY
+                          + hour * 3600 + minute * 60 + second;
+        epochMs = utc ? seconds * MS_PER_SECOND : fromLocalMs(seconds * MS_PER_SECOND);
+        return true;
+    }
+};
+
+#endif // TIMEUTILS_H
@@ -0,0 +1,68 @@
+// utils/WorkerPool.cpp
+#include "WorkerPool.h"
+
+// ============ CONSTRUCTOR & DESTRUCTOR ============
+
+WorkerPool::WorkerPool(size_t threadCount, size_t maxQueued) 
+    : maxQueued(maxQueued), stopping(false) {
+    if (threadCount == 0) {
+        threadCount = 1;
+    }
+    for (size_t i = 0; i < threadCount; i++) {
+        workers.emplace_back(&WorkerPool::workerLoop, this);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    taskReady.notify_all();
+    for (thread& worker : workers) {
+        worker.join();
+    }
+}
+
+// ============ WORKERS ============
+
+void WorkerPool::workerLoop() {
+    while (true) {
+        function<void()> task;
+        {
+            unique_lock<mutex> guard(lock);
+            taskReady.wait(guard, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return;  // Stopping and drained
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
+
+// ============ SUBMISSION ============
+
+bool WorkerPool::trySubmit(function<void()> task) {
+    {
+        lock_guard<mutex> guard(lock);
+        if (stopping || tasks.size() >= maxQueued) {
+            return false;
+        }
+        tasks.push_back(std::move(task));
+    }
+    taskReady.notify_one();
+    return true;
+}
+
+// ============ UTILITY ============
+
+size_t WorkerPool::getThreadCount() const {
+    return workers.size();
+}
+
+size_t WorkerPool::getQueuedCount() {
+    lock_guard<mutex> guard(lock);
+    return tasks.size();
+}
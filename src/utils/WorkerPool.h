@@ -0,0 +1,41 @@
+// utils/WorkerPool.h
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+using namespace std;
+
+// Fixed set of worker threads draining a bounded FIFO queue. trySubmit
+// refuses work once maxQueued tasks are waiting, so a burst of expensive
+// jobs (e.g. password hashing) sheds load instead of queueing unboundedly.
+class WorkerPool {
+private:
+    vector<thread> workers;
+    deque<function<void()>> tasks;
+    size_t maxQueued;
+    bool stopping;
+    
+    mutex lock;
+    condition_variable taskReady;
+    
+    void workerLoop();
+    
+public:
+    WorkerPool(size_t threadCount, size_t maxQueued);
+    ~WorkerPool();   // Finishes queued tasks, then joins
+    
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    
+    bool trySubmit(function<void()> task);   // false if the queue is full
+    
+    size_t getThreadCount() const;
+    size_t getQueuedCount();
+};
+
+#endif // WORKERPOOL_H